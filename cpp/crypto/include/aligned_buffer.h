@@ -0,0 +1,138 @@
+/**
+ * @file aligned_buffer.h
+ * @brief Выровненный буфер для массовой обработки блоков (huge pages + NUMA)
+ */
+
+#ifndef ALIGNED_BUFFER_H
+#define ALIGNED_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace buffer_utils {
+
+/**
+ * @brief Чем фактически обеспечена память буфера
+ */
+enum class PageBacking {
+    None,             ///< Буфер пуст
+    HugeTLB,          ///< Явные huge pages (MAP_HUGETLB)
+    TransparentHuge,  ///< mmap + madvise(MADV_HUGEPAGE)
+    Regular           ///< Обычные страницы
+};
+
+/**
+ * @brief Параметры выделения буфера
+ */
+struct AllocOptions {
+    bool try_hugetlb = true;       ///< Пробовать MAP_HUGETLB
+    bool try_thp = true;           ///< Пробовать transparent huge pages
+    size_t numa_slices = 1;        ///< Число срезов (рабочих потоков) для размещения по NUMA-узлам
+};
+
+/**
+ * @brief Возвращает строковое имя типа страниц
+ */
+const char* pageBackingName(PageBacking backing);
+
+/**
+ * @brief Возвращает количество NUMA-узлов в системе (1 если неизвестно)
+ */
+size_t numaNodeCount();
+
+/**
+ * @brief Выровненный по странице буфер байт
+ *
+ * Пытается выделить память на huge pages, при неудаче откатывается
+ * на transparent huge pages и далее на обычные страницы.
+ * Буфер не копируется, только перемещается.
+ */
+class AlignedBuffer {
+public:
+    static constexpr size_t ALIGNMENT = 64;              ///< Минимальное выравнивание (кэш-линия)
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    AlignedBuffer() = default;
+    AlignedBuffer(size_t bytes, const AllocOptions& options = AllocOptions());
+    ~AlignedBuffer();
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+    AlignedBuffer(AlignedBuffer&& other) noexcept;
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept;
+
+    uint8_t* data() { return ptr; }
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return bytes; }
+    bool empty() const { return bytes == 0; }
+    PageBacking backing() const { return page_backing; }
+
+    /**
+     * @brief Привязывает срезы буфера к NUMA-узлам (срез i -> узел i % nodes)
+     * @return true если политика применена хотя бы к одному срезу
+     *
+     * Вызывать до первого касания памяти. На системах с одним узлом
+     * или без mbind ничего не делает.
+     */
+    bool bindSlicesToNodes(size_t num_slices);
+
+    /**
+     * @brief Первое касание страниц: каждый из num_threads потоков касается своего среза
+     *
+     * При политике first-touch страницы оказываются на узле потока,
+     * который затем будет обрабатывать этот срез.
+     */
+    void firstTouch(size_t num_threads);
+
+private:
+    uint8_t* ptr = nullptr;
+    size_t bytes = 0;
+    size_t mapped_bytes = 0;     ///< Размер mmap-области (0 если aligned_alloc)
+    PageBacking page_backing = PageBacking::None;
+
+    void release();
+};
+
+/**
+ * @brief Арена из нескольких равных регионов в одном выровненном буфере
+ *
+ * Выделяется один раз под максимальный размер задачи, заранее
+ * «прогревается» (все страницы получают физическую память) и затем
+ * раздает указатели на регионы для каждого прогона. Так повторные
+ * прогоны не измеряют стоимость выделения и page fault.
+ */
+class BufferArena {
+public:
+    BufferArena() = default;
+    
+    /**
+     * @param region_bytes размер одного региона
+     * @param num_regions количество регионов (например, открытый текст и шифртекст)
+     * @param options параметры выделения; numa_slices применяется к каждому региону
+     */
+    BufferArena(size_t region_bytes, size_t num_regions,
+                const AllocOptions& options = AllocOptions());
+    
+    /**
+     * @brief Касается всех страниц арены; срезы каждого региона - своими потоками
+     */
+    void prefault(size_t num_threads);
+    
+    uint8_t* region(size_t index);
+    const uint8_t* region(size_t index) const;
+    size_t regionBytes() const { return region_bytes; }
+    size_t regionCount() const { return num_regions; }
+    size_t capacityBytes() const { return storage.size(); }
+    PageBacking backing() const { return storage.backing(); }
+    
+private:
+    AlignedBuffer storage;
+    size_t region_bytes = 0;
+    size_t region_stride = 0;    ///< Шаг между регионами (кратен huge page)
+    size_t num_regions = 0;
+};
+
+} // namespace buffer_utils
+
+#endif // ALIGNED_BUFFER_H
@@ -17,6 +17,9 @@
 #include <sys/stat.h>  // Для mkdir
 #include <cstring>
 #include <cerrno>
+#include <cstdint>
+#include <thread>
+#include <algorithm>
 
 namespace benchmark_utils {
 
@@ -36,13 +39,28 @@ struct BenchmarkResult {
     double decryption_speed_ops_sec;
     double encryption_throughput_mbps;
     double decryption_throughput_mbps;
+    size_t num_threads;
+    std::string mode;                   ///< "warm" (прогретая арена) или "cold" (свежие буферы)
+    double first_touch_ms;              ///< Выделение и первое касание буферов (только cold)
+    bool streamed;                      ///< Объем больше арены, обработан окнами
+    std::string page_backing;           ///< Тип страниц буферов (hugetlb/thp/regular)
+    int64_t dtlb_misses;                ///< Промахи dTLB при шифровании (-1 если недоступно)
+    int64_t dtlb_misses_regular;        ///< То же на обычных страницах (-1 если не измерялось)
+    bool verified;                      ///< Выполнялась ли полная проверка расшифровки
+    double verify_time_ms;              ///< Время сравнения расшифровки с открытым текстом
+    double decrypt_verify_throughput_mbps; ///< Дешифрование + проверка
+    int64_t first_mismatch_block;       ///< Первый неверный блок (-1 если все совпало)
     
     // Пустой конструктор
     BenchmarkResult() 
         : total_time_ms(0), encryption_time_ms(0), decryption_time_ms(0),
           memory_usage_bytes(0), data_size_bytes(0), blocks_processed(0),
           encryption_speed_ops_sec(0), decryption_speed_ops_sec(0),
-          encryption_throughput_mbps(0), decryption_throughput_mbps(0) {}
+          encryption_throughput_mbps(0), decryption_throughput_mbps(0),
+          num_threads(1), mode("warm"), first_touch_ms(0), streamed(false), page_backing("regular"),
+          dtlb_misses(-1), dtlb_misses_regular(-1),
+          verified(false), verify_time_ms(0), decrypt_verify_throughput_mbps(0),
+          first_mismatch_block(-1) {}
 };
 
 /**
@@ -89,6 +107,86 @@ public:
     }
 };
 
+/**
+ * @brief Не дает компилятору выбросить вычисление значения
+ *
+ * Аналог benchmark::DoNotOptimize: значение считается «использованным»
+ * ассемблерной вставкой, поэтому цикл, который его вычисляет, остается.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+#endif
+}
+
+/**
+ * @brief Барьер памяти для компилятора: все записи считаются видимыми
+ */
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * @brief Аппаратный счетчик промахов dTLB (perf_event_open)
+ *
+ * Считает промахи чтения dTLB текущего процесса, включая потоки,
+ * созданные после start(). Если perf недоступен (не Linux,
+ * perf_event_paranoid, контейнер), available() возвращает false.
+ */
+class DTlbMissCounter {
+private:
+    int fd;
+    
+public:
+    DTlbMissCounter();
+    ~DTlbMissCounter();
+    
+    DTlbMissCounter(const DTlbMissCounter&) = delete;
+    DTlbMissCounter& operator=(const DTlbMissCounter&) = delete;
+    
+    bool available() const { return fd >= 0; }
+    void start();
+    
+    /**
+     * @brief Останавливает счетчик
+     * @return Количество промахов или -1 если счетчик недоступен
+     */
+    int64_t stop();
+};
+
+/**
+ * @brief Делит диапазон [0, count) на num_threads непрерывных срезов
+ * @param fn Вызывается как fn(begin, end) для каждого среза
+ *
+ * Срезы совпадают с разбиением AlignedBuffer::firstTouch, поэтому
+ * каждый поток работает с памятью, которой коснулся первым.
+ */
+template <typename Fn>
+void parallelFor(size_t count, size_t num_threads, Fn fn) {
+    if (num_threads < 2 || count < num_threads) {
+        fn(size_t(0), count);
+        return;
+    }
+    
+    std::vector<std::thread> workers;
+    size_t slice = (count + num_threads - 1) / num_threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        size_t begin = t * slice;
+        if (begin >= count) break;
+        size_t end = std::min(begin + slice, count);
+        workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
 /**
  * @brief Создает директорию (рекурсивно)
  */
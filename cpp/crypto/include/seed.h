@@ -1,6 +1,7 @@
 #ifndef SEED_H
 #define SEED_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <array>
@@ -31,6 +32,23 @@ public:
         const std::array<uint8_t, BLOCK_SIZE>& ciphertext,
         const std::array<uint8_t, KEY_SIZE>& key);
     
+    // ==================== ПАКЕТНАЯ ОБРАБОТКА ====================
+    
+    /**
+     * @brief Шифрует массив блоков (раундовые ключи вычисляются один раз)
+     * @param in Входные данные (num_blocks * BLOCK_SIZE байт)
+     * @param out Выходной буфер того же размера (может совпадать с in)
+     * @param num_blocks Количество блоков
+     */
+    static void encryptBlocks(const uint8_t* in, uint8_t* out, size_t num_blocks,
+                              const std::array<uint8_t, KEY_SIZE>& key);
+    
+    /**
+     * @brief Дешифрует массив блоков (раундовые ключи вычисляются один раз)
+     */
+    static void decryptBlocks(const uint8_t* in, uint8_t* out, size_t num_blocks,
+                              const std::array<uint8_t, KEY_SIZE>& key);
+    
     // ==================== ПОТОКОВОЕ ШИФРОВАНИЕ ====================
     
     /**
@@ -48,6 +66,10 @@ public:
         const std::array<uint8_t, KEY_SIZE>& key);
     
 private:
+    // Преобразования одного блока с готовыми раундовыми ключами
+    static void encryptWithRoundKeys(const uint8_t* in, uint8_t* out, const uint32_t roundKeys[32]);
+    static void decryptWithRoundKeys(const uint8_t* in, uint8_t* out, const uint32_t roundKeys[32]);
+    
     // Вспомогательные методы для padding
     static std::vector<uint8_t> addPadding(const std::vector<uint8_t>& data);
     static std::vector<uint8_t> removePadding(const std::vector<uint8_t>& data);
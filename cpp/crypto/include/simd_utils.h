@@ -0,0 +1,32 @@
+/**
+ * @file simd_utils.h
+ * @brief Векторизованные операции над буферами блоков
+ */
+
+#ifndef SIMD_UTILS_H
+#define SIMD_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simd_utils {
+
+/**
+ * @brief Находит первый различающийся байт двух буферов
+ * @param a Первый буфер
+ * @param b Второй буфер
+ * @param bytes Размер буферов в байтах
+ * @return Смещение первого различия или bytes, если буферы равны
+ *
+ * Использует AVX2/SSE2 на x86-64 и NEON на ARM64, иначе скалярный путь.
+ */
+size_t findFirstMismatch(const uint8_t* a, const uint8_t* b, size_t bytes);
+
+/**
+ * @brief Возвращает имя используемого набора инструкций
+ */
+const char* simdBackendName();
+
+} // namespace simd_utils
+
+#endif // SIMD_UTILS_H
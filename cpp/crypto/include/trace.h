@@ -0,0 +1,137 @@
+/**
+ * @file trace.h
+ * @brief Трассировка этапов: RAII-интервалы и запись в Chrome Trace Event JSON
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Легковесная трассировка: RAII-интервалы в кольцевых буферах потоков
+ *
+ * TRACE_SPAN("имя") отмечает время жизни области видимости. Пока
+ * трассировка не запущена (trace::start), интервал стоит одну
+ * relaxed-загрузку флага и ветвление; со сборкой -DTRACE_DISABLED
+ * (опция SEED_TRACING=OFF) - ничего.
+ *
+ * Каждый поток пишет в свой кольцевой буфер без блокировок; при
+ * переполнении затираются самые старые события (см. dropped).
+ * writeChromeJson собирает буферы всех потоков в формат Trace Event
+ * (chrome://tracing, ui.perfetto.dev) - вызывать, когда потоки с
+ * интервалами завершены или остановлены.
+ *
+ * Тот же модуль, что в cpp/ml: проекты собираются независимо.
+ *
+ * Имена интервалов должны жить до записи трассы (строковые литералы).
+ */
+namespace trace {
+
+namespace detail {
+extern std::atomic<bool> active;
+uint64_t nowNs();
+void record(const char* name, uint64_t start_ns, uint64_t end_ns, int64_t value);
+} // namespace detail
+
+/**
+ * @brief Идет ли запись
+ */
+inline bool enabled() {
+#ifdef TRACE_DISABLED
+    return false;
+#else
+    return detail::active.load(std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * @brief Начинает запись, очищая ранее записанные события
+ * @param events_per_thread емкость кольцевого буфера каждого потока
+ */
+void start(size_t events_per_thread = size_t(1) << 16);
+
+/**
+ * @brief Останавливает запись (события сохраняются до следующего start)
+ */
+void stop();
+
+/**
+ * @brief Сколько событий затерто из-за переполнения буферов
+ */
+size_t dropped();
+
+/**
+ * @brief Записывает события всех потоков в формате Chrome Trace Event JSON
+ * @return true если запись успешна, false в случае ошибки (сообщение в cerr)
+ */
+bool writeChromeJson(const std::string& filename);
+
+/**
+ * @brief Интервал от создания до разрушения объекта
+ */
+class Span {
+public:
+    /**
+     * @param name имя интервала (строковый литерал)
+     * @param value числовой аргумент события (размер данных и т.п.), < 0 - без аргумента
+     */
+    explicit Span(const char* name, int64_t value = -1)
+#ifndef TRACE_DISABLED
+        : name(name), value(value), start_ns(enabled() ? detail::nowNs() : 0)
+#endif
+    {
+        (void)name;
+        (void)value;
+    }
+
+    ~Span() {
+#ifndef TRACE_DISABLED
+        if (start_ns != 0) {
+            detail::record(name, start_ns, detail::nowNs(), value);
+        }
+#endif
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    /**
+     * @brief Задает аргумент, известный только к концу интервала
+     */
+    void setValue(int64_t new_value) {
+#ifndef TRACE_DISABLED
+        value = new_value;
+#else
+        (void)new_value;
+#endif
+    }
+
+#ifndef TRACE_DISABLED
+private:
+    const char* name;
+    int64_t value;
+    uint64_t start_ns;       ///< 0 - запись не шла при создании
+#endif
+};
+
+} // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Интервал до конца текущей области видимости
+ */
+#define TRACE_SPAN(name) ::trace::Span TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+/**
+ * @brief То же с числовым аргументом (попадает в args.value события)
+ */
+#define TRACE_SPAN_VALUE(name, value) \
+    ::trace::Span TRACE_CONCAT(trace_span_, __LINE__)(name, static_cast<int64_t>(value))
+
+#endif // TRACE_H
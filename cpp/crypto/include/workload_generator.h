@@ -0,0 +1,71 @@
+/**
+ * @file workload_generator.h
+ * @brief Детерминированный генератор синтетических данных для benchmark
+ */
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace workload {
+
+/**
+ * @brief Распределение генерируемых 32-битных значений
+ */
+enum class Distribution {
+    Uniform,        ///< Равномерно в [0, 2^31-1], как generate_numbers.py
+    PaySimAmount    ///< Логнормальные суммы транзакций в центах, как amount в PaySim
+};
+
+/**
+ * @brief Параметры генератора
+ */
+struct GeneratorConfig {
+    Distribution distribution = Distribution::Uniform;
+    uint64_t seed = 42;
+};
+
+/**
+ * @brief Разбирает имя распределения ("uniform" или "paysim")
+ * @throws std::invalid_argument для неизвестного имени
+ */
+Distribution parseDistribution(const std::string& name);
+
+/**
+ * @brief Возвращает имя распределения
+ */
+const char* distributionName(Distribution distribution);
+
+/**
+ * @brief Возвращает значение с номером index
+ *
+ * Генератор основан на счетчике (splitmix64 от seed и index), поэтому
+ * значение не зависит от порядка генерации и количества потоков.
+ */
+uint32_t generateValue(const GeneratorConfig& config, uint64_t index);
+
+/**
+ * @brief Записывает 32-битное значение как 128-битный блок
+ *
+ * Первые 4 байта - значение (big-endian), остальные - номер байта.
+ */
+void encodeValueBlock(uint32_t value, uint8_t* block);
+
+/**
+ * @brief Заполняет num_blocks блоков значениями с номерами first_index...
+ */
+void fillBlocks(uint8_t* out, uint64_t first_index, size_t num_blocks,
+                const GeneratorConfig& config);
+
+/**
+ * @brief То же, что fillBlocks, но срезы заполняются num_threads потоками
+ */
+void fillBlocksParallel(uint8_t* out, uint64_t first_index, size_t num_blocks,
+                        const GeneratorConfig& config, size_t num_threads);
+
+} // namespace workload
+
+#endif // WORKLOAD_GENERATOR_H
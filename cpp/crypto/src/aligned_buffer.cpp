@@ -0,0 +1,310 @@
+/**
+ * @file aligned_buffer.cpp
+ * @brief Реализация выровненного буфера с huge pages и NUMA-размещением
+ */
+
+#include "aligned_buffer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace buffer_utils {
+
+namespace {
+
+size_t pageSize() {
+    long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? static_cast<size_t>(page) : 4096;
+}
+
+size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#ifdef __linux__
+// Константы из <numaif.h>, чтобы не зависеть от libnuma
+constexpr int MPOL_PREFERRED_MODE = 1;
+
+long sysMbind(void* addr, unsigned long len, int mode,
+              const unsigned long* nodemask, unsigned long maxnode) {
+#ifdef SYS_mbind
+    return syscall(SYS_mbind, addr, len, mode, nodemask, maxnode, 0);
+#else
+    (void)addr; (void)len; (void)mode; (void)nodemask; (void)maxnode;
+    return -1;
+#endif
+}
+#endif
+
+/**
+ * @brief Привязывает num_slices срезов диапазона к узлам (срез i -> узел i % nodes)
+ */
+bool bindRangeSlices(uint8_t* base, size_t length, size_t num_slices, size_t granularity) {
+#ifdef __linux__
+    size_t nodes = numaNodeCount();
+    if (!base || length == 0 || nodes < 2 || num_slices < 2) {
+        return false;
+    }
+    
+    size_t slice = roundUp((length + num_slices - 1) / num_slices, granularity);
+    bool applied = false;
+    
+    for (size_t i = 0; i < num_slices; ++i) {
+        size_t offset = i * slice;
+        if (offset >= length) break;
+        size_t slice_length = std::min(slice, length - offset);
+        
+        unsigned long mask[4] = {0, 0, 0, 0};
+        size_t node = i % nodes;
+        if (node >= sizeof(mask) * 8) continue;
+        mask[node / (sizeof(unsigned long) * 8)] |= 1UL << (node % (sizeof(unsigned long) * 8));
+        
+        if (sysMbind(base + offset, slice_length, MPOL_PREFERRED_MODE, mask, sizeof(mask) * 8) == 0) {
+            applied = true;
+        }
+    }
+    return applied;
+#else
+    (void)base; (void)length; (void)num_slices; (void)granularity;
+    return false;
+#endif
+}
+
+/**
+ * @brief Касается диапазона: каждый из num_threads потоков - своего среза
+ */
+void touchRange(uint8_t* base, size_t length, size_t num_threads) {
+    if (num_threads < 2) {
+        std::memset(base, 0, length);
+        return;
+    }
+    
+    std::vector<std::thread> workers;
+    size_t slice = (length + num_threads - 1) / num_threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        size_t offset = t * slice;
+        if (offset >= length) break;
+        size_t slice_length = std::min(slice, length - offset);
+        workers.emplace_back([base, offset, slice_length]() {
+            std::memset(base + offset, 0, slice_length);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
+const char* pageBackingName(PageBacking backing) {
+    switch (backing) {
+        case PageBacking::HugeTLB:         return "hugetlb";
+        case PageBacking::TransparentHuge: return "thp";
+        case PageBacking::Regular:         return "regular";
+        default:                           return "none";
+    }
+}
+
+size_t numaNodeCount() {
+#ifdef __linux__
+    // Формат: "0" или "0-3" или "0,2-3"
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string ranges;
+    if (!(online >> ranges)) {
+        return 1;
+    }
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < ranges.size()) {
+        size_t comma = ranges.find(',', pos);
+        std::string part = ranges.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        size_t dash = part.find('-');
+        try {
+            if (dash == std::string::npos) {
+                std::stoul(part);
+                count += 1;
+            } else {
+                count += std::stoul(part.substr(dash + 1)) - std::stoul(part.substr(0, dash)) + 1;
+            }
+        } catch (...) {
+            return 1;
+        }
+        if (comma == std::string::npos) break;
+        pos = comma + 1;
+    }
+    return count > 0 ? count : 1;
+#else
+    return 1;
+#endif
+}
+
+AlignedBuffer::AlignedBuffer(size_t size_bytes, const AllocOptions& options) {
+    if (size_bytes == 0) {
+        return;
+    }
+
+    // 1. Явные huge pages (требуют заранее зарезервированного пула)
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (options.try_hugetlb) {
+        size_t length = roundUp(size_bytes, HUGE_PAGE_SIZE);
+        void* mem = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED) {
+            ptr = static_cast<uint8_t*>(mem);
+            bytes = size_bytes;
+            mapped_bytes = length;
+            page_backing = PageBacking::HugeTLB;
+        }
+    }
+#endif
+
+    // 2. Transparent huge pages: выравниваем область на 2 МБ и просим ядро
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (!ptr && options.try_thp && size_bytes >= HUGE_PAGE_SIZE) {
+        size_t length = roundUp(size_bytes, HUGE_PAGE_SIZE);
+        size_t reserve = length + HUGE_PAGE_SIZE;
+        void* mem = mmap(nullptr, reserve, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED) {
+            uintptr_t raw = reinterpret_cast<uintptr_t>(mem);
+            uintptr_t aligned = roundUp(raw, HUGE_PAGE_SIZE);
+            // Отрезаем невыровненные хвосты
+            if (aligned > raw) {
+                munmap(mem, aligned - raw);
+            }
+            size_t tail = (raw + reserve) - (aligned + length);
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+            ptr = reinterpret_cast<uint8_t*>(aligned);
+            bytes = size_bytes;
+            mapped_bytes = length;
+            page_backing = madvise(ptr, length, MADV_HUGEPAGE) == 0
+                ? PageBacking::TransparentHuge
+                : PageBacking::Regular;
+        }
+    }
+#endif
+
+    // 3. Обычная выровненная память
+    if (!ptr) {
+        void* mem = nullptr;
+        if (posix_memalign(&mem, pageSize(), roundUp(size_bytes, ALIGNMENT)) != 0) {
+            throw std::bad_alloc();
+        }
+        ptr = static_cast<uint8_t*>(mem);
+        bytes = size_bytes;
+        mapped_bytes = 0;
+        page_backing = PageBacking::Regular;
+    }
+
+    if (options.numa_slices > 1) {
+        bindSlicesToNodes(options.numa_slices);
+    }
+}
+
+AlignedBuffer::~AlignedBuffer() {
+    release();
+}
+
+AlignedBuffer::AlignedBuffer(AlignedBuffer&& other) noexcept
+    : ptr(other.ptr), bytes(other.bytes), mapped_bytes(other.mapped_bytes),
+      page_backing(other.page_backing) {
+    other.ptr = nullptr;
+    other.bytes = 0;
+    other.mapped_bytes = 0;
+    other.page_backing = PageBacking::None;
+}
+
+AlignedBuffer& AlignedBuffer::operator=(AlignedBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        ptr = other.ptr;
+        bytes = other.bytes;
+        mapped_bytes = other.mapped_bytes;
+        page_backing = other.page_backing;
+        other.ptr = nullptr;
+        other.bytes = 0;
+        other.mapped_bytes = 0;
+        other.page_backing = PageBacking::None;
+    }
+    return *this;
+}
+
+void AlignedBuffer::release() {
+    if (!ptr) {
+        return;
+    }
+    if (mapped_bytes > 0) {
+        munmap(ptr, mapped_bytes);
+    } else {
+        free(ptr);
+    }
+    ptr = nullptr;
+    bytes = 0;
+    mapped_bytes = 0;
+    page_backing = PageBacking::None;
+}
+
+bool AlignedBuffer::bindSlicesToNodes(size_t num_slices) {
+    // mbind работает только для mmap-областей
+    if (mapped_bytes == 0) {
+        return false;
+    }
+    size_t granularity = page_backing == PageBacking::Regular ? pageSize() : HUGE_PAGE_SIZE;
+    return bindRangeSlices(ptr, mapped_bytes, num_slices, granularity);
+}
+
+void AlignedBuffer::firstTouch(size_t num_threads) {
+    if (!ptr) {
+        return;
+    }
+    touchRange(ptr, bytes, num_threads);
+}
+
+// ==================== АРЕНА ====================
+
+BufferArena::BufferArena(size_t region_bytes_, size_t num_regions_, const AllocOptions& options)
+    : region_bytes(region_bytes_), num_regions(num_regions_) {
+    // Регионы не делят huge page, чтобы NUMA-привязка срезов была независимой
+    region_stride = roundUp(std::max<size_t>(region_bytes, 1), AlignedBuffer::HUGE_PAGE_SIZE);
+    
+    AllocOptions storage_options = options;
+    storage_options.numa_slices = 1;
+    storage = AlignedBuffer(region_stride * num_regions, storage_options);
+    
+    if (options.numa_slices > 1) {
+        size_t granularity = storage.backing() == PageBacking::Regular 
+            ? pageSize() : AlignedBuffer::HUGE_PAGE_SIZE;
+        for (size_t i = 0; i < num_regions; ++i) {
+            bindRangeSlices(region(i), region_stride, options.numa_slices, granularity);
+        }
+    }
+}
+
+void BufferArena::prefault(size_t num_threads) {
+    for (size_t i = 0; i < num_regions; ++i) {
+        touchRange(region(i), region_bytes, num_threads);
+    }
+}
+
+uint8_t* BufferArena::region(size_t index) {
+    return storage.data() + index * region_stride;
+}
+
+const uint8_t* BufferArena::region(size_t index) const {
+    return storage.data() + index * region_stride;
+}
+
+} // namespace buffer_utils
@@ -12,6 +12,12 @@
 #include <iomanip>
 #include <cstdlib>        // Для system()
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
 namespace benchmark_utils {
 
 // Реализация getCurrentMemoryUsage для Linux/macOS
@@ -54,6 +60,54 @@ size_t getCurrentMemoryUsage() {
     return memory_usage;
 }
 
+// ==================== СЧЕТЧИК dTLB ====================
+
+DTlbMissCounter::DTlbMissCounter() : fd(-1) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;          // учитываем рабочие потоки
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+}
+
+DTlbMissCounter::~DTlbMissCounter() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+void DTlbMissCounter::start() {
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+int64_t DTlbMissCounter::stop() {
+#ifdef __linux__
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t count = 0;
+        if (read(fd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+            return static_cast<int64_t>(count);
+        }
+    }
+#endif
+    return -1;
+}
+
 bool saveAllResultsToJson(const std::vector<BenchmarkResult>& results, 
                          const std::string& filename) {
     try {
@@ -80,6 +134,8 @@ bool saveAllResultsToJson(const std::vector<BenchmarkResult>& results,
             ss << "      \"id\": " << (i + 1) << ",\n";
             ss << "      \"algorithm\": \"" << result.algorithm << "\",\n";
             ss << "      \"dataset\": \"" << result.dataset << "\",\n";
+            ss << "      \"mode\": \"" << result.mode << "\",\n";
+            ss << "      \"streamed\": " << (result.streamed ? "true" : "false") << ",\n";
             ss << "      \"blocks_processed\": " << result.blocks_processed << ",\n";
             ss << "      \"data_size_bytes\": " << result.data_size_bytes << ",\n";
             ss << "      \"data_size_mb\": " 
@@ -88,6 +144,7 @@ bool saveAllResultsToJson(const std::vector<BenchmarkResult>& results,
             // Timing metrics
             ss << "      \"timing\": {\n";
             ss << "        \"total_time_ms\": " << result.total_time_ms << ",\n";
+            ss << "        \"first_touch_ms\": " << result.first_touch_ms << ",\n";
             ss << "        \"encryption_time_ms\": " << result.encryption_time_ms << ",\n";
             ss << "        \"decryption_time_ms\": " << result.decryption_time_ms << ",\n";
             ss << "        \"encryption_speed_ops_sec\": " << result.encryption_speed_ops_sec << ",\n";
@@ -108,8 +165,30 @@ bool saveAllResultsToJson(const std::vector<BenchmarkResult>& results,
             ss << "        \"usage_mb\": " << (result.memory_usage_bytes / (1024.0 * 1024.0)) << ",\n";
             ss << "        \"usage_kb\": " << (result.memory_usage_bytes / 1024.0) << ",\n";
             ss << "        \"bytes_per_block\": " 
-               << (result.memory_usage_bytes / (double)result.blocks_processed) << "\n";
-            ss << "      }\n";
+               << (result.memory_usage_bytes / (double)result.blocks_processed) << ",\n";
+            ss << "        \"page_backing\": \"" << result.page_backing << "\"\n";
+            ss << "      },\n";
+            
+            // TLB metrics (-1 = счетчик недоступен)
+            ss << "      \"tlb\": {\n";
+            ss << "        \"dtlb_misses\": " << result.dtlb_misses << ",\n";
+            ss << "        \"dtlb_misses_regular_pages\": " << result.dtlb_misses_regular << ",\n";
+            ss << "        \"dtlb_miss_reduction_pct\": ";
+            if (result.dtlb_misses >= 0 && result.dtlb_misses_regular > 0) {
+                ss << (100.0 * (1.0 - result.dtlb_misses / (double)result.dtlb_misses_regular));
+            } else {
+                ss << "null";
+            }
+            ss << "\n";
+            ss << "      },\n";
+            // Verification metrics
+            ss << "      \"verification\": {\n";
+            ss << "        \"enabled\": " << (result.verified ? "true" : "false") << ",\n";
+            ss << "        \"verify_time_ms\": " << result.verify_time_ms << ",\n";
+            ss << "        \"decrypt_verify_mbps\": " << result.decrypt_verify_throughput_mbps << ",\n";
+            ss << "        \"first_mismatch_block\": " << result.first_mismatch_block << "\n";
+            ss << "      },\n";
+            ss << "      \"num_threads\": " << result.num_threads << "\n";
             
             ss << "    }";
             if (i < results.size() - 1) {
@@ -0,0 +1,480 @@
+/**
+ * @file paysim_preprocess.cpp
+ * @brief Потоковая подготовка данных PaySim (замена process_paysim.py)
+ *
+ * Читает сырой лог PaySim кусками фиксированного размера, разбирает
+ * каждый кусок в несколько потоков и за один проход пишет все
+ * производные колонки (8-бит step/type, 32-бит amount, 64-бит балансы)
+ * в CSV и/или бинарные файлы. Память ограничена размером куска.
+ */
+
+#include "benchmark_utils.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+
+using namespace benchmark_utils;
+
+/**
+ * @brief Параметры запуска
+ */
+struct PreprocessOptions {
+    std::string input = "../../../data/raw/PS_20174392719_1491204439457_log.csv";
+    std::string output_dir = "../../../data/processed";
+    size_t max_rows = 0;          ///< 0 - весь файл
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunk_mb = 64;         ///< Размер куска чтения
+    bool write_csv = true;
+    bool write_binary = false;
+};
+
+/**
+ * @brief Производные колонки одного куска
+ */
+struct PaysimColumns {
+    std::vector<uint8_t> steps;
+    std::vector<uint8_t> types;
+    std::vector<uint32_t> amounts;
+    std::vector<uint64_t> old_balances;
+    std::vector<uint64_t> new_balances;
+    size_t skipped_rows = 0;
+
+    void clear() {
+        steps.clear();
+        types.clear();
+        amounts.clear();
+        old_balances.clear();
+        new_balances.clear();
+        skipped_rows = 0;
+    }
+
+    size_t size() const { return steps.size(); }
+};
+
+/**
+ * @brief Статистика по всему файлу (для сводки и paysim_test_info.json)
+ */
+struct PaysimStats {
+    size_t rows = 0;
+    size_t skipped_rows = 0;
+    uint32_t amount_min = UINT32_MAX;
+    uint32_t amount_max = 0;
+    double amount_sum = 0.0;
+    double amount_sum_sq = 0.0;
+    uint64_t old_balance_min = UINT64_MAX;
+    uint64_t old_balance_max = 0;
+    bool step_seen[256] = {};
+
+    void add(const PaysimColumns& columns) {
+        rows += columns.size();
+        skipped_rows += columns.skipped_rows;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            uint32_t amount = columns.amounts[i];
+            amount_min = std::min(amount_min, amount);
+            amount_max = std::max(amount_max, amount);
+            amount_sum += amount;
+            amount_sum_sq += static_cast<double>(amount) * amount;
+            old_balance_min = std::min(old_balance_min, columns.old_balances[i]);
+            old_balance_max = std::max(old_balance_max, columns.old_balances[i]);
+            step_seen[columns.steps[i]] = true;
+        }
+    }
+};
+
+/**
+ * @brief Тип транзакции -> код (как type_mapping в process_paysim.py)
+ */
+uint8_t mapType(const char* begin, const char* end) {
+    size_t length = end - begin;
+    auto is = [&](const char* name) {
+        return length == std::strlen(name) && std::memcmp(begin, name, length) == 0;
+    };
+    if (is("CASH_OUT")) return 1;
+    if (is("PAYMENT"))  return 2;
+    if (is("CASH_IN"))  return 3;
+    if (is("TRANSFER")) return 4;
+    if (is("DEBIT"))    return 5;
+    return 0;
+}
+
+/**
+ * @brief Разбирает десятичное число до разделителя
+ *
+ * strtod, а не from_chars: плавающий from_chars есть не во всех libc++.
+ * Кусок всегда заканчивается '\n', поэтому strtod не выходит за границу.
+ */
+bool parseDouble(const char* begin, const char* end, double& value) {
+    char* parsed_end = nullptr;
+    value = std::strtod(begin, &parsed_end);
+    return parsed_end == end;
+}
+
+/**
+ * @brief Денежная сумма -> целые центы с тем же усечением, что (x * 100).astype(uintN)
+ */
+template <typename T>
+T toCents(double value) {
+    double cents = value * 100.0;
+    if (!(cents >= 0.0)) return 0;
+    if (cents >= 18446744073709551615.0) return static_cast<T>(UINT64_MAX);
+    return static_cast<T>(static_cast<uint64_t>(cents));
+}
+
+/**
+ * @brief Разбирает строки в диапазоне [begin, end), который заканчивается '\n'
+ *
+ * Колонки: step,type,amount,nameOrig,oldbalanceOrg,newbalanceOrig,...
+ */
+void parseRange(const char* begin, const char* end, PaysimColumns& columns) {
+    const char* line = begin;
+
+    while (line < end) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!line_end) line_end = end;
+
+        // Границы первых 6 полей
+        const char* fields[7];
+        fields[0] = line;
+        int found = 1;
+        for (const char* p = line; p < line_end && found < 7; ++p) {
+            if (*p == ',') {
+                fields[found++] = p + 1;
+            }
+        }
+
+        const char* row_end = (line_end > line && line_end[-1] == '\r') ? line_end - 1 : line_end;
+
+        unsigned step = 0;
+        double amount = 0.0, old_balance = 0.0, new_balance = 0.0;
+        bool ok = found >= 7;
+        if (ok) {
+            auto step_result = std::from_chars(fields[0], fields[1] - 1, step);
+            ok = step_result.ec == std::errc() && step_result.ptr == fields[1] - 1
+                 && parseDouble(fields[2], fields[3] - 1, amount)
+                 && parseDouble(fields[4], fields[5] - 1, old_balance)
+                 && parseDouble(fields[5], fields[6] - 1, new_balance);
+        }
+
+        if (ok) {
+            columns.steps.push_back(static_cast<uint8_t>(step));  // оборачиваем в 0-255
+            columns.types.push_back(mapType(fields[1], fields[2] - 1));
+            columns.amounts.push_back(toCents<uint32_t>(amount));
+            columns.old_balances.push_back(toCents<uint64_t>(old_balance));
+            columns.new_balances.push_back(toCents<uint64_t>(new_balance));
+        } else if (row_end > line) {
+            columns.skipped_rows++;
+        }
+
+        line = line_end + 1;
+    }
+}
+
+/**
+ * @brief Выходные файлы одной колонки (CSV и/или бинарный)
+ */
+class ColumnWriter {
+private:
+    std::ofstream csv;
+    std::ofstream binary;
+    std::string text;             ///< Буфер форматирования CSV
+
+public:
+    ColumnWriter(const std::string& base_path, const PreprocessOptions& options) {
+        if (options.write_csv) {
+            csv.open(base_path + ".csv", std::ios::binary);
+            if (!csv) throw std::runtime_error("Не удалось открыть " + base_path + ".csv");
+            csv << "value\n";
+        }
+        if (options.write_binary) {
+            binary.open(base_path + ".bin", std::ios::binary);
+            if (!binary) throw std::runtime_error("Не удалось открыть " + base_path + ".bin");
+        }
+    }
+
+    template <typename T>
+    void write(const std::vector<T>& values) {
+        if (binary.is_open()) {
+            binary.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+        if (csv.is_open()) {
+            text.resize(values.size() * 21);
+            char* out = &text[0];
+            for (T value : values) {
+                out = std::to_chars(out, out + 20, static_cast<uint64_t>(value)).ptr;
+                *out++ = '\n';
+            }
+            csv.write(text.data(), out - text.data());
+        }
+    }
+};
+
+/**
+ * @brief Делит кусок на num_parts диапазонов по границам строк
+ */
+std::vector<std::pair<const char*, const char*>> splitAtLines(const char* begin, const char* end,
+                                                              size_t num_parts) {
+    std::vector<std::pair<const char*, const char*>> parts;
+    size_t approx = (end - begin) / std::max<size_t>(1, num_parts);
+    const char* start = begin;
+
+    for (size_t i = 0; i + 1 < num_parts && start < end; ++i) {
+        const char* cut = std::min(start + approx, end);
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        if (!newline) break;
+        parts.emplace_back(start, newline + 1);
+        start = newline + 1;
+    }
+    if (start < end) {
+        parts.emplace_back(start, end);
+    }
+    return parts;
+}
+
+/**
+ * @brief Обрезает колонки до max_rows общего счета
+ */
+void truncateColumns(PaysimColumns& columns, size_t keep) {
+    if (columns.size() <= keep) return;
+    columns.steps.resize(keep);
+    columns.types.resize(keep);
+    columns.amounts.resize(keep);
+    columns.old_balances.resize(keep);
+    columns.new_balances.resize(keep);
+}
+
+/**
+ * @brief Записывает paysim_test_info.json в формате process_paysim.py
+ */
+bool writeInfoJson(const std::string& path, const PaysimStats& stats, const PreprocessOptions& options) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    const char* names[] = {"paysim_8bit_step", "paysim_8bit_type", "paysim_32bit",
+                           "paysim_64bit_old", "paysim_64bit_new"};
+    std::vector<std::string> files;
+    for (const char* name : names) {
+        if (options.write_csv) files.push_back(std::string(name) + ".csv");
+        if (options.write_binary) files.push_back(std::string(name) + ".bin");
+    }
+
+    file << "{\n  \"files\": [\n";
+    for (size_t i = 0; i < files.size(); ++i) {
+        file << "    \"" << files[i] << "\"" << (i + 1 < files.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n";
+    file << "  \"data_info\": {\n";
+    file << "    \"dataset\": \"PaySim Synthetic Financial Transactions\",\n";
+    file << "    \"source\": \"https://www.kaggle.com/datasets/ealaxi/paysim1\",\n";
+    file << "    \"rows_processed\": " << stats.rows << ",\n";
+    file << "    \"samples_8bit\": " << stats.rows << ",\n";
+    file << "    \"samples_32bit\": " << stats.rows << ",\n";
+    file << "    \"samples_64bit\": " << stats.rows << ",\n";
+    file << "    \"data_types\": \"8-bit, 32-bit, 64-bit integers\",\n";
+    file << "    \"binary_layout\": \"raw little-endian arrays: uint8 step/type, uint32 amount, uint64 balances\",\n";
+    file << "    \"description\": \"Financial amounts and balances for SEED encryption testing\"\n";
+    file << "  }\n}";
+    return true;
+}
+
+/**
+ * @brief Разбирает аргументы командной строки
+ *
+ * --input PATH       сырой CSV PaySim
+ * --output-dir PATH  папка для результатов (по умолчанию data/processed)
+ * --rows N           обработать не больше N строк (0 - весь файл)
+ * --format csv|binary|both  формат выходных файлов (по умолчанию csv)
+ * --threads N        потоков разбора (по умолчанию все ядра)
+ * --chunk-mb N       размер куска чтения в МБ (по умолчанию 64)
+ */
+PreprocessOptions parseOptions(int argc, char* argv[]) {
+    PreprocessOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--input" && i + 1 < argc) {
+            options.input = argv[++i];
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            options.output_dir = argv[++i];
+        } else if (arg == "--rows" && i + 1 < argc) {
+            options.max_rows = std::stoull(argv[++i]);
+        } else if (arg == "--format" && i + 1 < argc) {
+            std::string format = argv[++i];
+            options.write_csv = (format == "csv" || format == "both");
+            options.write_binary = (format == "binary" || format == "both");
+            if (!options.write_csv && !options.write_binary) {
+                throw std::invalid_argument("Неизвестный формат: " + format);
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.num_threads = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--chunk-mb" && i + 1 < argc) {
+            options.chunk_mb = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else {
+            std::cerr << "⚠️  Неизвестный аргумент: " << arg << std::endl;
+        }
+    }
+
+    return options;
+}
+
+/**
+ * @brief Основная функция
+ */
+int main(int argc, char* argv[]) {
+    Timer total_timer;
+
+    try {
+        PreprocessOptions options = parseOptions(argc, argv);
+
+        std::cout << "==========================================" << std::endl;
+        std::cout << "   ПОДГОТОВКА ДАННЫХ PAYSIM" << std::endl;
+        std::cout << "==========================================" << std::endl;
+        std::cout << "Чтение файла: " << options.input << std::endl;
+        std::cout << "Потоков: " << options.num_threads << ", кусок: " << options.chunk_mb
+                  << " МБ, строк: " << (options.max_rows ? std::to_string(options.max_rows) : "все")
+                  << std::endl;
+
+        std::ifstream input(options.input, std::ios::binary);
+        if (!input.is_open()) {
+            std::cerr << "❌ Не удалось открыть файл: " << options.input << std::endl;
+            return 1;
+        }
+
+        if (!createDirectory(options.output_dir)) {
+            std::cerr << "❌ Не удалось создать директорию: " << options.output_dir << std::endl;
+            return 1;
+        }
+
+        ColumnWriter step_writer(options.output_dir + "/paysim_8bit_step", options);
+        ColumnWriter type_writer(options.output_dir + "/paysim_8bit_type", options);
+        ColumnWriter amount_writer(options.output_dir + "/paysim_32bit", options);
+        ColumnWriter old_writer(options.output_dir + "/paysim_64bit_old", options);
+        ColumnWriter new_writer(options.output_dir + "/paysim_64bit_new", options);
+
+        // Заголовок сырого файла
+        std::string header;
+        std::getline(input, header);
+
+        size_t chunk_bytes = options.chunk_mb * 1024 * 1024;
+        std::vector<char> chunk;
+        std::string carry;            // неполная строка с конца предыдущего куска
+        std::vector<PaysimColumns> partial(options.num_threads);
+        PaysimStats stats;
+        size_t bytes_read = 0;
+        bool done = false;
+        bool limit_reached = false;
+
+        while (!done) {
+            // 1. Чтение куска; хвост после последнего '\n' переносится в следующий
+            chunk.assign(carry.begin(), carry.end());
+            size_t offset = chunk.size();
+            chunk.resize(offset + chunk_bytes + 1);
+            input.read(chunk.data() + offset, chunk_bytes);
+            size_t got = static_cast<size_t>(input.gcount());
+            bytes_read += got;
+            chunk.resize(offset + got);
+            bool eof = got < chunk_bytes;
+
+            if (chunk.empty()) break;
+
+            size_t last_newline = chunk.size();
+            while (last_newline > 0 && chunk[last_newline - 1] != '\n') --last_newline;
+
+            if (eof) {
+                if (chunk.back() != '\n') chunk.push_back('\n');
+                last_newline = chunk.size();
+                carry.clear();
+                done = true;
+            } else {
+                carry.assign(chunk.begin() + last_newline, chunk.end());
+                chunk.resize(last_newline);
+            }
+            chunk.push_back('\0');  // ограничитель для strtod
+
+            // 2. Параллельный разбор по границам строк
+            const char* begin = chunk.data();
+            const char* end = chunk.data() + last_newline;
+            auto parts = splitAtLines(begin, end, options.num_threads);
+
+            std::vector<std::thread> workers;
+            for (size_t p = 0; p < parts.size(); ++p) {
+                partial[p].clear();
+                workers.emplace_back([&, p]() {
+                    parseRange(parts[p].first, parts[p].second, partial[p]);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+
+            // 3. Запись в исходном порядке строк
+            for (size_t p = 0; p < parts.size() && !limit_reached; ++p) {
+                PaysimColumns& columns = partial[p];
+                if (options.max_rows > 0) {
+                    size_t remaining = options.max_rows - stats.rows;
+                    if (columns.size() >= remaining) {
+                        truncateColumns(columns, remaining);
+                        limit_reached = true;
+                    }
+                }
+                step_writer.write(columns.steps);
+                type_writer.write(columns.types);
+                amount_writer.write(columns.amounts);
+                old_writer.write(columns.old_balances);
+                new_writer.write(columns.new_balances);
+                stats.add(columns);
+            }
+
+            std::cout << "  Обработано строк: " << stats.rows << "\r" << std::flush;
+            done = done || limit_reached;
+        }
+
+        double elapsed_ms = total_timer.stop();
+        std::cout << std::endl;
+
+        // 4. Статистика
+        double mean = stats.rows ? stats.amount_sum / stats.rows : 0.0;
+        double variance = stats.rows ? stats.amount_sum_sq / stats.rows - mean * mean : 0.0;
+        size_t unique_steps = std::count(std::begin(stats.step_seen), std::end(stats.step_seen), true);
+
+        std::cout << "\nСтатистика данных:" << std::endl;
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "   Amounts (32-bit): Min: " << stats.amount_min << ", Max: " << stats.amount_max
+                  << ", Mean: " << mean << ", Std: " << std::sqrt(std::max(0.0, variance)) << std::endl;
+        std::cout << "   Old Balance (64-bit): Min: " << stats.old_balance_min
+                  << ", Max: " << stats.old_balance_max << std::endl;
+        std::cout << "   Steps (8-bit): Unique values: " << unique_steps << std::endl;
+        if (stats.skipped_rows > 0) {
+            std::cout << "   ⚠️  Пропущено некорректных строк: " << stats.skipped_rows << std::endl;
+        }
+
+        std::string info_path = options.output_dir + "/paysim_test_info.json";
+        if (!writeInfoJson(info_path, stats, options)) {
+            std::cerr << "❌ Не удалось записать " << info_path << std::endl;
+            return 1;
+        }
+
+        std::cout << std::setprecision(1);
+        std::cout << "\n✅ Обработано " << stats.rows << " строк за " << elapsed_ms << " мс ("
+                  << (bytes_read / (1024.0 * 1024.0)) / (elapsed_ms / 1000.0) << " МБ/с)" << std::endl;
+        std::cout << "   Сохранено в: " << options.output_dir << std::endl;
+
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Исключение: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
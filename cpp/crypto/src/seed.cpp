@@ -5,6 +5,7 @@
 
 #include "seed.h"
 #include "seed_utils.h"
+#include "trace.h"
 #include <cstring>
 #include <stdexcept>
 #include <algorithm>
@@ -13,18 +14,12 @@ using namespace seed_utils;
 
 // ==================== ОСНОВНЫЕ МЕТОДЫ ====================
 
-std::array<uint8_t, SEED::BLOCK_SIZE> SEED::encryptBlock(
-    const std::array<uint8_t, BLOCK_SIZE>& plaintext,
-    const std::array<uint8_t, KEY_SIZE>& key) {
-    
-    uint32_t roundKeys[32];
-    generateRoundKeys(key, roundKeys);
-    
+void SEED::encryptWithRoundKeys(const uint8_t* in, uint8_t* out, const uint32_t roundKeys[32]) {
     // Разбиваем блок на 4 слова
-    uint32_t L0 = bytesToU32(plaintext.data());
-    uint32_t L1 = bytesToU32(plaintext.data() + 4);
-    uint32_t R0 = bytesToU32(plaintext.data() + 8);
-    uint32_t R1 = bytesToU32(plaintext.data() + 12);
+    uint32_t L0 = bytesToU32(in);
+    uint32_t L1 = bytesToU32(in + 4);
+    uint32_t R0 = bytesToU32(in + 8);
+    uint32_t R1 = bytesToU32(in + 12);
     
     // 16 раундов Фейстеля
     for (int round = 0; round < 16; round++) {
@@ -41,27 +36,18 @@ std::array<uint8_t, SEED::BLOCK_SIZE> SEED::encryptBlock(
     }
     
     // Финальная перестановка
-    std::array<uint8_t, BLOCK_SIZE> result;
-    u32ToBytes(R0, result.data());
-    u32ToBytes(R1, result.data() + 4);
-    u32ToBytes(L0, result.data() + 8);
-    u32ToBytes(L1, result.data() + 12);
-    
-    return result;
+    u32ToBytes(R0, out);
+    u32ToBytes(R1, out + 4);
+    u32ToBytes(L0, out + 8);
+    u32ToBytes(L1, out + 12);
 }
 
-std::array<uint8_t, SEED::BLOCK_SIZE> SEED::decryptBlock(
-    const std::array<uint8_t, BLOCK_SIZE>& ciphertext,
-    const std::array<uint8_t, KEY_SIZE>& key) {
-    
-    uint32_t roundKeys[32];
-    generateRoundKeys(key, roundKeys);
-    
+void SEED::decryptWithRoundKeys(const uint8_t* in, uint8_t* out, const uint32_t roundKeys[32]) {
     // Разбиваем блок на 4 слова
-    uint32_t L0 = bytesToU32(ciphertext.data());
-    uint32_t L1 = bytesToU32(ciphertext.data() + 4);
-    uint32_t R0 = bytesToU32(ciphertext.data() + 8);
-    uint32_t R1 = bytesToU32(ciphertext.data() + 12);
+    uint32_t L0 = bytesToU32(in);
+    uint32_t L1 = bytesToU32(in + 4);
+    uint32_t R0 = bytesToU32(in + 8);
+    uint32_t R1 = bytesToU32(in + 12);
     
     // 16 раундов Фейстеля в обратном порядке
     for (int round = 15; round >= 0; round--) {
@@ -78,15 +64,58 @@ std::array<uint8_t, SEED::BLOCK_SIZE> SEED::decryptBlock(
     }
     
     // Финальная перестановка
+    u32ToBytes(R0, out);
+    u32ToBytes(R1, out + 4);
+    u32ToBytes(L0, out + 8);
+    u32ToBytes(L1, out + 12);
+}
+
+std::array<uint8_t, SEED::BLOCK_SIZE> SEED::encryptBlock(
+    const std::array<uint8_t, BLOCK_SIZE>& plaintext,
+    const std::array<uint8_t, KEY_SIZE>& key) {
+    
+    uint32_t roundKeys[32];
+    generateRoundKeys(key, roundKeys);
+    
     std::array<uint8_t, BLOCK_SIZE> result;
-    u32ToBytes(R0, result.data());
-    u32ToBytes(R1, result.data() + 4);
-    u32ToBytes(L0, result.data() + 8);
-    u32ToBytes(L1, result.data() + 12);
+    encryptWithRoundKeys(plaintext.data(), result.data(), roundKeys);
+    return result;
+}
+
+std::array<uint8_t, SEED::BLOCK_SIZE> SEED::decryptBlock(
+    const std::array<uint8_t, BLOCK_SIZE>& ciphertext,
+    const std::array<uint8_t, KEY_SIZE>& key) {
+    
+    uint32_t roundKeys[32];
+    generateRoundKeys(key, roundKeys);
     
+    std::array<uint8_t, BLOCK_SIZE> result;
+    decryptWithRoundKeys(ciphertext.data(), result.data(), roundKeys);
     return result;
 }
 
+// ==================== ПАКЕТНАЯ ОБРАБОТКА ====================
+
+void SEED::encryptBlocks(const uint8_t* in, uint8_t* out, size_t num_blocks,
+                         const std::array<uint8_t, KEY_SIZE>& key) {
+    uint32_t roundKeys[32];
+    generateRoundKeys(key, roundKeys);
+    
+    for (size_t i = 0; i < num_blocks; ++i) {
+        encryptWithRoundKeys(in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, roundKeys);
+    }
+}
+
+void SEED::decryptBlocks(const uint8_t* in, uint8_t* out, size_t num_blocks,
+                         const std::array<uint8_t, KEY_SIZE>& key) {
+    uint32_t roundKeys[32];
+    generateRoundKeys(key, roundKeys);
+    
+    for (size_t i = 0; i < num_blocks; ++i) {
+        decryptWithRoundKeys(in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, roundKeys);
+    }
+}
+
 // ==================== ПОТОКОВОЕ ШИФРОВАНИЕ ====================
 
 std::vector<uint8_t> SEED::addPadding(const std::vector<uint8_t>& data) {
@@ -132,6 +161,7 @@ std::vector<uint8_t> SEED::removePadding(const std::vector<uint8_t>& data) {
 std::vector<uint8_t> SEED::encrypt(
     const std::vector<uint8_t>& data,
     const std::array<uint8_t, KEY_SIZE>& key) {
+    TRACE_SPAN_VALUE("SEED::encrypt", data.size());
     
     if (data.empty()) {
         return {};
@@ -157,6 +187,7 @@ std::vector<uint8_t> SEED::encrypt(
 std::vector<uint8_t> SEED::decrypt(
     const std::vector<uint8_t>& data,
     const std::array<uint8_t, KEY_SIZE>& key) {
+    TRACE_SPAN_VALUE("SEED::decrypt", data.size());
     
     if (data.empty()) {
         return {};
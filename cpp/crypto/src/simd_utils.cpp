@@ -0,0 +1,79 @@
+/**
+ * @file simd_utils.cpp
+ * @brief Реализация векторизованного сравнения буферов
+ */
+
+#include "simd_utils.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace simd_utils {
+
+namespace {
+
+size_t scalarMismatch(const uint8_t* a, const uint8_t* b, size_t begin, size_t bytes) {
+    for (size_t i = begin; i < bytes; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+size_t findFirstMismatch(const uint8_t* a, const uint8_t* b, size_t bytes) {
+    size_t i = 0;
+    
+#if defined(__AVX2__)
+    // 64 байта за итерацию: две 32-байтные загрузки, одна проверка
+    for (; i + 64 <= bytes; i += 64) {
+        __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(a0, b0), _mm256_cmpeq_epi8(a1, b1));
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(eq)) != 0xFFFFFFFFu) {
+            return scalarMismatch(a, b, i, i + 64);
+        }
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (mask != 0xFFFF) {
+            return i + static_cast<size_t>(__builtin_ctz(~mask & 0xFFFF));
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        if (vminvq_u8(eq) != 0xFF) {
+            return scalarMismatch(a, b, i, i + 16);
+        }
+    }
+#endif
+    
+    return scalarMismatch(a, b, i, bytes);
+}
+
+const char* simdBackendName() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace simd_utils
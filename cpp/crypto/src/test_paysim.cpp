@@ -5,6 +5,10 @@
 
 #include "seed.h"
 #include "benchmark_utils.h"
+#include "aligned_buffer.h"
+#include "simd_utils.h"
+#include "workload_generator.h"
+#include "trace.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
@@ -17,13 +21,71 @@
 #include <numeric>
 #include <memory>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <unistd.h>
 
 using namespace benchmark_utils;
+using buffer_utils::AlignedBuffer;
+using buffer_utils::AllocOptions;
+using buffer_utils::BufferArena;
+
+/**
+ * @brief Параметры запуска benchmark (задаются из командной строки)
+ */
+struct BenchmarkOptions {
+    size_t num_threads = 1;       ///< Количество рабочих потоков
+    bool huge_pages = true;       ///< Пытаться размещать буферы на huge pages
+    bool compare_pages = false;   ///< Дополнительный прогон на обычных страницах для сравнения dTLB
+    bool warm = true;             ///< Прогоны на заранее прогретой арене
+    bool cold = true;             ///< Отдельный прогон на свежих буферах с замером первого касания
+    bool verify = false;          ///< Полная проверка: расшифровка в буфер и сравнение с открытым текстом
+    std::string synthetic;        ///< Распределение синтетических данных ("" - читать CSV)
+    uint64_t seed = 42;           ///< Seed генератора синтетических данных
+    size_t max_blocks = 100000000; ///< Верхняя граница размеров для синтетических данных
+    size_t mem_limit_mb = 0;      ///< Лимит памяти под буферы (0 - половина физической памяти)
+    std::string trace_file;       ///< Куда записать трассу этапов ("" - без трассировки)
+};
+
+/**
+ * @brief Источник открытого текста для benchmark
+ *
+ * fill(out, first_block, num_blocks) записывает блоки с номерами
+ * first_block... в out; вызывается параллельно для непересекающихся срезов.
+ */
+struct BlockSource {
+    std::string dataset;
+    size_t available;             ///< Сколько блоков можно получить
+    std::function<void(uint8_t*, size_t, size_t)> fill;
+};
+
+/**
+ * @brief Буферы одного прогона (view на арену или на свежие буферы)
+ */
+struct BlockBuffers {
+    uint8_t* plain;
+    uint8_t* encrypted;
+    uint8_t* decrypted;           ///< nullptr если проверка выключена
+    buffer_utils::PageBacking backing;
+};
+
+/**
+ * @brief Параметры выделения буферов для заданных опций benchmark
+ */
+AllocOptions makeAllocOptions(const BenchmarkOptions& options) {
+    AllocOptions alloc;
+    alloc.try_hugetlb = options.huge_pages;
+    alloc.try_thp = options.huge_pages;
+    alloc.numa_slices = options.num_threads;
+    return alloc;
+}
 
 /**
  * @brief Читает весь CSV файл с ценами
  */
 std::vector<uint32_t> readEntireCSV(const std::string& filename) {
+    trace::Span span("readEntireCSV");
     std::vector<uint32_t> prices;
     std::ifstream file(filename);
     
@@ -47,54 +109,174 @@ std::vector<uint32_t> readEntireCSV(const std::string& filename) {
     }
     
     file.close();
+    span.setValue(static_cast<int64_t>(prices.size()));
     std::cout << "Прочитано " << prices.size() << " записей" << std::endl;
     
     return prices;
 }
 
 /**
- * @brief Преобразует 32-битную цену в 128-битный блок
+ * @brief Источник блоков из прочитанного CSV
+ */
+BlockSource makeCsvSource(const std::vector<uint32_t>& prices) {
+    BlockSource source;
+    source.dataset = "paysim_32bit";
+    source.available = prices.size();
+    source.fill = [&prices](uint8_t* out, size_t first_block, size_t num_blocks) {
+        for (size_t i = 0; i < num_blocks; i++) {
+            workload::encodeValueBlock(prices[first_block + i], out + i * SEED::BLOCK_SIZE);
+        }
+    };
+    return source;
+}
+
+/**
+ * @brief Источник синтетических блоков (без входного файла)
  */
-std::array<uint8_t, SEED::BLOCK_SIZE> priceToBlock(uint32_t price) {
-    std::array<uint8_t, SEED::BLOCK_SIZE> block{};
+BlockSource makeSyntheticSource(const workload::GeneratorConfig& config) {
+    BlockSource source;
+    source.dataset = std::string("synthetic_") + workload::distributionName(config.distribution);
+    source.available = std::numeric_limits<size_t>::max();
+    source.fill = [config](uint8_t* out, size_t first_block, size_t num_blocks) {
+        workload::fillBlocks(out, first_block, num_blocks, config);
+    };
+    return source;
+}
+
+/**
+ * @brief Размеры для тестирования
+ *
+ * Для CSV - прежний набор до 1M блоков; для синтетики - шаги 1 и 3
+ * на декаду от 10^4 до max_blocks.
+ */
+std::vector<size_t> makeTestSizes(const BlockSource& source, const BenchmarkOptions& options) {
+    std::vector<size_t> sizes;
     
-    block[0] = static_cast<uint8_t>(price >> 24);
-    block[1] = static_cast<uint8_t>(price >> 16);
-    block[2] = static_cast<uint8_t>(price >> 8);
-    block[3] = static_cast<uint8_t>(price);
+    if (options.synthetic.empty()) {
+        for (size_t size : {10000, 50000, 100000, 250000, 500000, 750000, 1000000}) {
+            if (size <= source.available) {
+                sizes.push_back(size);
+            } else {
+                std::cerr << "⚠️  Недостаточно данных для размера " << size 
+                          << " (доступно: " << source.available << ")" << std::endl;
+            }
+        }
+        return sizes;
+    }
     
-    for (size_t i = 4; i < SEED::BLOCK_SIZE; i++) {
-        block[i] = static_cast<uint8_t>(i);
+    for (size_t decade = 10000; decade <= options.max_blocks; decade *= 10) {
+        sizes.push_back(decade);
+        if (decade * 3 <= options.max_blocks) {
+            sizes.push_back(decade * 3);
+        }
+        if (decade > options.max_blocks / 10) break;
     }
+    if (sizes.empty() || sizes.back() != options.max_blocks) {
+        sizes.push_back(options.max_blocks);
+    }
+    return sizes;
+}
+
+/**
+ * @brief Лимит памяти под буферы benchmark в байтах
+ */
+size_t memoryLimitBytes(const BenchmarkOptions& options) {
+    if (options.mem_limit_mb > 0) {
+        return options.mem_limit_mb * 1024 * 1024;
+    }
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || page_size <= 0) {
+        return size_t(1) << 30;
+    }
+    return static_cast<size_t>(pages) * static_cast<size_t>(page_size) / 2;
+}
+
+/**
+ * @brief Шифрует буфер блоков, разбивая его на срезы по потокам
+ */
+void encryptBuffer(const uint8_t* in, uint8_t* out, size_t num_blocks,
+                   const std::array<uint8_t, SEED::KEY_SIZE>& key, size_t num_threads) {
+    parallelFor(num_blocks, num_threads, [&](size_t begin, size_t end) {
+        TRACE_SPAN_VALUE("encrypt", end - begin);
+        SEED::encryptBlocks(in + begin * SEED::BLOCK_SIZE,
+                            out + begin * SEED::BLOCK_SIZE,
+                            end - begin, key);
+    });
+}
+
+/**
+ * @brief Измеряет промахи dTLB при шифровании на обычных страницах
+ * @return Количество промахов или -1 если счетчик недоступен
+ */
+int64_t measureRegularPagesDTlb(const uint8_t* blocks, size_t num_blocks,
+                                const std::array<uint8_t, SEED::KEY_SIZE>& key,
+                                size_t num_threads) {
+    AllocOptions regular;
+    regular.try_hugetlb = false;
+    regular.try_thp = false;
+    regular.numa_slices = num_threads;
+    
+    size_t bytes = num_blocks * SEED::BLOCK_SIZE;
+    AlignedBuffer plain(bytes, regular);
+    AlignedBuffer encrypted(bytes, regular);
+    plain.firstTouch(num_threads);
+    encrypted.firstTouch(num_threads);
+    std::memcpy(plain.data(), blocks, bytes);
     
-    return block;
+    DTlbMissCounter counter;
+    counter.start();
+    encryptBuffer(plain.data(), encrypted.data(), num_blocks, key, num_threads);
+    return counter.stop();
+}
+
+/**
+ * @brief Пересчитывает скорости по временам и количеству блоков
+ */
+void computeRates(BenchmarkResult& result) {
+    size_t blocks = result.blocks_processed;
+    result.total_time_ms = result.encryption_time_ms + result.decryption_time_ms;
+    result.encryption_speed_ops_sec = (blocks * 1000.0) / result.encryption_time_ms;
+    result.decryption_speed_ops_sec = (blocks * 1000.0) / result.decryption_time_ms;
+    result.encryption_throughput_mbps = 
+        (blocks * 128.0) / (result.encryption_time_ms / 1000.0) / 1e6;
+    result.decryption_throughput_mbps = 
+        (blocks * 128.0) / (result.decryption_time_ms / 1000.0) / 1e6;
 }
 
 /**
  * @brief Запускает benchmark для одного размера данных
+ *
+ * Буферы передаются снаружи и к этому моменту уже имеют физические
+ * страницы, поэтому время шифрования не включает выделение памяти.
  */
-BenchmarkResult runSingleBenchmark(const std::vector<uint32_t>& prices, 
-                                  size_t sample_size) {
+BenchmarkResult runSingleBenchmark(const BlockSource& source, 
+                                  size_t sample_size,
+                                  const BenchmarkOptions& options,
+                                  const BlockBuffers& buffers,
+                                  size_t first_block = 0) {
     BenchmarkResult result;
     result.algorithm = "SEED";
-    result.dataset = "paysim_32bit";
+    result.dataset = source.dataset;
     result.blocks_processed = sample_size;
     result.data_size_bytes = sample_size * SEED::BLOCK_SIZE;
+    result.num_threads = options.num_threads;
+    result.page_backing = buffer_utils::pageBackingName(buffers.backing);
     
     // Убедимся что есть достаточно данных
-    if (sample_size > prices.size()) {
+    if (first_block + sample_size > source.available) {
         std::cerr << "❌ Недостаточно данных для размера " << sample_size 
-                  << " (доступно: " << prices.size() << ")" << std::endl;
+                  << " (доступно: " << source.available << ")" << std::endl;
         return result;
     }
     
-    // 1. Подготовка блоков
-    std::vector<std::array<uint8_t, SEED::BLOCK_SIZE>> blocks;
-    blocks.reserve(sample_size);
+    TRACE_SPAN_VALUE("runSingleBenchmark", sample_size);
     
-    for (size_t i = 0; i < sample_size; i++) {
-        blocks.push_back(priceToBlock(prices[i]));
-    }
+    // 1. Подготовка блоков
+    parallelFor(sample_size, options.num_threads, [&](size_t begin, size_t end) {
+        TRACE_SPAN_VALUE("fill", end - begin);
+        source.fill(buffers.plain + begin * SEED::BLOCK_SIZE, first_block + begin, end - begin);
+    });
     
     // 2. Генерация ключа
     std::array<uint8_t, SEED::KEY_SIZE> key = {};
@@ -102,114 +284,300 @@ BenchmarkResult runSingleBenchmark(const std::vector<uint32_t>& prices,
         key[i] = static_cast<uint8_t>((i * 17 + 23) % 256);
     }
     
-    // 3. Измерение памяти ДО шифрования
-    size_t memory_before = getCurrentMemoryUsage();
-    if (memory_before == 0) {
-        std::cout << "   ⚠️  Не удалось измерить начальную память" << std::endl;
-    }
-    
-    // 4. Шифрование
+    // 3. Шифрование
+    DTlbMissCounter tlb_counter;
+    tlb_counter.start();
     Timer encrypt_timer;
-    std::vector<std::array<uint8_t, SEED::BLOCK_SIZE>> encrypted_blocks;
-    encrypted_blocks.reserve(sample_size);
     
-    for (size_t i = 0; i < sample_size; i++) {
-        encrypted_blocks.push_back(SEED::encryptBlock(blocks[i], key));
-    }
+    encryptBuffer(buffers.plain, buffers.encrypted, sample_size, key, options.num_threads);
+    clobberMemory();
     
     result.encryption_time_ms = encrypt_timer.elapsed();
+    result.dtlb_misses = tlb_counter.stop();
     
-    // Измерение памяти после шифрования
-    size_t memory_after_encrypt = getCurrentMemoryUsage();
-    
-    // 5. Дешифрование
+    // 4. Дешифрование
     Timer decrypt_timer;
     
-    for (size_t i = 0; i < sample_size; i++) {
-        auto decrypted = SEED::decryptBlock(encrypted_blocks[i], key);
-        (void)decrypted;
+    if (buffers.decrypted) {
+        // Полная расшифровка в буфер для последующей проверки
+        parallelFor(sample_size, options.num_threads, [&](size_t begin, size_t end) {
+            TRACE_SPAN_VALUE("decrypt", end - begin);
+            SEED::decryptBlocks(buffers.encrypted + begin * SEED::BLOCK_SIZE,
+                                buffers.decrypted + begin * SEED::BLOCK_SIZE,
+                                end - begin, key);
+        });
+        clobberMemory();
+    } else {
+        // Результат пишется в небольшой буфер потока; барьер не дает выбросить цикл
+        parallelFor(sample_size, options.num_threads, [&](size_t begin, size_t end) {
+            TRACE_SPAN_VALUE("decrypt", end - begin);
+            constexpr size_t CHUNK_BLOCKS = 256;
+            uint8_t scratch[CHUNK_BLOCKS * SEED::BLOCK_SIZE];
+            for (size_t i = begin; i < end; i += CHUNK_BLOCKS) {
+                size_t count = std::min(CHUNK_BLOCKS, end - i);
+                SEED::decryptBlocks(buffers.encrypted + i * SEED::BLOCK_SIZE,
+                                    scratch, count, key);
+                doNotOptimize(scratch);
+            }
+        });
     }
     
     result.decryption_time_ms = decrypt_timer.elapsed();
     
-    // Измерение памяти после дешифрования
-    size_t memory_after_decrypt = getCurrentMemoryUsage();
-    
-    // 6. Расчет метрик памяти
-    if (memory_before > 0 && memory_after_encrypt > 0 && memory_after_decrypt > 0) {
-        // Берем максимальное использование памяти
-        size_t max_memory = std::max({memory_before, memory_after_encrypt, memory_after_decrypt});
-        size_t min_memory = std::min({memory_before, memory_after_encrypt, memory_after_decrypt});
-        result.memory_usage_bytes = max_memory - min_memory;
+    // Проверка: векторное сравнение расшифровки с открытым текстом
+    if (buffers.decrypted) {
+        TRACE_SPAN_VALUE("verify", sample_size);
+        Timer verify_timer;
+        size_t bytes = sample_size * SEED::BLOCK_SIZE;
+        size_t mismatch = simd_utils::findFirstMismatch(buffers.plain, buffers.decrypted, bytes);
+        result.verify_time_ms = verify_timer.elapsed();
+        result.verified = true;
         
-        // Убедимся, что значение реалистичное (должно быть хотя бы размер данных)
-        size_t min_expected_memory = sample_size * SEED::BLOCK_SIZE * 2; // blocks + encrypted_blocks
-        if (result.memory_usage_bytes < min_expected_memory) {
-            result.memory_usage_bytes = min_expected_memory;
-            std::cout << "   ⚠️  Память скорректирована до минимального ожидаемого значения: " 
-                      << (result.memory_usage_bytes / (1024.0 * 1024.0)) << " MB" << std::endl;
+        if (mismatch < bytes) {
+            result.first_mismatch_block = static_cast<int64_t>(mismatch / SEED::BLOCK_SIZE);
+            std::cerr << "\n❌ Расшифровка не совпала: блок #" << result.first_mismatch_block
+                      << ", байт " << (mismatch % SEED::BLOCK_SIZE) << std::endl;
         }
-    } else {
-        // Если измерение не сработало, используем расчетный метод
-        result.memory_usage_bytes = 
-            sample_size * SEED::BLOCK_SIZE * 2 +  // blocks + encrypted_blocks
-            SEED::KEY_SIZE +                       // key
-            32 * sizeof(uint32_t) +               // roundKeys в SEED
-            1024 * 1024;                          // overhead (1MB)
         
-        std::cout << "   ⚠️  Память измерена расчетным методом: " 
-                  << (result.memory_usage_bytes / (1024.0 * 1024.0)) << " MB" << std::endl;
+        result.decrypt_verify_throughput_mbps = 
+            (sample_size * 128.0) / ((result.decryption_time_ms + result.verify_time_ms) / 1000.0) / 1e6;
+    }
+    
+    // 5. Рабочий набор прогона: открытый текст + шифртекст (+ расшифровка)
+    result.memory_usage_bytes = sample_size * SEED::BLOCK_SIZE * (buffers.decrypted ? 3 : 2);
+    
+    // 6. Сравнение промахов dTLB с обычными страницами
+    if (options.compare_pages && buffers.backing != buffer_utils::PageBacking::Regular) {
+        result.dtlb_misses_regular = measureRegularPagesDTlb(buffers.plain, sample_size, key, 
+                                                             options.num_threads);
+    } else if (buffers.backing == buffer_utils::PageBacking::Regular) {
+        result.dtlb_misses_regular = result.dtlb_misses;
     }
     
     // 7. Расчет метрик производительности
-    result.total_time_ms = result.encryption_time_ms + result.decryption_time_ms;
-    result.encryption_speed_ops_sec = (sample_size * 1000.0) / result.encryption_time_ms;
-    result.decryption_speed_ops_sec = (sample_size * 1000.0) / result.decryption_time_ms;
-    result.encryption_throughput_mbps = 
-        (sample_size * 128.0) / (result.encryption_time_ms / 1000.0) / 1e6;
-    result.decryption_throughput_mbps = 
-        (sample_size * 128.0) / (result.decryption_time_ms / 1000.0) / 1e6;
+    computeRates(result);
     
     return result;
 }
 
+/**
+ * @brief Прогон объема больше арены: данные проходят через окно фиксированного размера
+ *
+ * Каждое окно генерируется заново (вне замера), шифруется и дешифруется;
+ * времена и счетчики суммируются. Память остается O(окно) при любом объеме.
+ */
+BenchmarkResult runStreamingBenchmark(const BlockSource& source,
+                                      size_t total_blocks,
+                                      const BenchmarkOptions& options,
+                                      const BlockBuffers& buffers,
+                                      size_t window_blocks) {
+    BenchmarkResult total;
+    bool first_window = true;
+    
+    for (size_t first = 0; first < total_blocks; first += window_blocks) {
+        size_t count = std::min(window_blocks, total_blocks - first);
+        BenchmarkResult window = runSingleBenchmark(source, count, options, buffers, first);
+        
+        if (first_window) {
+            total = window;
+            first_window = false;
+            continue;
+        }
+        
+        total.encryption_time_ms += window.encryption_time_ms;
+        total.decryption_time_ms += window.decryption_time_ms;
+        total.verify_time_ms += window.verify_time_ms;
+        total.dtlb_misses = (total.dtlb_misses >= 0 && window.dtlb_misses >= 0)
+            ? total.dtlb_misses + window.dtlb_misses : -1;
+        total.dtlb_misses_regular = (total.dtlb_misses_regular >= 0 && window.dtlb_misses_regular >= 0)
+            ? total.dtlb_misses_regular + window.dtlb_misses_regular : -1;
+        if (total.first_mismatch_block < 0 && window.first_mismatch_block >= 0) {
+            total.first_mismatch_block = static_cast<int64_t>(first) + window.first_mismatch_block;
+        }
+    }
+    
+    total.blocks_processed = total_blocks;
+    total.data_size_bytes = total_blocks * SEED::BLOCK_SIZE;
+    total.streamed = true;
+    if (total.verified) {
+        total.decrypt_verify_throughput_mbps = 
+            (total_blocks * 128.0) / ((total.decryption_time_ms + total.verify_time_ms) / 1000.0) / 1e6;
+    }
+    computeRates(total);
+    
+    return total;
+}
+
+/**
+ * @brief «Холодный» прогон: свежие буферы, первое касание измеряется отдельно
+ *
+ * Время выделения и page fault записывается в first_touch_ms,
+ * рост RSS - в memory_usage_bytes; шифрование измеряется как обычно.
+ */
+BenchmarkResult runColdBenchmark(const BlockSource& source,
+                                 size_t sample_size,
+                                 const BenchmarkOptions& options) {
+    size_t bytes = sample_size * SEED::BLOCK_SIZE;
+    size_t memory_before = getCurrentMemoryUsage();
+    
+    AlignedBuffer blocks;
+    AlignedBuffer encrypted_blocks;
+    AlignedBuffer decrypted_blocks;
+    double first_touch_ms = 0.0;
+    {
+        // Спан закрывается до шифрования: в трассе только выделение и первое касание
+        Timer touch_timer;
+        trace::Span touch_span("firstTouch", static_cast<int64_t>(sample_size));
+        blocks = AlignedBuffer(bytes, makeAllocOptions(options));
+        encrypted_blocks = AlignedBuffer(bytes, makeAllocOptions(options));
+        decrypted_blocks = AlignedBuffer(options.verify ? bytes : 0, makeAllocOptions(options));
+        blocks.firstTouch(options.num_threads);
+        encrypted_blocks.firstTouch(options.num_threads);
+        decrypted_blocks.firstTouch(options.num_threads);
+        first_touch_ms = touch_timer.elapsed();
+    }
+    
+    size_t memory_after = getCurrentMemoryUsage();
+    
+    BlockBuffers buffers = {blocks.data(), encrypted_blocks.data(), 
+                            options.verify ? decrypted_blocks.data() : nullptr,
+                            blocks.backing()};
+    BenchmarkResult result = runSingleBenchmark(source, sample_size, options, buffers);
+    result.mode = "cold";
+    result.first_touch_ms = first_touch_ms;
+    
+    if (memory_before > 0 && memory_after > memory_before) {
+        result.memory_usage_bytes = memory_after - memory_before;
+    }
+    
+    return result;
+}
+
+/**
+ * @brief Выводит краткий результат прогона
+ */
+void printRunSummary(const BenchmarkResult& result) {
+    std::cout << "   Шифрование: " << result.encryption_time_ms << " мс (" 
+              << std::fixed << std::setprecision(0)
+              << (result.encryption_speed_ops_sec / 1000) << "K блоков/сек)" << std::endl;
+    if (result.mode == "cold") {
+        std::cout << "   Первое касание: " << std::setprecision(2) 
+                  << result.first_touch_ms << " мс" << std::endl;
+    }
+    std::cout << "   Память: " << std::fixed << std::setprecision(1)
+              << (result.memory_usage_bytes / (1024.0 * 1024.0)) << " MB ("
+              << result.page_backing << ")" << std::endl;
+    if (result.dtlb_misses >= 0) {
+        std::cout << "   Промахи dTLB: " << result.dtlb_misses;
+        if (result.dtlb_misses_regular > 0 && 
+            result.page_backing != "regular") {
+            std::cout << " (обычные страницы: " << result.dtlb_misses_regular
+                      << ", снижение " << std::setprecision(1)
+                      << 100.0 * (1.0 - result.dtlb_misses / (double)result.dtlb_misses_regular)
+                      << "%)";
+        }
+        std::cout << std::endl;
+    }
+    if (result.verified) {
+        std::cout << "   Дешифрование: " << std::setprecision(1) << result.decryption_throughput_mbps
+                  << " Mbps, с проверкой: " << result.decrypt_verify_throughput_mbps << " Mbps "
+                  << (result.first_mismatch_block < 0 ? "✓" : "❌") << std::endl;
+    }
+}
+
 /**
  * @brief Запускает серию benchmarks на разных размерах
+ *
+ * Арена выделяется один раз под максимальный размер (но не больше
+ * лимита памяти) и прогревается до первого замера; каждый прогон
+ * получает view на ее регионы. Размеры больше арены прогоняются
+ * потоково через окно размером с арену.
+ *
+ * Арена живет весь прогон, поэтому в режиме both лимит делится:
+ * арене - не больше половины, холодным буферам - остаток лимита.
  */
-std::vector<BenchmarkResult> runMultiSizeBenchmark(const std::vector<uint32_t>& prices) {
+std::vector<BenchmarkResult> runMultiSizeBenchmark(const BlockSource& source,
+                                                   const BenchmarkOptions& options) {
     std::vector<BenchmarkResult> results;
     
     // Размеры для тестирования
-    std::vector<size_t> test_sizes = {10000, 50000, 100000, 250000, 500000, 750000, 1000000};
+    std::vector<size_t> test_sizes = makeTestSizes(source, options);
+    if (test_sizes.empty()) {
+        return results;
+    }
     
     std::cout << "\n==========================================" << std::endl;
     std::cout << "   МНОГОМЕРНЫЙ БЕНЧМАРК SEED" << std::endl;
     std::cout << "==========================================" << std::endl;
     
+    size_t num_regions = options.verify ? 3 : 2;
+    size_t max_size = *std::max_element(test_sizes.begin(), test_sizes.end());
+    size_t limit_blocks = std::max<size_t>(1, memoryLimitBytes(options) / (num_regions * SEED::BLOCK_SIZE));
+    size_t arena_blocks = std::min(max_size, options.cold ? std::max<size_t>(1, limit_blocks / 2) : limit_blocks);
+    size_t cold_blocks = options.warm ? limit_blocks - arena_blocks : limit_blocks;
+    
+    BufferArena arena;
+    if (options.warm) {
+        arena = BufferArena(arena_blocks * SEED::BLOCK_SIZE, num_regions, 
+                            makeAllocOptions(options));
+        
+        Timer prefault_timer;
+        arena.prefault(options.num_threads);
+        std::cout << "Арена: " << std::fixed << std::setprecision(1)
+                  << (arena.capacityBytes() / (1024.0 * 1024.0)) << " MB ("
+                  << buffer_utils::pageBackingName(arena.backing()) << "), прогрев "
+                  << prefault_timer.elapsed() << " мс" << std::endl;
+    }
+    
     for (size_t i = 0; i < test_sizes.size(); i++) {
         size_t sample_size = test_sizes[i];
+        bool streamed = sample_size > arena_blocks;
         
         std::cout << "\n🔬 ТЕСТ " << (i+1) << "/" << test_sizes.size() 
                   << ": " << sample_size << " блоков" << std::endl;
         std::cout << "   (" << (sample_size * SEED::BLOCK_SIZE / (1024.0 * 1024.0)) 
-                  << " МБ данных)" << std::endl;
+                  << " МБ данных" << (streamed ? ", потоково через арену" : "") 
+                  << ")" << std::endl;
+        
+        // Холодный прогон: стоимость первого касания отдельно от шифрования
+        if (options.cold && sample_size <= cold_blocks) {
+            std::cout << "   Холодный запуск... ";
+            auto result = runColdBenchmark(source, sample_size, options);
+            results.push_back(result);
+            std::cout << "OK" << std::endl;
+            printRunSummary(result);
+        }
+        
+        if (!options.warm) {
+            continue;
+        }
+        
+        BlockBuffers buffers = {arena.region(0), arena.region(1),
+                                options.verify ? arena.region(2) : nullptr,
+                                arena.backing()};
+        
+        if (streamed) {
+            // Кэш не помогает при таком объеме - прогрев не нужен
+            std::cout << "   Потоковый запуск... ";
+            auto result = runStreamingBenchmark(source, sample_size, options, buffers, arena_blocks);
+            results.push_back(result);
+            std::cout << "OK" << std::endl;
+            printRunSummary(result);
+            continue;
+        }
         
         // Запускаем benchmark 3 раза для каждого размера (учитываем кэш)
         for (int run = 0; run < 3; run++) {
             std::cout << "   Запуск " << (run+1) << "/3... ";
             
-            auto result = runSingleBenchmark(prices, sample_size);
+            auto result = runSingleBenchmark(source, sample_size, options, buffers);
             
             // Сохраняем результат
             if (run == 2) { // Берем последний (прогретый) результат
                 results.push_back(result);
                 
                 std::cout << "OK" << std::endl;
-                std::cout << "   Шифрование: " << result.encryption_time_ms << " мс (" 
-                          << std::fixed << std::setprecision(0)
-                          << (result.encryption_speed_ops_sec / 1000) << "K блоков/сек)" << std::endl;
-                std::cout << "   Память: " << std::fixed << std::setprecision(1)
-                          << (result.memory_usage_bytes / (1024.0 * 1024.0)) << " MB" << std::endl;
+                printRunSummary(result);
             } else {
                 std::cout << "прогрев" << std::endl;
             }
@@ -219,28 +587,101 @@ std::vector<BenchmarkResult> runMultiSizeBenchmark(const std::vector<uint32_t>&
     return results;
 }
 
+/**
+ * @brief Разбирает аргументы командной строки
+ *
+ * --threads N        количество рабочих потоков (по умолчанию 1)
+ * --no-hugepages     не использовать huge pages
+ * --compare-pages    измерить промахи dTLB также на обычных страницах
+ * --mode warm|cold|both  прогоны на прогретой арене, на свежих буферах или оба (по умолчанию both)
+ * --verify           полная проверка расшифровки всех блоков
+ * --synthetic uniform|paysim  генерировать данные вместо чтения 1mln.csv
+ * --seed N           seed генератора (по умолчанию 42)
+ * --max-blocks N     наибольший размер для синтетики (по умолчанию 10^8, до 10^9 и выше)
+ * --mem-limit-mb N   лимит памяти под буферы; больший объем прогоняется потоково
+ * --trace FILE       записать этапы в Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+ */
+BenchmarkOptions parseOptions(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            options.num_threads = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--no-hugepages") {
+            options.huge_pages = false;
+        } else if (arg == "--compare-pages") {
+            options.compare_pages = true;
+        } else if (arg == "--verify") {
+            options.verify = true;
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            options.synthetic = argv[++i];
+            workload::parseDistribution(options.synthetic);  // проверка имени
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (arg == "--max-blocks" && i + 1 < argc) {
+            options.max_blocks = std::max<size_t>(10000, static_cast<size_t>(std::stod(argv[++i])));
+        } else if (arg == "--mem-limit-mb" && i + 1 < argc) {
+            options.mem_limit_mb = std::stoul(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.trace_file = argv[++i];
+        } else if (arg == "--mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            options.warm = (mode == "warm" || mode == "both");
+            options.cold = (mode == "cold" || mode == "both");
+            if (!options.warm && !options.cold) {
+                std::cerr << "⚠️  Неизвестный режим: " << mode << ", используется both" << std::endl;
+                options.warm = options.cold = true;
+            }
+        } else {
+            std::cerr << "⚠️  Неизвестный аргумент: " << arg << std::endl;
+        }
+    }
+    
+    return options;
+}
+
 /**
  * @brief Основная функция
  */
-int main() {
+int main(int argc, char* argv[]) {
     Timer total_timer("Полный benchmark");
     
     try {
+        BenchmarkOptions options = parseOptions(argc, argv);
+        if (!options.trace_file.empty()) {
+            trace::start();
+        }
+        
         // 1. Загрузка данных
         std::cout << "==========================================" << std::endl;
         std::cout << "   SEED CRYPTO BENCHMARK SUITE" << std::endl;
         std::cout << "==========================================" << std::endl;
         
-        auto prices = readEntireCSV("../../../data/processed/1mln.csv");
+        std::vector<uint32_t> prices;
+        BlockSource source;
         
-        if (prices.empty()) {
-            std::cerr << "❌ Нет данных для тестирования" << std::endl;
-            return 1;
-        }
-        
-        if (prices.size() < 1000000) {
-            std::cout << "⚠️  Внимание: файл содержит " << prices.size() 
-                      << " записей (ожидалось 1,000,000)" << std::endl;
+        if (options.synthetic.empty()) {
+            prices = readEntireCSV("../../../data/processed/1mln.csv");
+            
+            if (prices.empty()) {
+                std::cerr << "❌ Нет данных для тестирования" << std::endl;
+                return 1;
+            }
+            
+            if (prices.size() < 1000000) {
+                std::cout << "⚠️  Внимание: файл содержит " << prices.size() 
+                          << " записей (ожидалось 1,000,000)" << std::endl;
+            }
+            source = makeCsvSource(prices);
+        } else {
+            workload::GeneratorConfig config;
+            config.distribution = workload::parseDistribution(options.synthetic);
+            config.seed = options.seed;
+            source = makeSyntheticSource(config);
+            std::cout << "Синтетические данные: " << options.synthetic 
+                      << ", seed " << options.seed << ", до " << options.max_blocks 
+                      << " блоков" << std::endl;
         }
         
         // 2. Быстрая проверка корректности
@@ -252,17 +693,21 @@ int main() {
             test_key[i] = static_cast<uint8_t>((i * 17 + 23) % 256);
         }
         
-        // Проверяем 100 случайных записей
-        for (int i = 0; i < 100; i++) {
-            size_t idx = i * 10000 % prices.size();
-            auto plaintext = priceToBlock(prices[idx]);
-            auto encrypted = SEED::encryptBlock(plaintext, test_key);
-            auto decrypted = SEED::decryptBlock(encrypted, test_key);
+        {
+            TRACE_SPAN("correctnessCheck");
+            // Проверяем 100 случайных записей
+            for (int i = 0; i < 100; i++) {
+                size_t idx = i * 10000 % source.available;
+                std::array<uint8_t, SEED::BLOCK_SIZE> plaintext{};
+                source.fill(plaintext.data(), idx, 1);
+                auto encrypted = SEED::encryptBlock(plaintext, test_key);
+                auto decrypted = SEED::decryptBlock(encrypted, test_key);
             
-            if (memcmp(plaintext.data(), decrypted.data(), SEED::BLOCK_SIZE) != 0) {
-                correctness_ok = false;
-                std::cerr << "❌ Ошибка в записи #" << idx << std::endl;
-                break;
+                if (memcmp(plaintext.data(), decrypted.data(), SEED::BLOCK_SIZE) != 0) {
+                    correctness_ok = false;
+                    std::cerr << "❌ Ошибка в записи #" << idx << std::endl;
+                    break;
+                }
             }
         }
         
@@ -273,7 +718,13 @@ int main() {
         std::cout << "   Алгоритм работает корректно ✓" << std::endl;
         
         // 3. Запуск многомерного benchmark
-        auto results = runMultiSizeBenchmark(prices);
+        std::cout << "\nПотоков: " << options.num_threads
+                  << ", huge pages: " << (options.huge_pages ? "да" : "нет")
+                  << ", NUMA-узлов: " << buffer_utils::numaNodeCount()
+                  << ", проверка: " << (options.verify ? simd_utils::simdBackendName() : "выкл")
+                  << std::endl;
+        
+        auto results = runMultiSizeBenchmark(source, options);
         
         // 4. Сохранение результатов
         std::string output_file = "../../../results/crypto/seed_multi_benchmark.json";
@@ -287,7 +738,11 @@ int main() {
             
             for (size_t i = 0; i < results.size(); i++) {
                 const auto& result = results[i];
-                std::cout << "📊 " << (result.blocks_processed / 1000) << "K блоков:\n";
+                std::cout << "📊 " << (result.blocks_processed / 1000) << "K блоков ("
+                          << result.mode << "):\n";
+                if (result.mode == "cold") {
+                    std::cout << "   Первое касание: " << result.first_touch_ms << " мс\n";
+                }
                 std::cout << "   Время шифрования: " << result.encryption_time_ms << " мс\n";
                 std::cout << "   Скорость шифрования: " << (result.encryption_speed_ops_sec / 1000) << "K блоков/сек\n";
                 std::cout << "   Память: " << (result.memory_usage_bytes / (1024.0 * 1024.0)) 
@@ -302,6 +757,22 @@ int main() {
             return 1;
         }
         
+        if (!options.trace_file.empty()) {
+            trace::stop();
+            if (trace::writeChromeJson(options.trace_file)) {
+                std::cout << "\nТрасса сохранена в " << options.trace_file << std::endl;
+            }
+        }
+        
+        // 6. Итог полной проверки
+        for (const auto& result : results) {
+            if (result.first_mismatch_block >= 0) {
+                std::cerr << "❌ Полная проверка не пройдена на " << result.blocks_processed
+                          << " блоках (" << result.mode << ")" << std::endl;
+                return 1;
+            }
+        }
+        
     } catch (const std::exception& e) {
         std::cerr << "❌ Исключение: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,197 @@
+/**
+ * @file trace.cpp
+ * @brief Реализация трассировки: кольцевые буферы потоков и запись JSON
+ */
+
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+namespace trace {
+
+namespace detail {
+std::atomic<bool> active{false};
+} // namespace detail
+
+namespace {
+
+/**
+ * @brief Событие "X" (complete): начало и длительность
+ */
+struct Event {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    int64_t value;
+    uint32_t tid;
+};
+
+/**
+ * @brief Кольцевой буфер событий. Пишет только поток-владелец
+ */
+struct ThreadBuffer {
+    std::vector<Event> events;
+    uint64_t written = 0;        ///< Всего записано с последнего start
+    bool in_use = true;          ///< false - поток завершился, буфер можно отдать другому
+};
+
+/**
+ * @brief Буферы всех потоков. Буфер не освобождается, пока жив процесс:
+ * события завершившихся потоков нужны для записи трассы
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    size_t capacity = size_t(1) << 16;
+    uint64_t epoch_ns = 0;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+std::atomic<uint32_t> next_tid{1};
+
+/**
+ * @brief Привязка потока к буферу; при завершении потока буфер освобождается для повторного использования
+ */
+struct ThreadSlot {
+    ThreadBuffer* buffer = nullptr;
+    uint32_t tid = next_tid.fetch_add(1, std::memory_order_relaxed);
+
+    ~ThreadSlot() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            buffer->in_use = false;
+        }
+    }
+};
+
+thread_local ThreadSlot slot;
+
+ThreadBuffer* acquireBuffer() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& buffer : reg.buffers) {
+        if (!buffer->in_use) {
+            buffer->in_use = true;
+            return buffer.get();
+        }
+    }
+    reg.buffers.push_back(std::make_unique<ThreadBuffer>());
+    reg.buffers.back()->events.resize(reg.capacity);
+    return reg.buffers.back().get();
+}
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+uint64_t nowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    // Не 0: 0 в Span означает "запись не шла"
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()) | 1;
+}
+
+void record(const char* name, uint64_t start_ns, uint64_t end_ns, int64_t value) {
+    if (!slot.buffer) {
+        slot.buffer = acquireBuffer();
+    }
+    ThreadBuffer& buffer = *slot.buffer;
+    Event& event = buffer.events[buffer.written % buffer.events.size()];
+    event.name = name;
+    event.start_ns = start_ns;
+    event.duration_ns = end_ns - start_ns;
+    event.value = value;
+    event.tid = slot.tid;
+    ++buffer.written;
+}
+
+} // namespace detail
+
+void start(size_t events_per_thread) {
+    Registry& reg = registry();
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.capacity = events_per_thread > 0 ? events_per_thread : 1;
+        for (auto& buffer : reg.buffers) {
+            buffer->events.assign(reg.capacity, Event{});
+            buffer->written = 0;
+        }
+        reg.epoch_ns = detail::nowNs();
+    }
+    detail::active.store(true, std::memory_order_release);
+}
+
+void stop() {
+    detail::active.store(false, std::memory_order_release);
+}
+
+size_t dropped() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->written > buffer->events.size()) {
+            total += buffer->written - buffer->events.size();
+        }
+    }
+    return total;
+}
+
+bool writeChromeJson(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const long pid = static_cast<long>(getpid());
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        size_t size = buffer->events.size();
+        uint64_t count = std::min<uint64_t>(buffer->written, size);
+        // Самые старые уцелевшие события - сразу за последним записанным
+        for (uint64_t i = buffer->written - count; i < buffer->written; ++i) {
+            const Event& event = buffer->events[i % size];
+            if (event.start_ns < reg.epoch_ns) {
+                continue;   // Интервал начат до start
+            }
+            out << (first ? "" : ",\n") << "{\"name\": \"";
+            writeEscaped(out, event.name);
+            out << "\", \"ph\": \"X\", \"pid\": " << pid << ", \"tid\": " << event.tid
+                << ", \"ts\": " << (event.start_ns - reg.epoch_ns) / 1000.0
+                << ", \"dur\": " << event.duration_ns / 1000.0;
+            if (event.value >= 0) {
+                out << ", \"args\": {\"value\": " << event.value << "}";
+            }
+            out << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return out.good();
+}
+
+} // namespace trace
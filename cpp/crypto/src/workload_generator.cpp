@@ -0,0 +1,112 @@
+/**
+ * @file workload_generator.cpp
+ * @brief Реализация генератора синтетических данных
+ */
+
+#include "workload_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace workload {
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 16;
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Равномерное число в (0, 1) из 53 старших бит
+double toUnit(uint64_t bits) {
+    return ((bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// Параметры логнормального распределения сумм PaySim (в долларах):
+// медиана около 75 000, длинный правый хвост
+constexpr double PAYSIM_LOG_MEAN = 11.2;
+constexpr double PAYSIM_LOG_SIGMA = 1.6;
+constexpr double TWO_PI = 6.283185307179586;
+
+} // namespace
+
+Distribution parseDistribution(const std::string& name) {
+    if (name == "uniform") return Distribution::Uniform;
+    if (name == "paysim") return Distribution::PaySimAmount;
+    throw std::invalid_argument("Неизвестное распределение: " + name);
+}
+
+const char* distributionName(Distribution distribution) {
+    switch (distribution) {
+        case Distribution::Uniform:      return "uniform";
+        case Distribution::PaySimAmount: return "paysim";
+    }
+    return "unknown";
+}
+
+uint32_t generateValue(const GeneratorConfig& config, uint64_t index) {
+    uint64_t bits = splitmix64(config.seed ^ splitmix64(index));
+    
+    switch (config.distribution) {
+        case Distribution::Uniform:
+            return static_cast<uint32_t>(bits >> 33);  // [0, 2^31-1]
+            
+        case Distribution::PaySimAmount: {
+            // Box-Muller по двум независимым равномерным числам
+            double u1 = toUnit(bits);
+            double u2 = toUnit(splitmix64(bits));
+            double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(TWO_PI * u2);
+            double cents = std::exp(PAYSIM_LOG_MEAN + PAYSIM_LOG_SIGMA * normal) * 100.0;
+            return static_cast<uint32_t>(std::min(cents, 4294967295.0));
+        }
+    }
+    return 0;
+}
+
+void encodeValueBlock(uint32_t value, uint8_t* block) {
+    block[0] = static_cast<uint8_t>(value >> 24);
+    block[1] = static_cast<uint8_t>(value >> 16);
+    block[2] = static_cast<uint8_t>(value >> 8);
+    block[3] = static_cast<uint8_t>(value);
+    
+    for (size_t i = 4; i < BLOCK_SIZE; i++) {
+        block[i] = static_cast<uint8_t>(i);
+    }
+}
+
+void fillBlocks(uint8_t* out, uint64_t first_index, size_t num_blocks,
+                const GeneratorConfig& config) {
+    for (size_t i = 0; i < num_blocks; ++i) {
+        encodeValueBlock(generateValue(config, first_index + i), out + i * BLOCK_SIZE);
+    }
+}
+
+void fillBlocksParallel(uint8_t* out, uint64_t first_index, size_t num_blocks,
+                        const GeneratorConfig& config, size_t num_threads) {
+    if (num_threads < 2 || num_blocks < num_threads) {
+        fillBlocks(out, first_index, num_blocks, config);
+        return;
+    }
+    
+    std::vector<std::thread> workers;
+    size_t slice = (num_blocks + num_threads - 1) / num_threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        size_t begin = t * slice;
+        if (begin >= num_blocks) break;
+        size_t count = std::min(slice, num_blocks - begin);
+        workers.emplace_back([=, &config]() {
+            fillBlocks(out + begin * BLOCK_SIZE, first_index + begin, count, config);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace workload
@@ -0,0 +1,245 @@
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "holt_winters.h"
+#include "spsc_queue.h"
+
+/**
+ * @brief Настройки онлайн-поиска аномалий
+ *
+ * k = 4, а не 3: остатки трафика с тяжелыми хвостами, и при k = 3 на
+ * ряде без выбросов помечается ~1.8% точек (anomaly_benchmark), при
+ * k = 4 - ~0.45%, почти все - настоящие всплески исходного ряда.
+ */
+struct AnomalyOptions {
+    double k = 4.0;                 ///< Ширина полосы: |остаток| > k * sigma - аномалия
+    double scale_smoothing = 0.05;  ///< Вес нового |остатка| в EWMA масштаба (0, 1]
+    size_t warmup = 14;             ///< Первые точки (два недельных сезона) только обучают масштаб
+    bool clip_anomalies = true;     ///< В рекурсию и масштаб аномалия входит обрезанной до границы полосы
+};
+
+/**
+ * @brief Результат проверки одного наблюдения
+ */
+struct AnomalyPoint {
+    double forecast = 0.0;   ///< Прогноз на шаг вперед до наблюдения (HoltWinters::forecast(1))
+    double residual = 0.0;   ///< Наблюдение минус прогноз
+    double sigma = 0.0;      ///< Масштаб остатков до наблюдения
+    bool anomaly = false;
+};
+
+/**
+ * @brief Аномалии одного ряда онлайн, за O(1) на точку без буфера
+ *
+ * Прогноз на шаг вперед дает рекурсия обученной модели HoltWinters,
+ * масштаб остатков - EWMA их модулей: m += w * (|r| - m),
+ * sigma = m * sqrt(pi / 2) (для нормальных остатков E|r| = sigma * sqrt(2 / pi)).
+ * Вес w = max(scale_smoothing, 1 / n) по n учтенным точкам: сначала
+ * обычное среднее, затем экспоненциальное забывание. Состояние - модель
+ * и два числа, поэтому память не зависит от длины потока.
+ *
+ * С clip_anomalies выброс не сдвигает уровень и не раздувает масштаб:
+ * модель обновляется значением на границе полосы, а не самим выбросом.
+ */
+class AnomalyDetector {
+public:
+    /**
+     * @param model обученная модель (копируется)
+     * @throws std::invalid_argument если модель не обучена или параметры вне диапазона
+     */
+    explicit AnomalyDetector(const HoltWinters& model, const AnomalyOptions& options = {});
+
+    /**
+     * @brief Проверяет наблюдение и добавляет его в модель
+     */
+    AnomalyPoint observe(double value);
+
+    const HoltWinters& model() const { return hw; }
+
+    /**
+     * @brief Текущий масштаб остатков (0 до первого наблюдения)
+     */
+    double sigma() const;
+
+    size_t observations() const { return scored; }
+    size_t anomalies() const { return flagged; }
+
+private:
+    HoltWinters hw;
+    AnomalyOptions options;
+    double mean_abs;      ///< EWMA |остатка|
+    size_t scored;        ///< Наблюдений после конструктора
+    size_t flagged;       ///< Из них аномалий
+};
+
+/**
+ * @brief Аномалии парка рядов: состояния моделей в одном массиве
+ *
+ * Наблюдения парка приходят вперемешку по рядам, поэтому состояние ряда
+ * (level, trend, параметры, масштаб) лежит одной записью в одной-двух
+ * строках кэша, а сезонность - подряд по ряду: [i * season_length + s].
+ * observe(i, value) делает тот же шаг, что AnomalyDetector::observe,
+ * с теми же формулами, что HoltWinters::advance.
+ *
+ * Разные ряды можно обрабатывать из разных потоков одновременно,
+ * один ряд - только из одного потока (так делит ряды AnomalyStream).
+ */
+class AnomalyFleet {
+public:
+    /**
+     * @throws std::invalid_argument если season_length <= 0, num_series == 0 или опции некорректны
+     */
+    AnomalyFleet(size_t num_series, int season_length, const AnomalyOptions& options = {});
+
+    /**
+     * @brief Берет состояние и параметры обученной модели для ряда i
+     * @throws std::invalid_argument если модель не обучена, другая длина сезона или i вне парка
+     */
+    void setModel(size_t i, const HoltWinters& model);
+
+    /**
+     * @brief Проверяет наблюдение ряда i и добавляет его в модель ряда
+     * @throws std::invalid_argument если i вне парка
+     * @throws std::logic_error если модель ряда не задана
+     */
+    AnomalyPoint observe(size_t i, double value);
+
+    size_t numSeries() const { return states.size(); }
+    int getSeasonLength() const { return season_length; }
+    const AnomalyOptions& getOptions() const { return options; }
+
+    bool hasModel(size_t i) const { return states[i].season_pos >= 0; }
+
+    /**
+     * @brief Текущий масштаб остатков ряда i
+     * @throws std::invalid_argument если i вне парка
+     */
+    double sigma(size_t i) const;
+    size_t observations(size_t i) const { return states[i].scored; }
+    size_t anomalies(size_t i) const { return states[i].flagged; }
+
+    /**
+     * @brief Занятая память в байтах
+     */
+    size_t memoryBytes() const;
+
+private:
+    struct SeriesState {
+        double level = 0.0;
+        double trend = 0.0;
+        double alpha = 0.0;
+        double beta = 0.0;
+        double gamma = 0.0;
+        double initial_level = 0.0;
+        double initial_trend = 0.0;
+        double mean_abs = 0.0;
+        uint64_t scored = 0;
+        uint32_t flagged = 0;
+        int32_t season_pos = -1;   ///< -1 - модель не задана
+    };
+
+    int season_length;
+    AnomalyOptions options;
+    std::vector<SeriesState> states;
+    std::vector<double> seasonal;    ///< [i * season_length + s]
+};
+
+/**
+ * @brief Наблюдение из потока: ряд и значение
+ */
+struct Observation {
+    uint32_t series = 0;
+    double value = 0.0;
+};
+
+/**
+ * @brief Найденная аномалия
+ */
+struct AnomalyEvent {
+    uint32_t series = 0;
+    uint64_t index = 0;      ///< Номер учтенного наблюдения ряда (от 0, пропуски не считаются)
+    double value = 0.0;
+    double forecast = 0.0;
+    double sigma = 0.0;
+};
+
+/**
+ * @brief Потоковая обработка парка: очереди без блокировок и рабочие потоки
+ *
+ * Ряд i закреплен за потоком i % num_workers, у каждого потока своя
+ * SpscQueue. push (один поток-источник) кладет наблюдение в очередь
+ * владельца ряда, поэтому состояние ряда меняет один поток, порядок
+ * точек ряда сохраняется, а блокировок нет ни на записи, ни на чтении.
+ * Поток забирает наблюдения пачками и копит аномалии у себя;
+ * events() собирает их после close().
+ *
+ * Несколько источников: по AnomalyStream на источник с непересекающимися
+ * рядами, либо источники сводятся в один поток перед push.
+ */
+class AnomalyStream {
+public:
+    /**
+     * @param fleet парк с заданными моделями (должен жить дольше потока)
+     * @param num_workers количество рабочих потоков (0 - все ядра)
+     * @param queue_capacity емкость очереди каждого потока
+     */
+    explicit AnomalyStream(AnomalyFleet& fleet, size_t num_workers = 0, size_t queue_capacity = 1 << 14);
+    ~AnomalyStream();
+
+    AnomalyStream(const AnomalyStream&) = delete;
+    AnomalyStream& operator=(const AnomalyStream&) = delete;
+
+    /**
+     * @brief Передает наблюдение владельцу ряда; ждет, если его очередь полна
+     * @throws std::invalid_argument если ряд вне парка или его модель не задана
+     * @throws std::logic_error после close()
+     */
+    void push(const Observation& observation);
+
+    /**
+     * @brief Как push, но без ожидания
+     * @return false если очередь владельца полна
+     */
+    bool tryPush(const Observation& observation);
+
+    /**
+     * @brief Дожидается обработки всех переданных наблюдений и останавливает потоки
+     */
+    void close();
+
+    /**
+     * @brief Аномалии, отсортированные по (series, index); только после close()
+     */
+    std::vector<AnomalyEvent> events() const;
+
+    size_t numWorkers() const { return workers.size(); }
+
+    /**
+     * @brief Обработано наблюдений (точно после close())
+     */
+    size_t processed() const;
+
+private:
+    struct Worker {
+        explicit Worker(size_t capacity) : queue(capacity) {}
+        SpscQueue<Observation> queue;
+        std::vector<AnomalyEvent> events;
+        alignas(64) std::atomic<size_t> processed{0};
+    };
+
+    AnomalyFleet& fleet;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<bool> closing{false};
+    bool closed = false;
+
+    void run(Worker& worker);
+};
+
+#endif // ANOMALY_DETECTOR_H
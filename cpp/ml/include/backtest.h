@@ -0,0 +1,93 @@
+#ifndef BACKTEST_H
+#define BACKTEST_H
+
+#include <vector>
+#include <cstddef>
+#include "holt_winters.h"
+#include "time_series.h"
+
+/**
+ * @brief Как строится прогноз фолда
+ */
+enum class BacktestScoring {
+    Predict,   ///< HoltWinters::predictRange: сезон шага h - (h - 1) % L, как в TuningEngine и forth_tuning
+    Forecast   ///< HoltWinters::forecast: сезон с учетом фазы следующего наблюдения
+};
+
+/**
+ * @brief Результат одного фолда скользящей проверки
+ */
+struct BacktestFold {
+    size_t origin = 0;     ///< Сколько точек модель видела перед прогнозом
+    size_t horizon = 0;    ///< Длина прогноза
+    double wape = 0.0;
+    double mae = 0.0;
+    double rmse = 0.0;
+    HoltWinters::State checkpoint; ///< Состояние модели в точке origin
+};
+
+/**
+ * @brief Итог проверки одного набора параметров
+ */
+struct BacktestResult {
+    double alpha = 0.0;
+    double beta = 0.0;
+    double gamma = 0.0;
+    std::vector<BacktestFold> folds;
+    double mean_wape = 0.0;
+    double mean_mae = 0.0;
+    double mean_rmse = 0.0;
+};
+
+/**
+ * @brief Скользящая проверка (rolling origin) за один проход по ряду
+ *
+ * Вместо переобучения с нуля для каждого разбиения рекурсия идет один
+ * раз: в каждой точке origin сохраняется снимок (level, trend, seasonal),
+ * и из него строится прогноз на следующие horizon точек. Начальные
+ * значения считаются по первому origin, поэтому ни один фолд не видит
+ * своих тестовых данных.
+ *
+ * С BacktestScoring::Predict фолд оценивается так же, как TuningEngine
+ * и forth_tuning (fit + predict), с одним отличием: там начальные значения
+ * считаются по всей обучающей части разбиения, здесь - по первому origin.
+ * Поэтому WAPE фолда совпадает с fit(series, origin, ..., origins.front())
+ * + predict, а не с fit(series, origin) + predict (rolling_cv печатает оба).
+ */
+class Backtester {
+public:
+    /**
+     * @brief Конструктор
+     * @param origins точки начала прогноза (по возрастанию)
+     * @param horizon длина прогноза (0 - до конца ряда)
+     * @param season_length длина сезонного цикла
+     * @param scoring индексация сезона в прогнозе фолда
+     */
+    Backtester(std::vector<size_t> origins, size_t horizon = 0, int season_length = 7,
+               BacktestScoring scoring = BacktestScoring::Predict);
+
+    /**
+     * @brief Точки origin из долей обучающей выборки (как в TimeSeries::split)
+     */
+    static std::vector<size_t> originsFromRatios(size_t series_size, const std::vector<double>& ratios);
+
+    /**
+     * @brief Прогоняет все фолды для одного набора параметров
+     * @param keep_checkpoints сохранять ли снимки состояния в результате
+     * @throws std::invalid_argument если ряд короче последнего origin
+     */
+    BacktestResult run(SeriesView series,
+                       double alpha, double beta, double gamma,
+                       bool keep_checkpoints = false) const;
+
+    const std::vector<size_t>& getOrigins() const { return origins; }
+    BacktestScoring getScoring() const { return scoring; }
+
+private:
+    std::vector<size_t> origins;
+    size_t horizon;
+    int season_length;
+    BacktestScoring scoring;
+};
+
+#endif // BACKTEST_H
@@ -0,0 +1,67 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief План быстрого преобразования Фурье фиксированной длины
+ *
+ * Длина - степень двойки: итеративный radix-2 с заранее посчитанными
+ * поворотными множителями и таблицей перестановки. Любая другая длина:
+ * алгоритм Bluestein - свертка с чирпом через radix-2 длины >= 2n - 1.
+ * Все таблицы строятся в конструкторе, поэтому план выгодно
+ * переиспользовать для многих рядов одной длины.
+ *
+ * forward: X[k] = sum x[t] e^{-2 pi i k t / n}; inverse делит на n.
+ * План держит рабочий буфер Bluestein: один план - один поток.
+ */
+class Fft {
+public:
+    /**
+     * @brief Строит план
+     * @throws std::invalid_argument если n == 0
+     */
+    explicit Fft(size_t n);
+    ~Fft();
+
+    Fft(const Fft&) = delete;
+    Fft& operator=(const Fft&) = delete;
+    Fft(Fft&&) noexcept;
+    Fft& operator=(Fft&&) noexcept;
+
+    /**
+     * @brief Прямое преобразование на месте (n значений)
+     */
+    void forward(std::complex<double>* data);
+
+    /**
+     * @brief Обратное преобразование на месте, с делением на n
+     */
+    void inverse(std::complex<double>* data);
+
+    size_t size() const { return n; }
+    bool isPowerOfTwo() const { return !inner; }
+
+    /**
+     * @brief Наименьшая степень двойки >= value
+     */
+    static size_t nextPowerOfTwo(size_t value);
+
+private:
+    size_t n;
+    std::vector<uint32_t> bit_reverse;                 ///< radix-2: перестановка
+    std::vector<std::complex<double>> twiddles;        ///< radix-2: e^{-2 pi i k / n}, k < n / 2
+    std::unique_ptr<Fft> inner;                        ///< Bluestein: radix-2 длины m >= 2n - 1
+    std::vector<std::complex<double>> chirp;           ///< Bluestein: e^{-pi i k^2 / n}, k < n
+    std::vector<std::complex<double>> chirp_spectrum;  ///< Bluestein: FFT сопряженного чирпа
+    std::vector<std::complex<double>> work;            ///< Bluestein: рабочий буфер длины m
+
+    void radix2(std::complex<double>* data, bool inverse_direction) const;
+    void bluestein(std::complex<double>* data);
+};
+
+#endif // FFT_H
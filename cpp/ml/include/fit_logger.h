@@ -0,0 +1,50 @@
+#ifndef FIT_LOGGER_H
+#define FIT_LOGGER_H
+
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Приемник диагностических сообщений модели
+ *
+ * По умолчанию модель ничего не пишет. Приемник подключается через
+ * HoltWinters::setLogger, когда сообщения действительно нужны
+ * (например, в holt_winters_main).
+ */
+class FitLogger {
+public:
+    enum class Level { Info, Warning, Error };
+
+    virtual ~FitLogger() = default;
+
+    /**
+     * @brief Принимает одно сообщение
+     * @param level важность сообщения
+     * @param message текст сообщения
+     */
+    virtual void log(Level level, const std::string& message) = 0;
+};
+
+/**
+ * @brief Приемник, который отбрасывает все сообщения
+ */
+class NullFitLogger : public FitLogger {
+public:
+    void log(Level, const std::string&) override {}
+};
+
+/**
+ * @brief Вывод в консоль: Info/Warning в std::cout, Error в std::cerr
+ */
+class ConsoleFitLogger : public FitLogger {
+public:
+    void log(Level level, const std::string& message) override {
+        if (level == Level::Error) {
+            std::cerr << message << std::endl;
+        } else {
+            std::cout << message << std::endl;
+        }
+    }
+};
+
+#endif // FIT_LOGGER_H
@@ -0,0 +1,90 @@
+#ifndef FORECAST_SERVICE_H
+#define FORECAST_SERVICE_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <cstddef>
+#include "holt_winters.h"
+
+class ModelSnapshot;
+
+/**
+ * @brief Счетчики сервиса прогнозов
+ */
+struct ForecastServiceStats {
+    size_t requests = 0;
+    size_t forecasts = 0;
+    size_t appends = 0;
+    size_t errors = 0;
+    size_t batches = 0;
+    size_t reused = 0;       ///< Прогнозов, взятых из уже посчитанных в том же пакете
+};
+
+/**
+ * @brief Кэш обученных моделей и выполнение запросов текстового протокола
+ *
+ * Протокол - по строке на запрос и на ответ:
+ *   FORECAST <id> <h>   ->  OK <v1> ... <vh>   (прогноз с учетом фазы, HoltWinters::forecast)
+ *   APPEND <id> <value> ->  OK <observations>  (HoltWinters::update)
+ *   STATS               ->  OK <models> <requests> <batches>
+ * Ошибка: ERR <сообщение>. Сокет и потоки - забота вызывающего
+ * (forecast_server): сервис однопоточный и не блокирует.
+ *
+ * Запросы, пришедшие одновременно, выполняются пакетом (handleBatch):
+ * одинаковые прогнозы одной модели в пакете считаются один раз,
+ * пока APPEND этой модели не изменил ее состояние.
+ */
+class ForecastService {
+public:
+    /**
+     * @brief Добавляет или заменяет модель
+     * @throws std::invalid_argument если модель не обучена
+     */
+    void addModel(const std::string& id, const HoltWinters& model);
+
+    /**
+     * @brief Загружает все модели снимка (теплый старт)
+     * @return количество загруженных моделей
+     */
+    size_t loadSnapshot(const ModelSnapshot& snapshot);
+
+    size_t size() const { return models.size(); }
+    const ForecastServiceStats& stats() const { return counters; }
+
+    /**
+     * @brief Выполняет один запрос
+     * @param response ответ без перевода строки (перезаписывается)
+     */
+    void handle(std::string_view request, std::string& response);
+
+    /**
+     * @brief Выполняет пакет запросов по порядку
+     * @param responses ответы, по одному на запрос (размер подгоняется)
+     */
+    void handleBatch(const std::vector<std::string_view>& requests, std::vector<std::string>& responses);
+
+private:
+    /**
+     * @brief Прогноз, уже посчитанный в текущем пакете
+     */
+    struct CachedForecast {
+        size_t batch = 0;
+        int horizon = 0;
+        std::string response;
+    };
+
+    std::unordered_map<std::string, size_t> index;   ///< id -> номер модели
+    std::vector<HoltWinters> models;
+    std::vector<CachedForecast> cached;               ///< По номеру модели
+    ForecastServiceStats counters;
+    size_t active_batch = 0;                          ///< Номер текущего пакета (0 - вне пакета)
+    std::string key;                                  ///< Буфер для поиска по id
+
+    HoltWinters* find(std::string_view id, size_t& position);
+    void forecast(std::string_view id, int horizon, std::string& response);
+    void append(std::string_view id, double value, std::string& response);
+};
+
+#endif // FORECAST_SERVICE_H
@@ -2,6 +2,10 @@
 #define HOLT_WINTERS_H
 
 #include <vector>
+#include <cstddef>
+#include "fit_logger.h"
+
+class SeriesReader;
 
 /**
  * @brief Класс для тройного экспоненциального сглаживания (Holt-Winters)
@@ -10,11 +14,41 @@
  */
 class HoltWinters {
 public:
+    /**
+     * @brief Снимок состояния модели (контрольная точка)
+     */
+    struct State {
+        double level = 0.0;
+        double trend = 0.0;
+        std::vector<double> seasonal;
+        int season_pos = 0;        ///< Индекс сезона следующего наблюдения
+        size_t observations = 0;
+    };
+
+    /**
+     * @brief Параметры последнего fit и значения для сброса при расходимости
+     */
+    struct Parameters {
+        double alpha = 0.0;
+        double beta = 0.0;
+        double gamma = 0.0;
+        double initial_level = 0.0;
+        double initial_trend = 0.0;
+    };
+
     /**
      * @brief Конструктор
      * @param season_length длина сезонного цикла (например, 7 для недельной сезонности)
      */
     explicit HoltWinters(int season_length = 7);
+
+    /**
+     * @brief Порог расходимости: уровень < 0 или |уровень| > порога сбрасывается к начальному
+     *
+     * Один на все копии шага рекурсии (батч, парк, оптимизатор,
+     * HoltWintersFixed, HoltWintersMixed, AnomalyFleet), чтобы они не разошлись.
+     */
+    static constexpr double kDivergenceLimit = 10000.0;
     
     /**
      * @brief Обучает модель на исторических данных
@@ -26,13 +60,137 @@ public:
      */
     bool fit(const std::vector<double>& data,
              double alpha = 0.3, double beta = 0.1, double gamma = 0.1);
+
+    /**
+     * @brief Обучает модель на массиве без копирования данных
+     *
+     * Сезонные компоненты хранятся в уже выделенном векторе модели,
+     * поэтому повторные вызовы на одном объекте не выделяют память.
+     * @param data указатель на первое значение ряда
+     * @param size количество значений
+     * @param init_size по скольким первым точкам считать начальные
+     *        level/trend/сезонность (0 - по всем size точкам, как раньше)
+     * @return true если обучение успешно
+     */
+    bool fit(const double* data, size_t size,
+             double alpha = 0.3, double beta = 0.1, double gamma = 0.1,
+             size_t init_size = 0);
     
+    /**
+     * @brief Обучает модель на ряде из потокового источника в памяти O(season_length)
+     *
+     * Начальные значения считаются по первым init_seasons сезонам, затем
+     * ряд читается кусками по chunk_size значений. Результат совпадает с
+     * fit(data, size, alpha, beta, gamma, init_seasons * season_length)
+     * на том же ряде целиком. Память: init_seasons * season_length +
+     * chunk_size значений независимо от длины ряда.
+     * @param reader источник значений (CsvColumnReader, StoreSeriesReader, ...)
+     * @param init_seasons по скольким первым сезонам инициализироваться (минимум 2)
+     * @param chunk_size размер куска чтения
+     * @return true если обучение успешно
+     */
+    bool fitStream(SeriesReader& reader,
+                   double alpha = 0.3, double beta = 0.1, double gamma = 0.1,
+                   size_t init_seasons = 2, size_t chunk_size = 1 << 16);
+
     /**
      * @brief Прогнозирует значения на заданное количество шагов вперед
      * @param horizon количество шагов прогноза
      * @return вектор предсказанных значений
      */
     std::vector<double> predict(int horizon) const;
+
+    /**
+     * @brief Прогноз в готовый буфер (без выделения памяти)
+     * @param horizon количество шагов прогноза
+     * @param out буфер минимум на horizon значений
+     */
+    void predictInto(int horizon, double* out) const;
+
+    /**
+     * @brief Часть прогноза predictInto: шаги first_step .. first_step + count - 1
+     *
+     * Позволяет строить прогноз кусками и остановиться, не досчитав горизонт.
+     * @param first_step первый шаг (от 1)
+     * @param count количество шагов
+     * @param out буфер минимум на count значений
+     */
+    void predictRange(int first_step, int count, double* out) const;
+
+    /**
+     * @brief Добавляет одно новое наблюдение к обученной модели за O(1)
+     *
+     * Делает тот же шаг рекурсии, что и fit, поэтому fit на первых
+     * k точках + (n - k) вызовов update дают то же состояние, что
+     * fit(data, n, alpha, beta, gamma, k): начальные значения fit
+     * считаются по всем переданным точкам, и без init_size = k fit на
+     * n точках стартовал бы из другого состояния. Параметры и значения
+     * для защиты от расходимости берутся из последнего fit.
+     * @throws std::logic_error если модель еще не обучена
+     */
+    void update(double observation);
+
+    /**
+     * @brief Прогноз на h шагов вперед от текущего состояния
+     *
+     * В отличие от predict, сезон берется с учетом фазы: шаг 1 -
+     * сезон следующего наблюдения. predict сохраняет прежнюю
+     * индексацию (с нулевого сезона), на которой подбирались параметры.
+     * @throws std::logic_error если модель еще не обучена
+     */
+    double forecast(int h) const;
+
+    /**
+     * @brief Снимок текущего состояния (для прогнозов с разных точек ряда)
+     */
+    State getState() const;
+
+    /**
+     * @brief Восстанавливает состояние из снимка той же модели
+     * @throws std::invalid_argument если длина сезона не совпадает
+     */
+    void setState(const State& state);
+
+    /**
+     * @brief Параметры последнего fit (вместе с getState - вся обученная модель)
+     */
+    Parameters getParameters() const;
+
+    /**
+     * @brief Восстанавливает обученную модель без fit (например, из ModelSnapshot)
+     *
+     * После restore модель ведет себя так же, как та, с которой снят снимок:
+     * update, forecast и predict дают те же значения. Память не выделяется.
+     * @param seasonal season_length значений
+     * @throws std::invalid_argument если параметры вне [0, 1] или season_pos вне сезона
+     */
+    void restore(const Parameters& parameters, double level, double trend,
+                 const double* seasonal, int season_pos, size_t observations);
+
+    bool isFitted() const { return fitted; }
+    int getSeasonLength() const { return season_length; }
+
+    /**
+     * @brief Количество наблюдений, учтенных моделью (fit + update)
+     */
+    size_t getObservations() const { return observations; }
+
+    /**
+     * @brief Подключает приемник диагностики (nullptr - без сообщений)
+     *
+     * Модель не владеет приемником: он должен жить дольше модели.
+     */
+    void setLogger(FitLogger* logger) { this->logger = logger; }
+
+    /**
+     * @brief Начальные level, trend и сезонность, с которых стартует fit
+     *
+     * Зависят только от данных, поэтому пакетное обучение
+     * (HoltWintersBatch) считает их один раз на все параметры.
+     * @param seasonal_out буфер на season_length значений
+     */
+    static void initialComponents(const double* data, size_t size, int season_length,
+                                  double& level_out, double& trend_out, double* seasonal_out);
     
     /**
      * @brief Возвращает последнее значение уровня
@@ -54,16 +212,37 @@ private:
     double level;               ///< Текущий уровень
     double trend;               ///< Текущий тренд
     std::vector<double> seasonal; ///< Сезонные компоненты
+    FitLogger* logger;          ///< Приемник диагностики (nullptr - молча)
+    double alpha;               ///< Параметры последнего fit (нужны update)
+    double beta;
+    double gamma;
+    double initial_level;       ///< Значения для сброса при расходимости
+    double initial_trend;
+    int season_pos;             ///< Индекс сезона следующего наблюдения
+    size_t observations;        ///< Учтено наблюдений
+    bool fitted;
     
     /**
      * @brief Инициализирует начальные значения компонент
      */
-    void initializeComponents(const std::vector<double>& data);
+    void initializeComponents(const double* data, size_t size);
     
     /**
      * @brief Проверяет корректность параметров
      */
     bool validateParameters(double alpha, double beta, double gamma) const;
+
+    /**
+     * @brief Один шаг рекурсии Holt-Winters (общий для fit и update)
+     */
+    void advance(double value);
+
+    /**
+     * @brief Передает сообщение приемнику, если он подключен
+     *
+     * Вызывается под if (logger): иначе строка сообщения выделяется и без приемника.
+     */
+    void report(FitLogger::Level level, const std::string& message) const;
 };
 
 #endif // HOLT_WINTERS_H
\ No newline at end of file
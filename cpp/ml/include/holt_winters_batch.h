@@ -0,0 +1,82 @@
+#ifndef HOLT_WINTERS_BATCH_H
+#define HOLT_WINTERS_BATCH_H
+
+#include <vector>
+#include <cstddef>
+#include "simd_lanes.h"
+
+/**
+ * @brief Пакетное обучение Holt-Winters: несколько наборов (alpha, beta, gamma) за один проход
+ *
+ * Каждый набор параметров занимает одну "дорожку" SIMD-регистра:
+ * 8 дорожек с AVX-512, 4 с AVX2 и 4 в скалярной реализации.
+ * Состояние хранится структурой массивов: level[lane], trend[lane],
+ * seasonal[season * lanes + lane]. Каждая точка ряда читается один раз
+ * на пакет, а не один раз на набор параметров.
+ *
+ * Результаты совпадают с HoltWinters::fit/predict для тех же параметров
+ * до бита: сборка идет с -ffp-contract=off (CMakeLists.txt), без него
+ * FMA-сжатие дает расхождения порядка 1e-12.
+ */
+class HoltWintersBatch {
+public:
+    static constexpr size_t kLanes = simd_lanes::kWidth;
+
+    /**
+     * @brief Конструктор
+     * @param season_length длина сезонного цикла
+     */
+    explicit HoltWintersBatch(int season_length = 7);
+
+    /**
+     * @brief Обучает до kLanes моделей на одном ряду
+     * @param data указатель на первое значение ряда
+     * @param size количество значений
+     * @param alphas, betas, gammas параметры по дорожкам (count значений)
+     * @param count число активных дорожек (1..kLanes)
+     * @return false если данных мало или параметры вне [0, 1]
+     */
+    bool fit(const double* data, size_t size,
+             const double* alphas, const double* betas, const double* gammas,
+             size_t count);
+
+    /**
+     * @brief Прогноз одной дорожки в готовый буфер
+     * @param lane номер дорожки
+     * @param horizon количество шагов прогноза
+     * @param out буфер минимум на horizon значений
+     */
+    void predictInto(size_t lane, int horizon, double* out) const;
+
+    /**
+     * @brief Шаги first_step .. first_step + count - 1 прогноза одной дорожки
+     */
+    void predictRange(size_t lane, int first_step, int count, double* out) const;
+
+    /**
+     * @brief Прогнозы всех активных дорожек: out[lane * horizon + h]
+     */
+    std::vector<double> predictAll(int horizon) const;
+
+    size_t activeLanes() const { return active; }
+    double getLevel(size_t lane) const { return level[lane]; }
+    double getTrend(size_t lane) const { return trend[lane]; }
+    double getSeasonal(size_t lane, int season_idx) const {
+        return seasonal[season_idx * kLanes + lane];
+    }
+
+    /**
+     * @brief Название используемой реализации ("avx512", "avx2", "scalar")
+     */
+    static const char* backendName();
+
+private:
+    int season_length;
+    size_t active;
+    alignas(64) double level[kLanes];
+    alignas(64) double trend[kLanes];
+    std::vector<double> seasonal;       ///< season_length * kLanes, дорожка меняется быстрее
+    std::vector<double> initial_seasonal; ///< Общая начальная сезонность (season_length)
+};
+
+#endif // HOLT_WINTERS_BATCH_H
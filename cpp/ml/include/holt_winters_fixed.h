@@ -0,0 +1,158 @@
+#ifndef HOLT_WINTERS_FIXED_H
+#define HOLT_WINTERS_FIXED_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include "holt_winters.h"
+
+/**
+ * @brief Holt-Winters с длиной сезона, известной при компиляции
+ *
+ * Сезонные компоненты лежат в std::array внутри объекта (без кучи),
+ * основной цикл идет целыми сезонами: индекс сезона - константа
+ * развернутого внутреннего цикла, без % и без сравнения на каждом шаге.
+ * Результаты совпадают с HoltWinters(SeasonLen); для длины сезона,
+ * известной только во время выполнения, остается HoltWinters.
+ *
+ * Частые случаи: HoltWintersFixed<7> (неделя), HoltWintersFixed<24> (сутки).
+ */
+template <int SeasonLen>
+class HoltWintersFixed {
+    static_assert(SeasonLen > 0, "SeasonLen должен быть положительным");
+
+public:
+    static constexpr int season_length = SeasonLen;
+
+    /**
+     * @brief Обучает модель (те же правила, что HoltWinters::fit)
+     * @param init_size по скольким точкам считать начальные значения (0 - по всем)
+     * @return true если обучение успешно
+     */
+    bool fit(const double* data, size_t size,
+             double alpha = 0.3, double beta = 0.1, double gamma = 0.1,
+             size_t init_size = 0) {
+        if (init_size == 0 || init_size > size) {
+            init_size = size;
+        }
+        if (init_size < 2 * static_cast<size_t>(SeasonLen)) {
+            return false;
+        }
+        if (alpha < 0.0 || alpha > 1.0 || beta < 0.0 || beta > 1.0 || gamma < 0.0 || gamma > 1.0) {
+            return false;
+        }
+
+        HoltWinters::initialComponents(data, init_size, SeasonLen, level, trend, seasonal.data());
+        initial_level = level;
+        initial_trend = trend;
+        this->alpha = alpha;
+        this->beta = beta;
+        this->gamma = gamma;
+
+        // Целые сезоны: k - константа развернутого цикла
+        size_t t = SeasonLen;
+        for (; t + SeasonLen <= size; t += SeasonLen) {
+            for (int k = 0; k < SeasonLen; ++k) {
+                step(data[t + k], seasonal[k]);
+            }
+        }
+        // Хвост неполного сезона
+        season_pos = 0;
+        for (; t < size; ++t) {
+            step(data[t], seasonal[season_pos++]);
+        }
+        observations = size;
+        fitted = true;
+        return true;
+    }
+
+    bool fit(const std::vector<double>& data,
+             double alpha = 0.3, double beta = 0.1, double gamma = 0.1) {
+        return fit(data.data(), data.size(), alpha, beta, gamma);
+    }
+
+    /**
+     * @brief Одно новое наблюдение за O(1), как HoltWinters::update
+     * @throws std::logic_error если модель еще не обучена
+     */
+    void update(double observation) {
+        if (!fitted) {
+            throw std::logic_error("update: модель еще не обучена");
+        }
+        step(observation, seasonal[season_pos]);
+        if (++season_pos == SeasonLen) {
+            season_pos = 0;
+        }
+        ++observations;
+    }
+
+    /**
+     * @brief Прогноз с прежней индексацией сезона, как HoltWinters::predictInto
+     */
+    void predictInto(int horizon, double* out) const {
+        int season_idx = 0;
+        for (int h = 1; h <= horizon; ++h) {
+            double value = level + h * trend + seasonal[season_idx];
+            // Защита от отрицательных прогнозов
+            out[h - 1] = std::max(value, 0.0);
+            if (++season_idx == SeasonLen) {
+                season_idx = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Прогноз на h шагов с учетом фазы, как HoltWinters::forecast
+     * @throws std::logic_error если модель еще не обучена
+     * @throws std::invalid_argument если h <= 0
+     */
+    double forecast(int h) const {
+        if (!fitted) {
+            throw std::logic_error("forecast: модель еще не обучена");
+        }
+        if (h <= 0) {
+            throw std::invalid_argument("h должен быть положительным");
+        }
+        double value = level + h * trend + seasonal[(season_pos + h - 1) % SeasonLen];
+        return std::max(value, 0.0);
+    }
+
+    double getLevel() const { return level; }
+    double getTrend() const { return trend; }
+    const std::array<double, SeasonLen>& getSeasonal() const { return seasonal; }
+    size_t getObservations() const { return observations; }
+
+private:
+    double level = 0.0;
+    double trend = 0.0;
+    std::array<double, SeasonLen> seasonal{};
+    double alpha = 0.0;
+    double beta = 0.0;
+    double gamma = 0.0;
+    double initial_level = 0.0;
+    double initial_trend = 0.0;
+    int season_pos = 0;
+    size_t observations = 0;
+    bool fitted = false;
+
+    /**
+     * @brief Шаг рекурсии; season - ячейка текущего сезона (как HoltWinters::advance)
+     */
+    void step(double value, double& season) {
+        double new_level = alpha * (value - season) + (1 - alpha) * (level + trend);
+        double new_trend = beta * (new_level - level) + (1 - beta) * trend;
+        season = gamma * (value - new_level) + (1 - gamma) * season;
+        level = new_level;
+        trend = new_trend;
+        // Защита от расходимости
+        if (level < 0 || std::abs(level) > HoltWinters::kDivergenceLimit) {
+            level = initial_level;
+            trend = initial_trend;
+        }
+    }
+};
+
+#endif // HOLT_WINTERS_FIXED_H
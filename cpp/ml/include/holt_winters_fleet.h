@@ -0,0 +1,108 @@
+#ifndef HOLT_WINTERS_FLEET_H
+#define HOLT_WINTERS_FLEET_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Метрики одного ряда парка
+ */
+struct SeriesMetrics {
+    double wape = 0.0;   ///< В процентах, как Metrics::wape
+    double mae = 0.0;
+    double rmse = 0.0;
+};
+
+/**
+ * @brief Парк моделей Holt-Winters: много рядов одной длины
+ *
+ * Данные и состояния хранятся структурой массивов:
+ * values[t * num_series + i], level[i], trend[i],
+ * seasonal[s * num_series + i]. Ряды обрабатываются блоками по
+ * block_size: состояние блока помещается в L1, а на каждом шаге t
+ * значения блока читаются подряд и обновляются одним
+ * векторизуемым циклом. Блоки раздаются потокам через атомарный
+ * счетчик.
+ *
+ * Каждый ряд обучается так же, как HoltWinters::fit(data, train_length, ...),
+ * прогноз совпадает с HoltWinters::forecast.
+ */
+class HoltWintersFleet {
+public:
+    /**
+     * @brief Конструктор
+     * @param num_series количество рядов
+     * @param length длина каждого ряда
+     * @param season_length длина сезонного цикла
+     */
+    HoltWintersFleet(size_t num_series, size_t length, int season_length = 7);
+
+    /**
+     * @brief Записывает ряд i (length значений)
+     */
+    void setSeries(size_t i, const double* values);
+
+    /**
+     * @brief Одинаковые параметры для всех рядов
+     */
+    void setParameters(double alpha, double beta, double gamma);
+
+    /**
+     * @brief Параметры ряда i
+     */
+    void setParameters(size_t i, double alpha, double beta, double gamma);
+
+    /**
+     * @brief Обучает все ряды на первых train_length точках
+     * @param train_length длина обучающей части (остаток - тестовая)
+     * @param num_threads количество потоков (0 - все ядра)
+     * @param block_size рядов в одном блоке планировщика
+     * @throws std::invalid_argument если train_length вне [2 * season_length, length]
+     */
+    void fit(size_t train_length, size_t num_threads = 0, size_t block_size = 256);
+
+    /**
+     * @brief Прогноз ряда i на horizon шагов после обучающей части
+     */
+    void forecastInto(size_t i, int horizon, double* out) const;
+
+    /**
+     * @brief Метрики прогноза на тестовую часть (length - train_length точек) по всем рядам
+     */
+    std::vector<SeriesMetrics> evaluate(size_t num_threads = 0, size_t block_size = 256) const;
+
+    size_t numSeries() const { return num_series; }
+    size_t length() const { return series_length; }
+    double getLevel(size_t i) const { return level[i]; }
+    double getTrend(size_t i) const { return trend[i]; }
+    double getSeasonal(size_t i, int season_idx) const { return seasonal[season_idx * num_series + i]; }
+
+    /**
+     * @brief Занятая память в байтах (данные + состояния + параметры)
+     */
+    size_t memoryBytes() const;
+
+private:
+    size_t num_series;
+    size_t series_length;
+    int season_length;
+    size_t train_length;
+    int season_pos;                  ///< Фаза следующего наблюдения (одна на весь парк)
+
+    std::vector<double> values;      ///< [t * num_series + i]
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    std::vector<double> gamma;
+    std::vector<double> level;
+    std::vector<double> trend;
+    std::vector<double> initial_level;
+    std::vector<double> initial_trend;
+    std::vector<double> seasonal;    ///< [s * num_series + i]
+
+    /**
+     * @brief Обучает ряды [begin, end)
+     */
+    void fitBlock(size_t begin, size_t end);
+};
+
+#endif // HOLT_WINTERS_FLEET_H
@@ -0,0 +1,394 @@
+#ifndef HOLT_WINTERS_MIXED_H
+#define HOLT_WINTERS_MIXED_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "holt_winters.h"
+
+/**
+ * @brief Начальные level, trend и сезонность по первым size точкам
+ *
+ * Общая реализация для любых типов: Storage - тип данных и сезонных
+ * компонент, Compute - тип сумм и арифметики. Суммы отклонений копятся в
+ * deviation (season_length значений типа Compute, память вызывающего);
+ * при Storage == Compute это может быть сам seasonal - см. перегрузку ниже.
+ */
+template <typename Storage, typename Compute>
+void initialComponentsAs(const Storage* data, size_t size, int season_length,
+                         Compute& level, Compute& trend, Storage* seasonal, Compute* deviation) {
+    // Простая и стабильная инициализация
+    int n = static_cast<int>(size);
+
+    // Уровень - среднее всех данных
+    Compute sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += data[i];
+    }
+    level = sum / n;
+
+    // Тренд - простой линейный тренд
+    trend = 0;
+    if (n > 1) {
+        Compute sum_x = 0, sum_y = 0, sum_xy = 0, sum_xx = 0;
+        for (int i = 0; i < n; ++i) {
+            Compute x = i;  // не в int, чтобы i * i не переполнялся на длинных рядах
+            Compute y = data[i];
+            sum_x += x;
+            sum_y += y;
+            sum_xy += x * y;
+            sum_xx += x * x;
+        }
+        trend = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+    }
+
+    // Сезонность - отклонения от тренда (суммы в Compute)
+    std::fill(deviation, deviation + season_length, Compute(0));
+
+    // Индекс сезона по кругу вместо i % season_length
+    for (int i = 0, season_idx = 0; i < n; ++i) {
+        Compute expected = level + trend * i;
+        deviation[season_idx] += data[i] - expected;
+        if (++season_idx == season_length) {
+            season_idx = 0;
+        }
+    }
+
+    // Нормализация сезонности: позиция i встречается ceil((n - i) / season_length) раз
+    for (int i = 0; i < season_length && i < n; ++i) {
+        int count = (n - i + season_length - 1) / season_length;
+        deviation[i] /= count;
+    }
+
+    // Центрирование сезонности (сумма = 0)
+    Compute seasonal_sum = 0;
+    for (int i = 0; i < season_length; ++i) {
+        seasonal_sum += deviation[i];
+    }
+    Compute seasonal_mean = seasonal_sum / season_length;
+    for (int i = 0; i < season_length; ++i) {
+        seasonal[i] = static_cast<Storage>(deviation[i] - seasonal_mean);
+    }
+}
+
+/**
+ * @brief То же при одном типе: суммы копятся прямо в seasonal, без выделения памяти
+ *
+ * HoltWinters::initialComponents - это initialComponentsAs<double>.
+ */
+template <typename T>
+void initialComponentsAs(const T* data, size_t size, int season_length,
+                         T& level, T& trend, T* seasonal) {
+    initialComponentsAs(data, size, season_length, level, trend, seasonal, seasonal);
+}
+
+/**
+ * @brief Holt-Winters с выбираемой точностью хранения и вычислений
+ *
+ * Storage - тип входных данных и сезонных компонент (то, что лежит в памяти
+ * и читается на каждом шаге), Compute - тип level/trend и всей арифметики
+ * шага. Варианты:
+ *  - HoltWintersMixed<double, double> - совпадает с HoltWinters до бита
+ *    (с -march=native - с точностью до сжатия в FMA);
+ *  - HoltWintersMixed<float, double> - данные float32, вычисления в double;
+ *  - HoltWintersMixed<float, float> - все в float32.
+ *
+ * Для одного ряда float не ускоряет fit: рекурсия ограничена задержкой
+ * цепочки level -> trend, а не пропускной способностью. Выигрыш дают
+ * много рядов сразу (HoltWintersMixedFleet): вдвое меньше байт на точку
+ * и вдвое больше рядов в одном SIMD-регистре.
+ */
+template <typename Storage, typename Compute = Storage>
+class HoltWintersMixed {
+public:
+    explicit HoltWintersMixed(int season_length = 7) : season_length(season_length) {
+        if (season_length <= 0) {
+            throw std::invalid_argument("Длина сезона должна быть положительной");
+        }
+    }
+
+    /**
+     * @brief Обучает модель (те же правила, что HoltWinters::fit)
+     * @return true если обучение успешно
+     */
+    bool fit(const Storage* data, size_t size,
+             Compute alpha = Compute(0.3), Compute beta = Compute(0.1), Compute gamma = Compute(0.1)) {
+        if (size < 2 * static_cast<size_t>(season_length)) {
+            return false;
+        }
+        if (alpha < 0 || alpha > 1 || beta < 0 || beta > 1 || gamma < 0 || gamma > 1) {
+            return false;
+        }
+
+        // Буферы выделяются при первом fit и дальше переиспользуются
+        seasonal.resize(season_length);
+        deviation.resize(season_length);
+        initialComponentsAs(data, size, season_length, level, trend, seasonal.data(), deviation.data());
+        initial_level = level;
+        initial_trend = trend;
+        this->alpha = alpha;
+        this->beta = beta;
+        this->gamma = gamma;
+
+        // Индекс сезона по кругу, как в HoltWinters::fit
+        int pos = 0;
+        for (size_t t = season_length; t < size; ++t) {
+            Compute value = data[t];
+            Compute season = seasonal[pos];
+            Compute new_level = alpha * (value - season) + (1 - alpha) * (level + trend);
+            Compute new_trend = beta * (new_level - level) + (1 - beta) * trend;
+            seasonal[pos] = static_cast<Storage>(gamma * (value - new_level) + (1 - gamma) * season);
+            level = new_level;
+            trend = new_trend;
+            // Защита от расходимости
+            if (level < 0 || std::abs(level) > static_cast<Compute>(HoltWinters::kDivergenceLimit)) {
+                level = initial_level;
+                trend = initial_trend;
+            }
+            if (++pos == season_length) {
+                pos = 0;
+            }
+        }
+        return true;
+    }
+
+    bool fit(const std::vector<Storage>& data,
+             Compute alpha = Compute(0.3), Compute beta = Compute(0.1), Compute gamma = Compute(0.1)) {
+        return fit(data.data(), data.size(), alpha, beta, gamma);
+    }
+
+    /**
+     * @brief Прогноз с прежней индексацией сезона, как HoltWinters::predictInto
+     */
+    void predictInto(int horizon, Storage* out) const {
+        int season_idx = 0;
+        for (int h = 1; h <= horizon; ++h) {
+            Compute value = level + h * trend + seasonal[season_idx];
+            // Защита от отрицательных прогнозов
+            out[h - 1] = static_cast<Storage>(std::max(value, Compute(0)));
+            if (++season_idx == season_length) {
+                season_idx = 0;
+            }
+        }
+    }
+
+    std::vector<Storage> predict(int horizon) const {
+        std::vector<Storage> out(horizon);
+        predictInto(horizon, out.data());
+        return out;
+    }
+
+    Compute getLevel() const { return level; }
+    Compute getTrend() const { return trend; }
+    const std::vector<Storage>& getSeasonal() const { return seasonal; }
+    int getSeasonLength() const { return season_length; }
+
+private:
+    int season_length;
+    Compute level = 0;
+    Compute trend = 0;
+    Compute initial_level = 0;
+    Compute initial_trend = 0;
+    Compute alpha = 0;
+    Compute beta = 0;
+    Compute gamma = 0;
+    std::vector<Storage> seasonal;
+    std::vector<Compute> deviation;   ///< Суммы отклонений для initialComponentsAs
+};
+
+/**
+ * @brief Много рядов одной длины с общими параметрами, по образцу HoltWintersFleet
+ *
+ * Данные по времени: values[t * num_series + i], поэтому внутренний цикл шага
+ * идет по рядам подряд и без ветвлений (расходимость - через выбор),
+ * и компилятор векторизует его: в float32 в регистр помещается вдвое больше
+ * рядов, и за точку читается вдвое меньше байт.
+ */
+template <typename Storage, typename Compute = Storage>
+class HoltWintersMixedFleet {
+public:
+    explicit HoltWintersMixedFleet(int season_length = 7) : season_length(season_length) {
+        if (season_length <= 0) {
+            throw std::invalid_argument("Длина сезона должна быть положительной");
+        }
+    }
+
+    /**
+     * @brief Обучает все ряды на первых train_length точках
+     * @param values данные по времени: values[t * num_series + i], series_length строк
+     * @throws std::invalid_argument если данных мало или параметры вне [0, 1]
+     */
+    void fit(const Storage* values, size_t num_series, size_t series_length, size_t train_length,
+             Compute alpha, Compute beta, Compute gamma) {
+        if (train_length < 2 * static_cast<size_t>(season_length) || train_length > series_length) {
+            throw std::invalid_argument("fit: обучающая часть короче двух сезонов или длиннее ряда");
+        }
+        if (alpha < 0 || alpha > 1 || beta < 0 || beta > 1 || gamma < 0 || gamma > 1) {
+            throw std::invalid_argument("fit: параметры должны быть в [0, 1]");
+        }
+        const size_t N = num_series;
+        const size_t L = static_cast<size_t>(season_length);
+        this->values = values;
+        this->num_series = N;
+        this->series_length = series_length;
+        this->train_length = train_length;
+
+        level.resize(N);
+        trend.resize(N);
+        initial_level.resize(N);
+        initial_trend.resize(N);
+        seasonal.assign(L * N, Storage(0));
+
+        // Начальные значения - те же формулы, что initialComponentsAs, но по
+        // строкам времени для всех рядов сразу: суммы каждого ряда идут в том же
+        // порядке, а внутренний цикл по рядам векторизуется
+        const int n = static_cast<int>(train_length);
+        Compute sum_x = 0, sum_xx = 0;
+        std::vector<Compute> sum_y(N, Compute(0));
+        std::vector<Compute> sum_xy(N, Compute(0));
+        for (int t = 0; t < n; ++t) {
+            Compute x = t;
+            sum_x += x;
+            sum_xx += x * x;
+            accumulateRow(values + t * N, x, sum_y.data(), sum_xy.data(), N);
+        }
+        for (size_t i = 0; i < N; ++i) {
+            initial_level[i] = sum_y[i] / n;
+            initial_trend[i] = n > 1 ? (n * sum_xy[i] - sum_x * sum_y[i]) / (n * sum_xx - sum_x * sum_x)
+                                     : Compute(0);
+        }
+
+        std::vector<Compute> deviation(L * N, Compute(0));
+        for (int t = 0, season_idx = 0; t < n; ++t) {
+            Compute* __restrict d = deviation.data() + season_idx * N;
+            const Storage* __restrict x = values + t * N;
+            for (size_t i = 0; i < N; ++i) {
+                Compute expected = initial_level[i] + initial_trend[i] * t;
+                d[i] += x[i] - expected;
+            }
+            if (++season_idx == season_length) {
+                season_idx = 0;
+            }
+        }
+        for (size_t s = 0; s < L && s < train_length; ++s) {
+            int count = (n - static_cast<int>(s) + season_length - 1) / season_length;
+            for (size_t i = 0; i < N; ++i) {
+                deviation[s * N + i] /= count;
+            }
+        }
+        for (size_t i = 0; i < N; ++i) {
+            Compute seasonal_sum = 0;
+            for (size_t s = 0; s < L; ++s) {
+                seasonal_sum += deviation[s * N + i];
+            }
+            Compute seasonal_mean = seasonal_sum / season_length;
+            for (size_t s = 0; s < L; ++s) {
+                seasonal[s * N + i] = static_cast<Storage>(deviation[s * N + i] - seasonal_mean);
+            }
+        }
+        level = initial_level;
+        trend = initial_trend;
+
+        size_t pos = 0;
+        for (size_t t = L; t < train_length; ++t) {
+            advanceRow(values + t * N, seasonal.data() + pos * N, level.data(), trend.data(),
+                       initial_level.data(), initial_trend.data(), N, alpha, beta, gamma);
+            if (++pos == L) {
+                pos = 0;
+            }
+        }
+        season_pos = pos;
+    }
+
+    /**
+     * @brief WAPE каждого ряда на тестовой части (суммы в double)
+     * @return WAPE в процентах; NaN для ряда из одних нулей
+     * @throws std::logic_error если парк не обучен или нет тестовой части
+     */
+    std::vector<double> evaluateWape() const {
+        if (train_length == 0 || train_length == series_length) {
+            throw std::logic_error("evaluateWape: парк не обучен или нет тестовой части");
+        }
+        const size_t N = num_series;
+        std::vector<double> abs_error(N, 0.0);
+        std::vector<double> abs_actual(N, 0.0);
+        for (size_t h = 1; h <= series_length - train_length; ++h) {
+            const Storage* actual = values + (train_length + h - 1) * N;
+            const Storage* s = seasonal.data() + ((season_pos + h - 1) % season_length) * N;
+            for (size_t i = 0; i < N; ++i) {
+                Compute forecast = std::max(level[i] + h * trend[i] + s[i], Compute(0));
+                abs_error[i] += std::abs(static_cast<double>(actual[i]) - static_cast<double>(forecast));
+                abs_actual[i] += std::abs(static_cast<double>(actual[i]));
+            }
+        }
+        std::vector<double> wape(N);
+        for (size_t i = 0; i < N; ++i) {
+            wape[i] = abs_actual[i] > 0.0 ? abs_error[i] / abs_actual[i] * 100.0
+                                          : std::numeric_limits<double>::quiet_NaN();
+        }
+        return wape;
+    }
+
+    /**
+     * @brief Байт на состояние моделей (без входных данных)
+     */
+    size_t memoryBytes() const {
+        return (level.capacity() + trend.capacity() + initial_level.capacity() +
+                initial_trend.capacity()) * sizeof(Compute) + seasonal.capacity() * sizeof(Storage);
+    }
+
+private:
+    int season_length;
+    const Storage* values = nullptr;   ///< Не владеет: данные живут у вызывающего
+    size_t num_series = 0;
+    size_t series_length = 0;
+    size_t train_length = 0;
+    size_t season_pos = 0;
+    std::vector<Compute> level;
+    std::vector<Compute> trend;
+    std::vector<Compute> initial_level;
+    std::vector<Compute> initial_trend;
+    std::vector<Storage> seasonal;   ///< [s * num_series + i]
+
+    /**
+     * @brief Суммы для линейного тренда по одной строке времени
+     */
+    static void accumulateRow(const Storage* __restrict row, Compute x,
+                              Compute* __restrict sum_y, Compute* __restrict sum_xy, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            Compute y = row[i];
+            sum_y[i] += y;
+            sum_xy[i] += x * y;
+        }
+    }
+
+    /**
+     * @brief Шаг рекурсии для всех рядов в строке времени (как HoltWinters::advance)
+     *
+     * Без ветвлений: обе ветви выбора при расходимости читаются всегда,
+     * поэтому цикл векторизуется.
+     */
+    static void advanceRow(const Storage* __restrict x, Storage* __restrict s,
+                           Compute* __restrict lv, Compute* __restrict tr,
+                           const Compute* __restrict init_level, const Compute* __restrict init_trend,
+                           size_t n, Compute alpha, Compute beta, Compute gamma) {
+        const Compute limit = static_cast<Compute>(HoltWinters::kDivergenceLimit);
+        for (size_t i = 0; i < n; ++i) {
+            Compute value = x[i];
+            Compute season = s[i];
+            Compute new_level = alpha * (value - season) + (1 - alpha) * (lv[i] + tr[i]);
+            Compute new_trend = beta * (new_level - lv[i]) + (1 - beta) * tr[i];
+            s[i] = static_cast<Storage>(gamma * (value - new_level) + (1 - gamma) * season);
+            Compute reset_level = init_level[i];
+            Compute reset_trend = init_trend[i];
+            bool diverged = (new_level < 0) | (std::abs(new_level) > limit);
+            lv[i] = diverged ? reset_level : new_level;
+            tr[i] = diverged ? reset_trend : new_trend;
+        }
+    }
+};
+
+#endif // HOLT_WINTERS_MIXED_H
@@ -0,0 +1,55 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Файл, отображенный в память только для чтения (RAII)
+ *
+ * Используется загрузчиками данных: файл читается напрямую из page cache
+ * без копирования в промежуточные буферы. Объект только перемещается.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Отображает файл в память
+     * @param filename путь к файлу
+     * @param sequential подсказать ядру последовательное чтение (MADV_SEQUENTIAL)
+     * @return true если файл открыт (пустой файл - тоже успех, data() == nullptr)
+     */
+    bool open(const std::string& filename, bool sequential = true);
+
+    /**
+     * @brief Отдает ядру страницы уже прочитанного диапазона (MADV_DONTNEED)
+     *
+     * Данные не теряются: при следующем обращении страница снова читается
+     * из файла. Нужен для последовательного чтения файлов больше памяти.
+     * Освобождаются только страницы, целиком лежащие внутри диапазона.
+     */
+    void release(size_t offset, size_t count);
+
+    /**
+     * @brief Снимает отображение
+     */
+    void close();
+
+    const char* data() const { return static_cast<const char*>(address); }
+    size_t size() const { return length; }
+    bool isOpen() const { return opened; }
+
+private:
+    void* address = nullptr;
+    size_t length = 0;
+    bool opened = false;
+};
+
+#endif // MAPPED_FILE_H
@@ -2,6 +2,24 @@
 #define METRICS_H
 
 #include <vector>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief Все метрики ошибки прогноза, посчитанные за один проход
+ *
+ * Метрика, которая не определена на этих данных (например, WAPE при
+ * нулевой сумме фактических значений или MASE без обучающей выборки), равна NaN.
+ */
+struct ErrorStats {
+    double wape = 0.0;    ///< %
+    double mae = 0.0;
+    double rmse = 0.0;
+    double mape = 0.0;    ///< %, только по точкам с actual != 0
+    double smape = 0.0;   ///< %, 0..200
+    double mase = 0.0;    ///< MAE / средняя ошибка сезонного наивного прогноза на обучении
+};
 
 /**
  * @brief Класс для расчета метрик качества прогнозирования
@@ -35,6 +53,110 @@ public:
     static double rmse(const std::vector<double>& actual, 
                       const std::vector<double>& predicted);
 
+    /**
+     * @brief Вычисляет MAPE по точкам с ненулевым фактическим значением
+     * @return MAPE в процентах
+     */
+    static double mape(const std::vector<double>& actual,
+                      const std::vector<double>& predicted);
+
+    /**
+     * @brief Вычисляет sMAPE: среднее 2|a - p| / (|a| + |p|)
+     * @return sMAPE в процентах (0..200)
+     */
+    static double smape(const std::vector<double>& actual,
+                       const std::vector<double>& predicted);
+
+    /**
+     * @brief Вычисляет MASE: MAE, деленная на среднюю ошибку сезонного
+     * наивного прогноза y[t] = y[t - season_length] на обучающей выборке
+     * @param insample обучающая выборка
+     * @param season_length сдвиг наивного прогноза (1 - обычный наивный)
+     */
+    static double mase(const std::vector<double>& actual,
+                      const std::vector<double>& predicted,
+                      const std::vector<double>& insample,
+                      int season_length = 1);
+
+    /**
+     * @brief Все метрики за один проход (с компенсированным суммированием)
+     * @param insample обучающая выборка для MASE (пустая - MASE = NaN)
+     * @param season_length сдвиг наивного прогноза для MASE
+     */
+    static ErrorStats all(const std::vector<double>& actual,
+                          const std::vector<double>& predicted,
+                          const std::vector<double>& insample = {},
+                          int season_length = 1);
+
+    /**
+     * @brief Все метрики за один проход по указателям
+     */
+    static ErrorStats all(const double* actual, const double* predicted, size_t size,
+                          const double* insample = nullptr, size_t insample_size = 0,
+                          int season_length = 1);
+
+    /**
+     * @brief Метрики одного ряда фактических значений против многих прогнозов
+     *
+     * Знаменатель MASE (проход по обучающей выборке) считается один раз
+     * на пакет, а не на каждый прогноз.
+     * @param forecasts прогнозы подряд: forecasts[k * size + t], как HoltWintersBatch::predictAll
+     * @param num_forecasts количество прогнозов
+     * @param out массив на num_forecasts результатов
+     */
+    static void allBatch(const double* actual, size_t size,
+                         const double* forecasts, size_t num_forecasts,
+                         ErrorStats* out,
+                         const double* insample = nullptr, size_t insample_size = 0,
+                         int season_length = 1);
+
+    /**
+     * @brief WAPE по указателям для любого типа значений
+     * @tparam T тип значений (float или double)
+     * @tparam Accum тип сумм: double по умолчанию, чтобы float-данные
+     *         не теряли точность на длинных рядах
+     * @return WAPE в процентах
+     * @throws std::runtime_error если сумма фактических значений равна 0
+     */
+    template <typename T, typename Accum = double>
+    static double wape(const T* actual, const T* predicted, size_t size) {
+        Accum sum_abs_error = 0;
+        Accum sum_actual = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum_abs_error += std::abs(static_cast<Accum>(actual[i]) - static_cast<Accum>(predicted[i]));
+            sum_actual += std::abs(static_cast<Accum>(actual[i]));
+        }
+        if (sum_actual == 0) {
+            throw std::runtime_error("Сумма фактических значений равна 0, WAPE не может быть вычислен");
+        }
+        return static_cast<double>(sum_abs_error / sum_actual) * 100.0;
+    }
+
+    /**
+     * @brief MAE по указателям для любого типа значений (суммы в Accum)
+     */
+    template <typename T, typename Accum = double>
+    static double mae(const T* actual, const T* predicted, size_t size) {
+        Accum sum_abs_error = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum_abs_error += std::abs(static_cast<Accum>(actual[i]) - static_cast<Accum>(predicted[i]));
+        }
+        return static_cast<double>(sum_abs_error) / size;
+    }
+
+    /**
+     * @brief RMSE по указателям для любого типа значений (суммы в Accum)
+     */
+    template <typename T, typename Accum = double>
+    static double rmse(const T* actual, const T* predicted, size_t size) {
+        Accum sum_squared_error = 0;
+        for (size_t i = 0; i < size; ++i) {
+            Accum error = static_cast<Accum>(actual[i]) - static_cast<Accum>(predicted[i]);
+            sum_squared_error += error * error;
+        }
+        return std::sqrt(static_cast<double>(sum_squared_error) / size);
+    }
+
 private:
     /**
      * @brief Проверяет что векторы одинакового размера
@@ -43,4 +165,56 @@ private:
                               const std::vector<double>& predicted);
 };
 
+/**
+ * @brief WAPE, который считается по мере поступления прогноза
+ * и останавливается, как только кандидат уже не может победить
+ *
+ * Абсолютная ошибка только растет, поэтому как только она превысила
+ * bound / 100 * sum|actual|, итоговый WAPE заведомо больше bound.
+ * Суммы считаются в том же порядке, что и Metrics::wape, поэтому
+ * полностью посчитанный WAPE совпадает с ним до бита.
+ */
+class WapeAccumulator {
+public:
+    /**
+     * @brief Конструктор
+     * @param actual фактические значения (должны жить дольше накопителя)
+     * @param size количество значений
+     * @throws std::invalid_argument для пустого ряда,
+     *         std::runtime_error если сумма фактических значений равна 0
+     */
+    WapeAccumulator(const double* actual, size_t size);
+
+    /**
+     * @brief Начинает новый прогноз с заданной границей
+     * @param bound_wape WAPE, который нужно побить (infinity - без границы)
+     */
+    void reset(double bound_wape);
+
+    /**
+     * @brief Добавляет следующие count значений прогноза
+     * @return false если граница превышена - дальше считать не нужно
+     */
+    bool add(const double* predicted, size_t count);
+
+    size_t scored() const { return position; }
+    size_t size() const { return length; }
+    bool complete() const { return position == length && !exceeded; }
+    bool abandoned() const { return exceeded; }
+
+    /**
+     * @brief WAPE в процентах (имеет смысл при complete())
+     */
+    double wape() const { return (abs_error / sum_actual) * 100.0; }
+
+private:
+    const double* actual;
+    size_t length;
+    double sum_actual = 0.0;
+    double abs_error = 0.0;
+    double limit = 0.0;
+    size_t position = 0;
+    bool exceeded = false;
+};
+
 #endif // METRICS_H
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef MODEL_SNAPSHOT_H
+#define MODEL_SNAPSHOT_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "mapped_file.h"
+#include "holt_winters.h"
+
+/**
+ * @brief Двоичный снимок обученных моделей для быстрого старта без повторного fit
+ *
+ * Формат (little-endian, версия 1):
+ *   [0, 64)          заголовок SnapshotHeader
+ *   records_offset   ModelRecord[num_models] по 80 байт
+ *   seasonal_offset  сезонные компоненты всех моделей подряд (double),
+ *                    выровненные на 64 байта
+ *   names_offset     таблица строк: uint64 offsets[num_models + 1], затем байты имен
+ *
+ * Файл открывается через mmap: записи и сезонность читаются прямо из
+ * отображения, на модель ничего не выделяется. Прогноз можно строить
+ * прямо из снимка (forecastInto) или восстановить HoltWinters (restore).
+ */
+class ModelSnapshot {
+public:
+    static constexpr char kMagic[8] = {'H', 'W', 'S', 'N', 'A', 'P', '\0', '\0'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kSeasonalAlignment = 64;
+
+    /**
+     * @brief Заголовок файла (ровно 64 байта)
+     */
+    struct SnapshotHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t record_size;       ///< sizeof(ModelRecord) - защита от чужой раскладки
+        uint64_t num_models;
+        uint64_t seasonal_count;    ///< Всего сезонных значений
+        uint64_t records_offset;
+        uint64_t seasonal_offset;
+        uint64_t names_offset;
+        uint64_t file_size;
+    };
+    static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader должен занимать 64 байта");
+
+    /**
+     * @brief Состояние одной модели (ровно 80 байт)
+     */
+    struct ModelRecord {
+        double alpha;
+        double beta;
+        double gamma;
+        double level;
+        double trend;
+        double initial_level;
+        double initial_trend;
+        uint64_t observations;
+        uint64_t seasonal_index;    ///< Первое значение сезонности модели
+        int32_t season_length;
+        int32_t season_pos;
+    };
+    static_assert(sizeof(ModelRecord) == 80, "ModelRecord должен занимать 80 байт");
+
+    /**
+     * @brief Записывает снимок обученных моделей
+     * @param filename путь к файлу
+     * @param models модели (все должны быть обучены)
+     * @param names имена моделей (пустой вектор - без имен)
+     * @return true если запись успешна, false в случае ошибки (сообщение в cerr)
+     */
+    static bool write(const std::string& filename,
+                      const std::vector<const HoltWinters*>& models,
+                      const std::vector<std::string>& names = {});
+
+    /**
+     * @brief Снимок одной модели
+     */
+    static bool save(const std::string& filename, const HoltWinters& model);
+
+    /**
+     * @brief Загружает первую модель снимка
+     * @return true если модель восстановлена
+     */
+    static bool load(const std::string& filename, HoltWinters& model);
+
+    /**
+     * @brief Открывает снимок и проверяет заголовок, записи и границы разделов
+     * @return true если файл корректен, false в случае ошибки (сообщение в cerr)
+     */
+    bool open(const std::string& filename);
+
+    size_t size() const { return header.num_models; }
+    const ModelRecord& record(size_t i) const { return records[i]; }
+
+    /**
+     * @brief Сезонные компоненты модели i прямо из отображения
+     */
+    const double* seasonal(size_t i) const { return seasonal_values + records[i].seasonal_index; }
+
+    std::string_view name(size_t i) const;
+
+    /**
+     * @brief Номер модели по имени
+     * @return номер или size(), если модели нет
+     */
+    size_t find(std::string_view model_name) const;
+
+    /**
+     * @brief Восстанавливает модель i в существующий объект (без выделения памяти)
+     * @throws std::invalid_argument если длина сезона объекта другая
+     */
+    void restore(size_t i, HoltWinters& model) const;
+
+    /**
+     * @brief Новая модель из записи i
+     */
+    HoltWinters model(size_t i) const;
+
+    /**
+     * @brief Прогноз модели i на шаги 1..horizon прямо из снимка,
+     * как HoltWinters::forecast (с учетом фазы сезона)
+     * @param out буфер минимум на horizon значений
+     */
+    void forecastInto(size_t i, int horizon, double* out) const;
+
+private:
+    MappedFile file;
+    SnapshotHeader header{};
+    const ModelRecord* records = nullptr;
+    const double* seasonal_values = nullptr;
+};
+
+#endif // MODEL_SNAPSHOT_H
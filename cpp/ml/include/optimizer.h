@@ -0,0 +1,95 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+/**
+ * @brief Что минимизирует оптимизатор
+ */
+enum class Objective {
+    InSampleSSE,  ///< Сумма квадратов ошибок прогноза на шаг вперед на обучающей выборке
+    HoldoutWAPE   ///< WAPE прогноза на тестовую выборку (как в подборе по сетке)
+};
+
+/**
+ * @brief Настройки оптимизации
+ */
+struct OptimizerOptions {
+    double alpha = 0.3;          ///< Начальная точка
+    double beta = 0.1;
+    double gamma = 0.1;
+    size_t max_evaluations = 2000;
+    double tolerance = 1e-10;    ///< Остановка по разбросу значений / норме проекции градиента
+    size_t restarts = 3;         ///< Перезапуски Nelder-Mead из лучшей точки
+    /// Целевое значение: фиксируется, сколько оценок понадобилось, чтобы до него дойти
+    double target = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief Итог оптимизации
+ */
+struct OptimizerResult {
+    double alpha = 0.0;
+    double beta = 0.0;
+    double gamma = 0.0;
+    double value = 0.0;          ///< Значение целевой функции в найденной точке
+    size_t evaluations = 0;      ///< Сколько раз прогонялась рекурсия fit
+    size_t iterations = 0;
+    double elapsed_ms = 0.0;
+    bool reached_target = false;
+    size_t evaluations_to_target = 0;
+    double ms_to_target = 0.0;
+};
+
+/**
+ * @brief Подбор (alpha, beta, gamma) в [0, 1]^3 без перебора сетки
+ *
+ * Целевая функция считается той же рекурсией, что и HoltWinters::fit,
+ * с прямым распространением производных по alpha, beta и gamma
+ * (градиент нужен для L-BFGS).
+ */
+class HoltWintersOptimizer {
+public:
+    /**
+     * @brief Конструктор
+     * @param train обучающая выборка
+     * @param test тестовая выборка (нужна для HoldoutWAPE)
+     * @param season_length длина сезонного цикла
+     */
+    HoltWintersOptimizer(const std::vector<double>& train,
+                         const std::vector<double>& test,
+                         int season_length = 7);
+
+    /**
+     * @brief Значение целевой функции и, если gradient != nullptr, ее градиент
+     * @param params (alpha, beta, gamma)
+     * @param gradient буфер на 3 значения или nullptr
+     */
+    double evaluate(Objective objective, const double* params, double* gradient = nullptr) const;
+
+    /**
+     * @brief Nelder-Mead с проекцией вершин на [0, 1]^3
+     */
+    OptimizerResult nelderMead(Objective objective, const OptimizerOptions& options = {}) const;
+
+    /**
+     * @brief Проекционный L-BFGS с аналитическим градиентом
+     *
+     * Упрощенный вариант L-BFGS-B: шаг проецируется на границы,
+     * по закрепленным на границе координатам направление обнуляется.
+     */
+    OptimizerResult lbfgs(Objective objective, const OptimizerOptions& options = {}) const;
+
+private:
+    std::vector<double> train;
+    std::vector<double> test;
+    int season_length;
+    double initial_level;
+    double initial_trend;
+    std::vector<double> initial_seasonal;
+    double test_abs_sum;
+};
+
+#endif // OPTIMIZER_H
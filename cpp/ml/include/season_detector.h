@@ -0,0 +1,113 @@
+#ifndef SEASON_DETECTOR_H
+#define SEASON_DETECTOR_H
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include "fft.h"
+
+/**
+ * @brief Настройки поиска длины сезона
+ */
+struct SeasonDetectorOptions {
+    int min_period = 2;
+    int max_period = 0;        ///< 0 - length / 3 (на инициализацию HoltWinters нужно 2 сезона)
+    double min_acf = 0.2;      ///< Автокорреляция на найденном лаге не ниже этого порога
+    size_t candidates = 5;     ///< Сколько пиков периодограммы проверять по ACF
+};
+
+/**
+ * @brief Предложенная длина сезона ряда
+ */
+struct SeasonEstimate {
+    int period = 0;            ///< 0 - сезонность не найдена
+    double acf = 0.0;          ///< Автокорреляция на лаге period
+    double power_share = 0.0;  ///< Доля мощности периодограммы на пике-кандидате
+};
+
+/**
+ * @brief Автоматический выбор длины сезона по периодограмме и ACF
+ *
+ * Ряд освобождается от линейного тренда. Периодограмма считается на
+ * частотах k / n (FFT длины n: Bluestein, если n - не степень двойки);
+ * ее локальные максимумы дают кандидаты n / k и их кратные. Каждый
+ * кандидат уточняется до локального максимума ACF между периодами
+ * соседних частот; ACF считается через FFT длины 2^p >= 2n. Побеждает
+ * кандидат с наибольшей автокорреляцией; если у него есть делитель
+ * почти с той же ACF (кратное истинного периода), берется делитель.
+ *
+ * Ряды вещественные, поэтому два ряда упаковываются в одно комплексное
+ * преобразование (x + iy) и разделяются по симметрии спектра: на пару
+ * рядов - три FFT вместо шести. Планы строятся один раз на длину ряда.
+ * Объект держит рабочие буферы: один детектор - один поток
+ * (detectBatch создает свой на каждый поток).
+ */
+class SeasonDetector {
+public:
+    /**
+     * @param length длина рядов
+     * @throws std::invalid_argument если length < 2 * min_period или max_period < min_period
+     */
+    explicit SeasonDetector(size_t length, const SeasonDetectorOptions& options = {});
+
+    /**
+     * @brief Длина сезона одного ряда (length значений)
+     */
+    SeasonEstimate detect(const double* series);
+
+    /**
+     * @brief Два ряда за одни и те же преобразования
+     */
+    void detectPair(const double* first, const double* second,
+                    SeasonEstimate& first_estimate, SeasonEstimate& second_estimate);
+
+    /**
+     * @brief Длины сезонов парка рядов
+     * @param values ряды подряд: ряд i - [i * length, (i + 1) * length) (как SeriesMatrix)
+     * @param num_threads количество потоков (0 - все ядра)
+     * @param block_size рядов в одном блоке планировщика
+     */
+    static std::vector<SeasonEstimate> detectBatch(const double* values, size_t num_series, size_t length,
+                                                   const SeasonDetectorOptions& options = {},
+                                                   size_t num_threads = 0, size_t block_size = 64);
+
+    /**
+     * @brief Периодограмма последнего ряда detect: |X[k]|^2, k = 0..length / 2
+     */
+    const std::vector<double>& periodogram() const { return power[0]; }
+
+    /**
+     * @brief ACF последнего ряда detect: лаги 0..max_period
+     */
+    const std::vector<double>& autocorrelation() const { return acf[0]; }
+
+    size_t length() const { return series_length; }
+    int maxPeriod() const { return max_period; }
+
+private:
+    size_t series_length;
+    int min_period;
+    int max_period;
+    double min_acf;
+    size_t candidates;
+
+    Fft spectrum_plan;                            ///< Длина n
+    Fft acf_plan;                                 ///< Длина 2^p >= 2n
+    std::vector<std::complex<double>> spectrum;   ///< Буфер длины n
+    std::vector<std::complex<double>> padded;     ///< Буфер длины 2^p
+    std::vector<double> detrended[2];
+    std::vector<double> power[2];                 ///< Периодограммы пары
+    std::vector<double> acf[2];                   ///< ACF пары до max_period
+    std::vector<size_t> peaks;
+    std::vector<SeasonEstimate> hills;            ///< Локальные максимумы ACF у кандидатов
+
+    /**
+     * @brief Вычитает МНК-прямую
+     * @return false если ряд постоянный (сезонности нет)
+     */
+    bool detrend(const double* series, std::vector<double>& out) const;
+    void computeSpectra();
+    SeasonEstimate choose(const std::vector<double>& power_values, const std::vector<double>& acf_values);
+};
+
+#endif // SEASON_DETECTOR_H
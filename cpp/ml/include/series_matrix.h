@@ -0,0 +1,96 @@
+#ifndef SERIES_MATRIX_H
+#define SERIES_MATRIX_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Как ряды расположены в широком CSV
+ */
+enum class CsvLayout {
+    SeriesPerRow,     ///< Kaggle web traffic: "Page,2015-07-01,..." - строка = ряд
+    SeriesPerColumn   ///< "date,series1,series2,..." - колонка = ряд
+};
+
+/**
+ * @brief Что делать с пропущенными значениями (пустое поле или не число)
+ */
+enum class MissingPolicy {
+    KeepNaN,   ///< Оставить NaN
+    Zero,      ///< Заменить нулем (в Kaggle-файле пропуск = нет просмотров)
+    Previous   ///< Повторить предыдущее значение ряда (в начале ряда - 0)
+};
+
+/**
+ * @brief Настройки загрузки широкого CSV
+ */
+struct CsvLoadOptions {
+    CsvLayout layout = CsvLayout::SeriesPerRow;
+    MissingPolicy missing = MissingPolicy::KeepNaN;
+    size_t num_threads = 0;   ///< 0 - все ядра
+    char delimiter = ',';
+};
+
+/**
+ * @brief Статистика последней загрузки
+ */
+struct CsvLoadStats {
+    size_t bytes = 0;
+    size_t rows = 0;          ///< Строк данных (без заголовка)
+    size_t missing = 0;       ///< Пропущенных значений
+    size_t num_threads = 1;
+    double elapsed_ms = 0.0;
+    double mb_per_sec = 0.0;
+};
+
+/**
+ * @brief Матрица рядов одинаковой длины, загружаемая из широкого CSV
+ *
+ * Значения лежат одним непрерывным блоком: ряд i занимает
+ * [i * length(), (i + 1) * length()). Файл отображается в память (mmap),
+ * делится на куски по границам строк, и каждый поток разбирает свой кусок
+ * через std::from_chars прямо в матрицу - без промежуточных строк.
+ *
+ * Ограничение: кавычки поддерживаются, но перевод строки внутри поля - нет.
+ */
+class SeriesMatrix {
+public:
+    /**
+     * @brief Загружает широкий CSV
+     * @param filename путь к файлу
+     * @param options расположение рядов, обработка пропусков, потоки
+     * @return true если загрузка успешна, false в случае ошибки
+     */
+    bool loadWideCSV(const std::string& filename, const CsvLoadOptions& options = {});
+
+    size_t numSeries() const { return names.size(); }
+    size_t length() const { return series_length; }
+
+    /**
+     * @brief Указатель на начало ряда i (length() значений)
+     */
+    const double* series(size_t i) const { return values.data() + i * series_length; }
+
+    /**
+     * @brief Копия ряда i (для API на std::vector)
+     */
+    std::vector<double> seriesVector(size_t i) const {
+        return std::vector<double>(series(i), series(i) + series_length);
+    }
+
+    const std::string& name(size_t i) const { return names[i]; }
+    const std::vector<std::string>& getNames() const { return names; }
+    const std::vector<std::string>& getDates() const { return dates; }
+    const std::vector<double>& getValues() const { return values; }
+    const CsvLoadStats& lastLoadStats() const { return stats; }
+
+private:
+    std::vector<std::string> names;   ///< Имя каждого ряда
+    std::vector<std::string> dates;   ///< Метка каждой точки
+    std::vector<double> values;       ///< [series * series_length + t]
+    size_t series_length = 0;
+    CsvLoadStats stats;
+};
+
+#endif // SERIES_MATRIX_H
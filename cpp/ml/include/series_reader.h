@@ -0,0 +1,99 @@
+#ifndef SERIES_READER_H
+#define SERIES_READER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include "series_store.h"
+
+/**
+ * @brief Источник значений ряда, который отдает данные кусками
+ *
+ * Нужен для обучения на рядах, которые не помещаются в память
+ * (HoltWinters::fitStream): читатель держит только свой буфер.
+ */
+class SeriesReader {
+public:
+    virtual ~SeriesReader() = default;
+
+    /**
+     * @brief Читает следующие значения
+     * @param out буфер минимум на max_count значений
+     * @param max_count сколько значений можно записать
+     * @return сколько значений записано (0 - ряд закончился)
+     */
+    virtual size_t read(double* out, size_t max_count) = 0;
+};
+
+/**
+ * @brief Одна колонка CSV, читаемая потоково буфером фиксированного размера
+ *
+ * Первая строка (заголовок) пропускается, как в TimeSeries::loadFromCSV.
+ * Строки без нужной колонки или с нечисловым значением пропускаются
+ * и учитываются в skipped().
+ */
+class CsvColumnReader : public SeriesReader {
+public:
+    /**
+     * @param filename путь к CSV файлу
+     * @param value_col индекс колонки со значениями
+     * @param buffer_size размер буфера чтения в байтах
+     */
+    explicit CsvColumnReader(const std::string& filename, int value_col = 1,
+                             size_t buffer_size = 1 << 20);
+
+    bool isOpen() const { return file.is_open(); }
+    size_t skipped() const { return skipped_lines; }
+
+    size_t read(double* out, size_t max_count) override;
+
+private:
+    std::ifstream file;
+    int value_col;
+    std::vector<char> buffer;
+    size_t begin = 0;          ///< Начало необработанных данных в буфере
+    size_t end = 0;            ///< Конец прочитанных данных в буфере
+    bool header_skipped = false;
+    bool eof = false;
+    size_t skipped_lines = 0;
+
+    /**
+     * @brief Дочитывает файл в буфер; false если данных больше нет
+     */
+    bool refill();
+
+    /**
+     * @brief Разбирает одну строку [line, line_end)
+     * @return true и value, если в строке есть число в нужной колонке
+     */
+    bool parseLine(const char* line, const char* line_end, double& value) const;
+};
+
+/**
+ * @brief Один ряд двоичного хранилища (SeriesStore), читаемый по порядку
+ *
+ * Прочитанные страницы отображения отдаются ядру (MappedFile::release),
+ * поэтому резидентная память не растет с длиной ряда.
+ */
+class StoreSeriesReader : public SeriesReader {
+public:
+    /**
+     * @param filename путь к файлу хранилища
+     * @param series_name имя ряда (пустое - первый ряд)
+     */
+    explicit StoreSeriesReader(const std::string& filename, const std::string& series_name = "");
+
+    bool isOpen() const { return series < store.numSeries(); }
+    size_t length() const { return isOpen() ? store.length() : 0; }
+
+    size_t read(double* out, size_t max_count) override;
+
+private:
+    SeriesStore store;
+    size_t series = 0;
+    size_t position = 0;
+    size_t released = 0;       ///< До какой точки страницы уже отданы
+};
+
+#endif // SERIES_READER_H
@@ -0,0 +1,119 @@
+#ifndef SERIES_STORE_H
+#define SERIES_STORE_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "mapped_file.h"
+
+/**
+ * @brief Тип значений в хранилище
+ */
+enum class StoreValueType : uint32_t {
+    Float64 = 0,
+    Float32 = 1
+};
+
+/**
+ * @brief Двоичное хранилище рядов, открываемое через mmap без разбора
+ *
+ * Формат (little-endian, версия 1):
+ *   [0, 64)        заголовок StoreHeader
+ *   dates_offset   таблица строк: uint64 offsets[length + 1], затем байты дат
+ *   names_offset   таблица строк: uint64 offsets[num_series + 1], затем байты имен
+ *   values_offset  матрица значений, выровненная на 64 байта:
+ *                  ряд i занимает [i * length, (i + 1) * length) элементов
+ *
+ * Значения float64 читаются напрямую из отображения (без копирования),
+ * float32 занимает вдвое меньше места и расширяется при чтении.
+ */
+class SeriesStore {
+public:
+    static constexpr char kMagic[8] = {'H', 'W', 'S', 'T', 'O', 'R', 'E', '\0'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kValueAlignment = 64;
+
+    /**
+     * @brief Заголовок файла (ровно 64 байта)
+     */
+    struct StoreHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t value_type;
+        uint64_t num_series;
+        uint64_t length;
+        uint64_t dates_offset;
+        uint64_t names_offset;
+        uint64_t values_offset;
+        uint64_t file_size;
+    };
+    static_assert(sizeof(StoreHeader) == 64, "StoreHeader должен занимать 64 байта");
+
+    /**
+     * @brief Записывает хранилище
+     * @param filename путь к файлу
+     * @param names имена рядов (num_series)
+     * @param dates метки точек (length, может быть пустым)
+     * @param values матрица num_series * length, ряд за рядом
+     * @param length длина каждого ряда
+     * @param type тип значений в файле
+     * @return true если запись успешна
+     */
+    static bool write(const std::string& filename,
+                      const std::vector<std::string>& names,
+                      const std::vector<std::string>& dates,
+                      const double* values, size_t length,
+                      StoreValueType type = StoreValueType::Float64);
+
+    /**
+     * @brief Открывает хранилище и проверяет заголовок и границы разделов
+     * @return true если файл корректен, false в случае ошибки (сообщение в cerr)
+     */
+    bool open(const std::string& filename);
+
+    size_t numSeries() const { return header.num_series; }
+    size_t length() const { return header.length; }
+    StoreValueType valueType() const { return static_cast<StoreValueType>(header.value_type); }
+
+    /**
+     * @brief Ряд i как float64 прямо из отображения (nullptr для float32)
+     */
+    const double* seriesF64(size_t i) const;
+
+    /**
+     * @brief Ряд i как float32 прямо из отображения (nullptr для float64)
+     */
+    const float* seriesF32(size_t i) const;
+
+    /**
+     * @brief Копия ряда i в double независимо от типа хранения
+     */
+    std::vector<double> seriesVector(size_t i) const;
+
+    std::string_view name(size_t i) const { return stringAt(header.names_offset, header.num_series, i); }
+    std::string_view date(size_t t) const { return stringAt(header.dates_offset, date_count, t); }
+    size_t numDates() const { return date_count; }
+
+    /**
+     * @brief Отдает ядру страницы точек [begin, end) ряда i (см. MappedFile::release)
+     */
+    void releaseValues(size_t i, size_t begin, size_t end);
+
+    /**
+     * @brief Номер ряда по имени
+     * @return номер или numSeries(), если ряда нет
+     */
+    size_t find(std::string_view series_name) const;
+
+private:
+    MappedFile file;
+    StoreHeader header{};
+    size_t date_count = 0;
+
+    std::string_view stringAt(uint64_t table_offset, size_t count, size_t i) const;
+    bool validTable(uint64_t table_offset, size_t count, uint64_t limit) const;
+};
+
+#endif // SERIES_STORE_H
@@ -0,0 +1,145 @@
+#ifndef SIMD_LANES_H
+#define SIMD_LANES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Операции над вектором из kWidth значений double
+ *
+ * Ядра пакетного обучения (HoltWintersBatch, HoltWintersFleet) написаны
+ * один раз через эти операции и не зависят от набора инструкций:
+ * AVX-512 (8 значений), AVX2 (4) или скалярная реализация (4).
+ */
+namespace simd_lanes {
+
+#if defined(__AVX512F__)
+constexpr size_t kWidth = 8;
+constexpr bool kVectorized = true;
+#elif defined(__AVX2__)
+constexpr size_t kWidth = 4;
+constexpr bool kVectorized = true;
+#else
+constexpr size_t kWidth = 4;
+constexpr bool kVectorized = false;  ///< Скалярная эмуляция: полезна только для ILP в пакетах
+#endif
+
+/**
+ * @brief Название реализации ("avx512", "avx2", "scalar")
+ */
+inline const char* backendName() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+#if defined(__AVX512F__)
+
+struct Lanes {
+    using Vec = __m512d;
+    using Mask = __mmask8;
+    static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm512_storeu_pd(p, v); }
+    static Vec set1(double x) { return _mm512_set1_pd(x); }
+    static Vec add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+    /// level < 0 или |level| > limit
+    static Mask diverged(Vec level, Vec limit) {
+        Vec zero = _mm512_setzero_pd();
+        return _mm512_cmp_pd_mask(level, zero, _CMP_LT_OQ) |
+               _mm512_cmp_pd_mask(_mm512_abs_pd(level), limit, _CMP_GT_OQ);
+    }
+    static Vec select(Mask mask, Vec if_true, Vec if_false) {
+        return _mm512_mask_blend_pd(mask, if_false, if_true);
+    }
+};
+
+#elif defined(__AVX2__)
+
+struct Lanes {
+    using Vec = __m256d;
+    using Mask = __m256d;
+    static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    static Vec set1(double x) { return _mm256_set1_pd(x); }
+    static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+    static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+    static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+    static Mask diverged(Vec level, Vec limit) {
+        Vec abs_level = _mm256_andnot_pd(_mm256_set1_pd(-0.0), level);
+        return _mm256_or_pd(_mm256_cmp_pd(level, _mm256_setzero_pd(), _CMP_LT_OQ),
+                            _mm256_cmp_pd(abs_level, limit, _CMP_GT_OQ));
+    }
+    static Vec select(Mask mask, Vec if_true, Vec if_false) {
+        return _mm256_blendv_pd(if_false, if_true, mask);
+    }
+};
+
+#else
+
+struct Lanes {
+    struct Vec {
+        double v[kWidth];
+    };
+    struct Mask {
+        bool v[kWidth];
+    };
+    static Vec load(const double* p) {
+        Vec r;
+        std::copy(p, p + kWidth, r.v);
+        return r;
+    }
+    static void store(double* p, const Vec& a) {
+        std::copy(a.v, a.v + kWidth, p);
+    }
+    static Vec set1(double x) {
+        Vec r;
+        std::fill(r.v, r.v + kWidth, x);
+        return r;
+    }
+    static Vec add(const Vec& a, const Vec& b) {
+        Vec r;
+        for (size_t i = 0; i < kWidth; ++i) r.v[i] = a.v[i] + b.v[i];
+        return r;
+    }
+    static Vec sub(const Vec& a, const Vec& b) {
+        Vec r;
+        for (size_t i = 0; i < kWidth; ++i) r.v[i] = a.v[i] - b.v[i];
+        return r;
+    }
+    static Vec mul(const Vec& a, const Vec& b) {
+        Vec r;
+        for (size_t i = 0; i < kWidth; ++i) r.v[i] = a.v[i] * b.v[i];
+        return r;
+    }
+    static Mask diverged(const Vec& level, const Vec& limit) {
+        Mask m;
+        for (size_t i = 0; i < kWidth; ++i) {
+            m.v[i] = level.v[i] < 0 || std::abs(level.v[i]) > limit.v[i];
+        }
+        return m;
+    }
+    static Vec select(const Mask& mask, const Vec& if_true, const Vec& if_false) {
+        Vec r;
+        for (size_t i = 0; i < kWidth; ++i) {
+            r.v[i] = mask.v[i] ? if_true.v[i] : if_false.v[i];
+        }
+        return r;
+    }
+};
+
+#endif
+
+} // namespace simd_lanes
+
+#endif // SIMD_LANES_H
@@ -0,0 +1,89 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Ограниченная очередь без блокировок: один писатель, один читатель
+ *
+ * Кольцевой буфер длины 2^p. Писатель двигает tail, читатель - head;
+ * каждый держит копию чужого индекса и перечитывает атомарный индекс
+ * только когда копия говорит "полно" / "пусто", поэтому в установившемся
+ * режиме строка кэша с чужим индексом не гоняется между ядрами.
+ * Индексы лежат в разных строках кэша (alignas(64)).
+ *
+ * Элементы копируются; T должен быть тривиально копируемым и дешевым
+ * (например, Observation из anomaly_detector.h).
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @param capacity минимальная емкость (округляется вверх до степени двойки)
+     */
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Добавляет элемент (только поток-писатель)
+     * @return false если очередь полна
+     */
+    bool tryPush(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cached_head > mask) {
+            cached_head = head.load(std::memory_order_acquire);
+            if (t - cached_head > mask) {
+                return false;
+            }
+        }
+        buffer[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Забирает до max_count элементов за одну публикацию head (только поток-читатель)
+     * @return сколько элементов записано в out
+     */
+    size_t tryPopBatch(T* out, size_t max_count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (h == cached_tail) {
+                return 0;
+            }
+        }
+        size_t count = cached_tail - h;
+        if (count > max_count) {
+            count = max_count;
+        }
+        for (size_t k = 0; k < count; ++k) {
+            out[k] = buffer[(h + k) & mask];
+        }
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};   ///< Следующий читаемый (пишет читатель)
+    size_t cached_tail = 0;                    ///< Копия tail у читателя
+    alignas(64) std::atomic<size_t> tail{0};   ///< Следующий записываемый (пишет писатель)
+    size_t cached_head = 0;                    ///< Копия head у писателя
+    alignas(64) std::vector<T> buffer;
+    size_t mask = 0;
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,89 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Таблица строк в двоичных файлах (SeriesStore, ModelSnapshot)
+ *
+ * Формат: uint64 offsets[count + 1] (offsets[0] = 0), затем байты строк
+ * подряд; строка i - [offsets[i], offsets[i + 1]) после массива offsets.
+ */
+namespace string_table {
+
+/**
+ * @brief Размер таблицы в байтах
+ */
+inline uint64_t size(const std::vector<std::string>& strings) {
+    uint64_t bytes = (strings.size() + 1) * sizeof(uint64_t);
+    for (const auto& s : strings) {
+        bytes += s.size();
+    }
+    return bytes;
+}
+
+inline void write(std::ofstream& out, const std::vector<std::string>& strings) {
+    uint64_t offset = 0;
+    out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    for (const auto& s : strings) {
+        offset += s.size();
+        out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    for (const auto& s : strings) {
+        out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+}
+
+/**
+ * @brief Проверяет, что таблица из count строк по смещению table_offset
+ * целиком лежит в [table_offset, limit) и смещения не убывают
+ */
+inline bool valid(const char* data, uint64_t table_offset, size_t count, uint64_t limit) {
+    if (table_offset % sizeof(uint64_t) != 0 || table_offset > limit ||
+        (limit - table_offset) / sizeof(uint64_t) < count + 1) {
+        return false;
+    }
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + table_offset);
+    uint64_t bytes_begin = table_offset + (count + 1) * sizeof(uint64_t);
+    if (offsets[0] != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (offsets[i + 1] < offsets[i]) {
+            return false;
+        }
+    }
+    return offsets[count] <= limit - bytes_begin;
+}
+
+inline std::string_view at(const char* data, uint64_t table_offset, size_t count, size_t i) {
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + table_offset);
+    const char* bytes = reinterpret_cast<const char*>(offsets + count + 1);
+    return std::string_view(bytes + offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+inline uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Дописывает нули от смещения from до to
+ */
+inline void writePadding(std::ofstream& out, uint64_t from, uint64_t to) {
+    static const char zeros[64] = {};
+    while (from < to) {
+        uint64_t n = std::min<uint64_t>(to - from, sizeof(zeros));
+        out.write(zeros, static_cast<std::streamsize>(n));
+        from += n;
+    }
+}
+
+} // namespace string_table
+
+#endif // STRING_TABLE_H
@@ -4,6 +4,30 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include <memory>
+#include <cstddef>
+
+class SeriesStore;
+
+/**
+ * @brief Невладеющий вид на непрерывный участок ряда (аналог std::span<const double>)
+ */
+struct SeriesView {
+    const double* ptr = nullptr;
+    size_t count = 0;
+
+    const double* data() const { return ptr; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const double* begin() const { return ptr; }
+    const double* end() const { return ptr + count; }
+    double operator[](size_t index) const { return ptr[index]; }
+
+    /**
+     * @brief Копия в std::vector (для API, которые принимают вектор)
+     */
+    std::vector<double> toVector() const { return std::vector<double>(begin(), end()); }
+};
 
 /**
  * @brief Класс для работы с временными рядами
@@ -24,19 +48,54 @@ public:
                     int value_col = 1);
     
     /**
-     * @brief Возвращает значения временного ряда
+     * @brief Открывает ряд из двоичного хранилища (см. SeriesStore) через mmap
+     * @param filename путь к файлу хранилища
+     * @param series_name имя ряда (пустое - первый ряд)
+     * @return true если ряд найден, false в случае ошибки
+     *
+     * Ряд float64 не копируется: view() указывает прямо в отображение.
+     * Ряд float32 расширяется до double при открытии.
      */
-    const std::vector<double>& getValues() const { return values; }
+    bool openStore(const std::string& filename, const std::string& series_name = "");
+
+    /**
+     * @brief Открывает первый ряд из хранилища рядом с CSV, если оно есть, иначе разбирает CSV
+     * @param csv_file путь к CSV файлу; хранилище - тот же путь с расширением .hws (build_store)
+     *
+     * Хранилище старше CSV не используется: CSV пересобран, данные в нем устарели.
+     * @return true если загрузка успешна, false в случае ошибки
+     */
+    bool load(const std::string& csv_file);
+
+    /**
+     * @brief Значения ряда без копирования (из CSV или прямо из отображения хранилища)
+     *
+     * Копия в векторе, если она нужна, - view().toVector().
+     */
+    SeriesView view() const { return {mapped ? mapped : values.data(), mapped ? mapped_size : values.size()}; }
     
     /**
      * @brief Возвращает размер временного ряда
      */
-    size_t size() const { return values.size(); }
+    size_t size() const { return mapped ? mapped_size : values.size(); }
     
     /**
      * @brief Возвращает значение по индексу
      */
-    double operator[](size_t index) const { return values[index]; }
+    double operator[](size_t index) const { return mapped ? mapped[index] : values[index]; }
+
+    /**
+     * @brief Копия ряда в другом типе (например, float для HoltWintersMixed)
+     */
+    template <typename T>
+    std::vector<T> valuesAs() const {
+        SeriesView all = view();
+        std::vector<T> out(all.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            out[i] = static_cast<T>(all[i]);
+        }
+        return out;
+    }
     
     /**
      * @brief Разделяет ряд на обучающую и тестовую выборки
@@ -46,8 +105,20 @@ public:
     std::pair<std::vector<double>, std::vector<double>> 
     split(double train_ratio) const;
 
+    /**
+     * @brief Как split, но без копирования: два вида на участки ряда
+     *
+     * Виды действительны, пока жив этот объект TimeSeries.
+     */
+    std::pair<SeriesView, SeriesView> splitView(double train_ratio) const;
+
 private:
-    std::vector<double> values;
+    std::vector<double> values;                 ///< Свои данные (ряд float32 из хранилища - расширенный)
+    std::shared_ptr<const SeriesStore> store;   ///< Держит отображение открытым
+    const double* mapped = nullptr;             ///< Ряд float64 внутри отображения
+    size_t mapped_size = 0;
+
+    size_t trainSize(double train_ratio) const;
 };
 
 #endif // TIME_SERIES_H
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef TUNING_ENGINE_H
+#define TUNING_ENGINE_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "time_series.h"
+
+/**
+ * @brief Сетка параметров для подбора Holt-Winters
+ */
+struct ParameterGrid {
+    std::vector<double> alphas;
+    std::vector<double> betas;
+    std::vector<double> gammas;
+    std::vector<double> train_ratios;
+    int season_length = 7;
+    std::string data_file = "../../../data/processed/time_series.csv";
+
+    /**
+     * @brief Значения start, start + step, ... <= stop (по индексу, без накопления ошибки)
+     */
+    static std::vector<double> range(double start, double stop, double step);
+
+    /**
+     * @brief Количество комбинаций (alpha, beta, gamma, train_ratio)
+     */
+    size_t size() const {
+        return alphas.size() * betas.size() * gammas.size() * train_ratios.size();
+    }
+
+    /**
+     * @brief Загружает сетку из конфигурационного файла
+     *
+     * Формат: строки "ключ = значение", комментарии начинаются с '#'.
+     * Ключи: alpha, beta, gamma, train_ratios - диапазон "start:stop:step"
+     * или список через запятую; season_length; data.
+     * @throws std::runtime_error при ошибке чтения или формата
+     */
+    static ParameterGrid loadConfig(const std::string& filename);
+};
+
+/**
+ * @brief Результат одной оценки параметров
+ */
+struct TuningResult {
+    double alpha = 0.0;
+    double beta = 0.0;
+    double gamma = 0.0;
+    double train_ratio = 0.0;
+    double wape = 0.0;
+    size_t index = 0;            ///< Номер комбинации в сетке (для детерминированного порядка)
+};
+
+/**
+ * @brief Итог подбора параметров
+ */
+struct TuningReport {
+    std::vector<TuningResult> leaderboard; ///< Лучшие результаты по возрастанию WAPE
+    size_t evaluations = 0;                ///< Выполнено оценок
+    size_t failed = 0;                     ///< Оценок, где fit вернул false
+    size_t abandoned = 0;                  ///< Кандидатов, отброшенных до конца горизонта
+    size_t points_total = 0;               ///< Точек прогноза при полной оценке всех кандидатов
+    size_t points_scored = 0;              ///< Точек прогноза, реально построенных и оцененных
+    size_t num_threads = 1;
+    double elapsed_ms = 0.0;
+};
+
+/**
+ * @brief Параллельный перебор сетки параметров Holt-Winters
+ *
+ * Комбинации (alpha, beta, gamma, train_ratio) раздаются потокам
+ * блоками через атомарный счетчик. Каждый поток хранит свой список
+ * лучших результатов, в конце списки объединяются. Внутри блока
+ * соседние комбинации обучаются пакетами через HoltWintersBatch.
+ *
+ * С досрочным отбрасыванием (setEarlyAbandon) прогноз кандидата строится
+ * кусками и прекращается, как только его WAPE заведомо хуже последнего
+ * места в таблице потока. Таблица лидеров от этого не меняется.
+ * Отбрасывается только прогноз, а время занимает fit: на forth_tuning.cfg
+ * пропускается ~8% точек прогноза, и время в пределах шума замера.
+ * Поэтому по умолчанию выключено.
+ */
+class TuningEngine {
+public:
+    /**
+     * @brief Конструктор
+     * @param num_threads количество потоков (0 - все ядра)
+     * @param leaderboard_size сколько лучших результатов хранить
+     */
+    explicit TuningEngine(size_t num_threads = 0, size_t leaderboard_size = 10);
+
+    /**
+     * @brief Перебирает всю сетку на временном ряду
+     * @param series временной ряд
+     * @param grid сетка параметров
+     * @return отчет с таблицей лучших результатов
+     */
+    TuningReport run(const TimeSeries& series, const ParameterGrid& grid) const;
+
+    /**
+     * @brief Включает досрочное отбрасывание кандидатов
+     * @param enabled прекращать прогноз кандидата, который уже не попадет в таблицу
+     * @param spread_order раздавать блоки вразброс по сетке, чтобы граница
+     *        быстрее становилась жесткой (иначе - подряд)
+     */
+    void setEarlyAbandon(bool enabled, bool spread_order = true) {
+        early_abandon = enabled;
+        this->spread_order = spread_order;
+    }
+
+    /**
+     * @brief Сохраняет таблицу лучших результатов в JSON
+     * @return true если файл записан
+     */
+    static bool saveLeaderboardJson(const TuningReport& report,
+                                    const ParameterGrid& grid,
+                                    const std::string& filename);
+
+private:
+    size_t num_threads;
+    size_t leaderboard_size;
+    bool early_abandon = false;
+    bool spread_order = false;
+};
+
+#endif // TUNING_ENGINE_H
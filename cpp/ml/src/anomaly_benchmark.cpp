@@ -0,0 +1,402 @@
+/**
+ * @brief Бенчмарк онлайн-поиска аномалий по остаткам Holt-Winters
+ *
+ * Парк строится из time_series.csv, как в fleet_benchmark: каждый ряд -
+ * копия со своим масштабом, сдвигом и шумом. Модели обучаются на первых
+ * 70% точек, остаток ряда идет потоком с внесенными выбросами (~1% точек).
+ * Одни и те же точки проверяются тремя путями: AnomalyDetector на ряд,
+ * AnomalyFleet в одном потоке и AnomalyStream (очереди без блокировок,
+ * рабочие потоки). Пути должны найти одни и те же аномалии.
+ *
+ * В исходном ряде есть свои всплески, и они есть во всех копиях (со
+ * сдвигом). Поэтому поток прогоняется и без внесенных выбросов: дата
+ * исходного ряда, помеченная в >= 25% покрывающих ее рядов, считается
+ * настоящей аномалией. Precision печатается и по одним внесенным
+ * выбросам, и с учетом настоящих.
+ * Использование: anomaly_benchmark [--series N] [--threads T] [--k K]
+ *                                  [--output file] [--trace file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "anomaly_detector.h"
+#include "trace.h"
+
+namespace {
+
+/**
+ * @brief splitmix64: детерминированное число по индексу
+ */
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double uniform(uint64_t key) {
+    return (mix(key) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Сдвиг ряда номер i относительно исходного (целое число недель)
+ */
+size_t seriesShift(size_t base_size, size_t i) {
+    return 7 * static_cast<size_t>(uniform(i * 3 + 1) * (base_size / 7));
+}
+
+/**
+ * @brief Ряд номер i: масштаб 0.3-1.5, сдвиг на целое число недель, шум ±5%
+ */
+void makeSeries(SeriesView base, size_t i, std::vector<double>& out) {
+    double scale = 0.3 + 1.2 * uniform(i * 3);
+    size_t shift = seriesShift(base.size(), i);
+    for (size_t t = 0; t < base.size(); ++t) {
+        double noise = 1.0 + 0.1 * (uniform((i << 20) ^ t ^ 0xABCDEFull) - 0.5);
+        out[t] = scale * base[(t + shift) % base.size()] * noise;
+    }
+}
+
+/**
+ * @brief Выброс в точке t потока ряда i: ~1% точек, провал -60% или всплеск +100..200%
+ */
+bool injected(size_t i, size_t t, size_t warmup, double& factor) {
+    if (t < warmup || uniform((i << 24) ^ (t * 0x51ull) ^ 0x5EEDull) >= 0.01) {
+        return false;
+    }
+    double u = uniform((i << 24) ^ (t * 0x51ull) ^ 0xFACEull);
+    factor = u < 0.3 ? 0.4 : 2.0 + (u - 0.3) / 0.7;
+    return true;
+}
+
+double secondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Доля покрывающих рядов, при которой дата исходного ряда - настоящая аномалия
+ */
+constexpr double kNaturalShare = 0.25;
+
+/**
+ * @brief Один прогон AnomalyStream: источник в вызывающем потоке
+ */
+struct StreamRun {
+    size_t workers = 0;
+    double seconds = 0.0;
+    double points_per_sec = 0.0;
+    double points_per_sec_per_worker = 0.0;
+    std::vector<AnomalyEvent> events;
+};
+
+StreamRun runStream(const std::vector<HoltWinters>& models, const AnomalyOptions& options,
+                    const std::vector<double>& stream, size_t stream_length, size_t num_workers) {
+    const size_t num_series = models.size();
+    AnomalyFleet fleet(num_series, 7, options);
+    for (size_t i = 0; i < num_series; ++i) {
+        fleet.setModel(i, models[i]);
+    }
+
+    StreamRun run;
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        AnomalyStream pipeline(fleet, num_workers);
+        run.workers = pipeline.numWorkers();
+        // Точки приходят по времени: шаг t всех рядов, затем t + 1
+        for (size_t t = 0; t < stream_length; ++t) {
+            const double* row = stream.data() + t * num_series;
+            for (size_t i = 0; i < num_series; ++i) {
+                Observation observation;
+                observation.series = static_cast<uint32_t>(i);
+                observation.value = row[i];
+                pipeline.push(observation);
+            }
+        }
+        pipeline.close();
+        run.seconds = secondsSince(start);
+        run.events = pipeline.events();
+    }
+    double points = static_cast<double>(num_series) * stream_length;
+    run.points_per_sec = points / run.seconds;
+    run.points_per_sec_per_worker = run.points_per_sec / run.workers;
+    return run;
+}
+
+bool sameEvents(const std::vector<AnomalyEvent>& a, const std::vector<AnomalyEvent>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].series != b[k].series || a[k].index != b[k].index) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/anomaly_benchmark.json";
+    std::string trace_file;
+    size_t num_series = 20000;
+    size_t num_threads = 0;
+    AnomalyOptions options;
+    const double alpha = 0.07, beta = 0.01, gamma = 0.07;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--series" && i + 1 < argc) {
+            num_series = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoul(argv[++i]);
+        } else if (arg == "--k" && i + 1 < argc) {
+            options.k = std::stod(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_file = argv[++i];
+        }
+    }
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (!trace_file.empty()) {
+        trace::start();
+    }
+
+    std::cout << "=== ОНЛАЙН-ПОИСК АНОМАЛИЙ ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesView base = ts.view();
+    const size_t length = base.size();
+    const size_t train_length = static_cast<size_t>(length * 0.7);
+    const size_t stream_length = length - train_length;
+
+    // Модели и поток: stream[t * num_series + i] - точка t потока ряда i
+    std::vector<HoltWinters> models(num_series, HoltWinters(7));
+    std::vector<double> stream(stream_length * num_series);
+    std::vector<double> clean(stream.size());
+    std::vector<uint8_t> is_injected(stream.size(), 0);
+    std::vector<double> series(length);
+    size_t num_injected = 0;
+    for (size_t i = 0; i < num_series; ++i) {
+        makeSeries(base, i, series);
+        models[i].fit(series.data(), train_length, alpha, beta, gamma);
+        for (size_t t = 0; t < stream_length; ++t) {
+            double value = series[train_length + t];
+            clean[t * num_series + i] = value;
+            double factor = 1.0;
+            if (injected(i, t, options.warmup, factor)) {
+                value *= factor;
+                is_injected[t * num_series + i] = 1;
+                ++num_injected;
+            }
+            stream[t * num_series + i] = value;
+        }
+    }
+    const double points = static_cast<double>(num_series) * stream_length;
+
+    // 1. AnomalyDetector на каждый ряд (копия HoltWinters внутри)
+    std::vector<AnomalyDetector> detectors;
+    detectors.reserve(num_series);
+    for (size_t i = 0; i < num_series; ++i) {
+        detectors.emplace_back(models[i], options);
+    }
+    std::vector<uint8_t> single_flags(stream.size(), 0);
+    std::vector<double> single_forecasts(stream.size());
+    auto single_start = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < stream_length; ++t) {
+        for (size_t i = 0; i < num_series; ++i) {
+            size_t k = t * num_series + i;
+            AnomalyPoint point = detectors[i].observe(stream[k]);
+            single_flags[k] = point.anomaly;
+            single_forecasts[k] = point.forecast;
+        }
+    }
+    double single_seconds = secondsSince(single_start);
+
+    // 2. AnomalyFleet в одном потоке: те же точки в том же порядке
+    AnomalyFleet fleet(num_series, 7, options);
+    for (size_t i = 0; i < num_series; ++i) {
+        fleet.setModel(i, models[i]);
+    }
+    std::vector<uint8_t> fleet_flags(stream.size(), 0);
+    std::vector<double> fleet_forecasts(stream.size());
+    auto fleet_start = std::chrono::high_resolution_clock::now();
+    for (size_t t = 0; t < stream_length; ++t) {
+        for (size_t i = 0; i < num_series; ++i) {
+            size_t k = t * num_series + i;
+            AnomalyPoint point = fleet.observe(i, stream[k]);
+            fleet_flags[k] = point.anomaly;
+            fleet_forecasts[k] = point.forecast;
+        }
+    }
+    double fleet_seconds = secondsSince(fleet_start);
+
+    // Сверка с AnomalyDetector и список аномалий для сверки с AnomalyStream
+    double max_forecast_diff = 0.0;
+    size_t flag_mismatches = 0;
+    std::vector<AnomalyEvent> fleet_events;
+    for (size_t t = 0; t < stream_length; ++t) {
+        for (size_t i = 0; i < num_series; ++i) {
+            size_t k = t * num_series + i;
+            max_forecast_diff = std::max(max_forecast_diff, std::abs(fleet_forecasts[k] - single_forecasts[k]));
+            flag_mismatches += single_flags[k] != fleet_flags[k];
+            if (fleet_flags[k]) {
+                AnomalyEvent event;
+                event.series = static_cast<uint32_t>(i);
+                event.index = t;
+                fleet_events.push_back(event);
+            }
+        }
+    }
+    std::sort(fleet_events.begin(), fleet_events.end(), [](const AnomalyEvent& a, const AnomalyEvent& b) {
+        return a.series != b.series ? a.series < b.series : a.index < b.index;
+    });
+
+    // 3. AnomalyStream: один рабочий поток и num_threads
+    StreamRun stream_one = runStream(models, options, stream, stream_length, 1);
+    StreamRun stream_many = runStream(models, options, stream, stream_length, num_threads);
+    bool stream_match = sameEvents(stream_one.events, fleet_events) &&
+                        sameEvents(stream_many.events, fleet_events);
+
+    // Поток без внесенных выбросов: частота меток и настоящие всплески исходного ряда
+    AnomalyFleet clean_fleet(num_series, 7, options);
+    for (size_t i = 0; i < num_series; ++i) {
+        clean_fleet.setModel(i, models[i]);
+    }
+    std::vector<size_t> covered(length, 0);
+    std::vector<size_t> clean_hits(length, 0);
+    size_t clean_scored = 0;
+    size_t clean_flagged = 0;
+    for (size_t t = 0; t < stream_length; ++t) {
+        for (size_t i = 0; i < num_series; ++i) {
+            bool anomaly = clean_fleet.observe(i, clean[t * num_series + i]).anomaly;
+            if (t < options.warmup) {
+                continue;
+            }
+            size_t position = (train_length + t + seriesShift(length, i)) % length;
+            ++covered[position];
+            ++clean_scored;
+            clean_flagged += anomaly;
+            clean_hits[position] += anomaly;
+        }
+    }
+    std::vector<uint8_t> natural(length, 0);
+    size_t natural_dates = 0;
+    for (size_t position = 0; position < length; ++position) {
+        natural[position] = covered[position] > 0 && clean_hits[position] >= kNaturalShare * covered[position];
+        natural_dates += natural[position];
+    }
+    double clean_flag_rate = clean_scored > 0 ? static_cast<double>(clean_flagged) / clean_scored : 0.0;
+
+    // Качество: по внесенным выбросам и с учетом настоящих всплесков
+    size_t true_positive = 0;
+    size_t explained = 0;
+    size_t flagged = 0;
+    for (size_t t = 0; t < stream_length; ++t) {
+        for (size_t i = 0; i < num_series; ++i) {
+            size_t k = t * num_series + i;
+            if (!fleet_flags[k]) {
+                continue;
+            }
+            ++flagged;
+            true_positive += is_injected[k];
+            explained += is_injected[k] || natural[(train_length + t + seriesShift(length, i)) % length];
+        }
+    }
+    double precision = flagged > 0 ? static_cast<double>(true_positive) / flagged : 0.0;
+    double precision_natural = flagged > 0 ? static_cast<double>(explained) / flagged : 0.0;
+    double recall = num_injected > 0 ? static_cast<double>(true_positive) / num_injected : 0.0;
+
+    double single_rate = points / single_seconds;
+    double fleet_rate = points / fleet_seconds;
+    double bytes_per_series = static_cast<double>(fleet.memoryBytes()) / num_series;
+
+    std::cout << "Рядов: " << num_series << ", обучение " << train_length << " точек, поток "
+              << stream_length << " точек на ряд (" << static_cast<size_t>(points) << " всего)" << std::endl;
+    std::cout << "Полоса: k = " << options.k << ", EWMA " << options.scale_smoothing
+              << ", прогрев " << options.warmup << " точек" << std::endl;
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "AnomalyDetector на ряд: " << single_rate << " точек/с ("
+              << std::setprecision(1) << 1e9 / single_rate << " нс/точка)" << std::endl;
+    std::cout << std::setprecision(0) << "AnomalyFleet, 1 поток: " << fleet_rate << " точек/с ("
+              << std::setprecision(1) << 1e9 / fleet_rate << " нс/точка)" << std::endl;
+    std::cout << std::setprecision(0) << "AnomalyStream, 1 рабочий: " << stream_one.points_per_sec
+              << " точек/с (с очередью и источником)" << std::endl;
+    std::cout << "AnomalyStream, " << stream_many.workers << " рабочих: " << stream_many.points_per_sec
+              << " точек/с, " << stream_many.points_per_sec_per_worker << " на рабочий поток" << std::endl;
+    std::cout << "Память парка: " << bytes_per_series << " байт/ряд" << std::endl;
+    std::cout << "Аномалий: " << flagged << ", внесено " << num_injected << ", recall "
+              << std::setprecision(3) << recall << std::endl;
+    std::cout << "Precision: " << precision << " по внесенным, " << precision_natural
+              << " с настоящими всплесками (" << natural_dates << " дат исходного ряда)" << std::endl;
+    std::cout << "Без внесенных выбросов помечено " << std::setprecision(3) << 100.0 * clean_flag_rate
+              << "% точек" << std::endl;
+    std::cout << "Расхождение с AnomalyDetector: " << flag_mismatches << " флагов, прогноз "
+              << std::scientific << std::setprecision(2) << max_forecast_diff << std::endl;
+    std::cout << "AnomalyStream совпадает с AnomalyFleet: " << (stream_match ? "да" : "НЕТ") << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"config\": {\n";
+    json_file << "    \"num_series\": " << num_series << ",\n";
+    json_file << "    \"train_length\": " << train_length << ",\n";
+    json_file << "    \"stream_length\": " << stream_length << ",\n";
+    json_file << "    \"k\": " << options.k << ",\n";
+    json_file << "    \"scale_smoothing\": " << options.scale_smoothing << ",\n";
+    json_file << "    \"warmup\": " << options.warmup << ",\n";
+    json_file << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << "\n";
+    json_file << "  },\n";
+    json_file << "  \"throughput\": {\n";
+    json_file << "    \"detector_points_per_sec\": " << single_rate << ",\n";
+    json_file << "    \"fleet_points_per_sec\": " << fleet_rate << ",\n";
+    json_file << "    \"stream_1_points_per_sec\": " << stream_one.points_per_sec << ",\n";
+    json_file << "    \"stream_workers\": " << stream_many.workers << ",\n";
+    json_file << "    \"stream_points_per_sec\": " << stream_many.points_per_sec << ",\n";
+    json_file << "    \"stream_points_per_sec_per_worker\": " << stream_many.points_per_sec_per_worker << ",\n";
+    json_file << "    \"bytes_per_series\": " << bytes_per_series << "\n";
+    json_file << "  },\n";
+    json_file << "  \"quality\": {\n";
+    json_file << "    \"flagged\": " << flagged << ",\n";
+    json_file << "    \"injected\": " << num_injected << ",\n";
+    json_file << "    \"precision\": " << precision << ",\n";
+    json_file << "    \"precision_with_natural\": " << precision_natural << ",\n";
+    json_file << "    \"natural_dates\": " << natural_dates << ",\n";
+    json_file << "    \"clean_flag_rate\": " << clean_flag_rate << ",\n";
+    json_file << "    \"recall\": " << recall << "\n";
+    json_file << "  },\n";
+    json_file << "  \"consistency\": {\n";
+    json_file << "    \"flag_mismatches_vs_detector\": " << flag_mismatches << ",\n";
+    json_file << "    \"max_forecast_diff_vs_detector\": " << max_forecast_diff << ",\n";
+    json_file << "    \"stream_matches_fleet\": " << (stream_match ? "true" : "false") << "\n";
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    if (!trace_file.empty()) {
+        trace::stop();
+        if (!trace::writeChromeJson(trace_file)) {
+            return 1;
+        }
+        std::cout << "Трасса сохранена в " << trace_file << std::endl;
+    }
+    return stream_match && flag_mismatches == 0 && max_forecast_diff <= 1e-9 ? 0 : 1;
+}
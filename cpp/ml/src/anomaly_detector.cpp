@@ -0,0 +1,281 @@
+#include "anomaly_detector.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief sigma / E|r| для нормальных остатков: sqrt(pi / 2)
+ */
+constexpr double kMeanAbsToSigma = 1.2533141373155003;
+
+/**
+ * @brief Наблюдений, забираемых из очереди за раз
+ */
+constexpr size_t kPopBatch = 256;
+
+void validateOptions(const AnomalyOptions& options) {
+    if (!(options.k > 0.0)) {
+        throw std::invalid_argument("AnomalyOptions: k должен быть положительным");
+    }
+    if (!(options.scale_smoothing > 0.0 && options.scale_smoothing <= 1.0)) {
+        throw std::invalid_argument("AnomalyOptions: scale_smoothing должен быть в (0, 1]");
+    }
+}
+
+/**
+ * @brief Проверка точки по масштабу и шаг EWMA (общий для детектора и парка)
+ * @return значение, которым обновляется модель
+ */
+inline double score(const AnomalyOptions& options, double forecast, double value,
+                    double& mean_abs, uint64_t& scored, AnomalyPoint& point) {
+    point.forecast = forecast;
+    point.residual = value - forecast;
+    point.sigma = mean_abs * kMeanAbsToSigma;
+
+    double magnitude = std::abs(point.residual);
+    double bound = options.k * point.sigma;
+    point.anomaly = scored >= options.warmup && magnitude > bound;
+
+    double used = value;
+    if (point.anomaly && options.clip_anomalies) {
+        magnitude = bound;
+        used = forecast + (point.residual > 0.0 ? bound : -bound);
+    }
+    ++scored;
+    double weight = std::max(options.scale_smoothing, 1.0 / static_cast<double>(scored));
+    mean_abs += weight * (magnitude - mean_abs);
+    return used;
+}
+
+/**
+ * @brief Пропуск (NaN, inf): модель и масштаб не меняются
+ */
+inline AnomalyPoint missing(double forecast, double mean_abs) {
+    AnomalyPoint point;
+    point.forecast = forecast;
+    point.residual = std::numeric_limits<double>::quiet_NaN();
+    point.sigma = mean_abs * kMeanAbsToSigma;
+    return point;
+}
+
+} // namespace
+
+// ==================== AnomalyDetector ====================
+
+AnomalyDetector::AnomalyDetector(const HoltWinters& model, const AnomalyOptions& options)
+    : hw(model), options(options), mean_abs(0.0), scored(0), flagged(0) {
+    if (!model.isFitted()) {
+        throw std::invalid_argument("AnomalyDetector: модель не обучена");
+    }
+    validateOptions(options);
+}
+
+AnomalyPoint AnomalyDetector::observe(double value) {
+    double forecast = hw.forecast(1);
+    if (!std::isfinite(value)) {
+        return missing(forecast, mean_abs);
+    }
+    AnomalyPoint point;
+    uint64_t count = scored;
+    double used = score(options, forecast, value, mean_abs, count, point);
+    scored = count;
+    flagged += point.anomaly;
+    hw.update(used);
+    return point;
+}
+
+double AnomalyDetector::sigma() const {
+    return mean_abs * kMeanAbsToSigma;
+}
+
+// ==================== AnomalyFleet ====================
+
+AnomalyFleet::AnomalyFleet(size_t num_series, int season_length, const AnomalyOptions& options)
+    : season_length(season_length), options(options) {
+    if (season_length <= 0) {
+        throw std::invalid_argument("season_length должен быть положительным");
+    }
+    if (num_series == 0) {
+        throw std::invalid_argument("Парк должен содержать хотя бы один ряд");
+    }
+    validateOptions(options);
+    states.resize(num_series);
+    seasonal.assign(num_series * static_cast<size_t>(season_length), 0.0);
+}
+
+void AnomalyFleet::setModel(size_t i, const HoltWinters& model) {
+    if (i >= states.size()) {
+        throw std::invalid_argument("AnomalyFleet: ряд вне парка");
+    }
+    if (!model.isFitted()) {
+        throw std::invalid_argument("AnomalyFleet: модель не обучена");
+    }
+    if (model.getSeasonLength() != season_length) {
+        throw std::invalid_argument("AnomalyFleet: модель с другой длиной сезона");
+    }
+    HoltWinters::Parameters parameters = model.getParameters();
+    HoltWinters::State state = model.getState();
+
+    SeriesState& s = states[i];
+    s = SeriesState();
+    s.level = state.level;
+    s.trend = state.trend;
+    s.alpha = parameters.alpha;
+    s.beta = parameters.beta;
+    s.gamma = parameters.gamma;
+    s.initial_level = parameters.initial_level;
+    s.initial_trend = parameters.initial_trend;
+    s.season_pos = state.season_pos;
+    std::copy(state.seasonal.begin(), state.seasonal.end(),
+              seasonal.begin() + i * static_cast<size_t>(season_length));
+}
+
+AnomalyPoint AnomalyFleet::observe(size_t i, double value) {
+    if (i >= states.size()) {
+        throw std::invalid_argument("AnomalyFleet: ряд вне парка");
+    }
+    SeriesState& s = states[i];
+    if (s.season_pos < 0) {
+        throw std::logic_error("AnomalyFleet: модель ряда не задана");
+    }
+    double& season = seasonal[i * static_cast<size_t>(season_length) + s.season_pos];
+
+    // Прогноз на шаг вперед, как HoltWinters::forecast(1)
+    double forecast = std::max(s.level + s.trend + season, 0.0);
+    if (!std::isfinite(value)) {
+        return missing(forecast, s.mean_abs);
+    }
+    AnomalyPoint point;
+    double x = score(options, forecast, value, s.mean_abs, s.scored, point);
+    s.flagged += point.anomaly;
+
+    // Те же формулы, что в HoltWinters::advance
+    double new_level = s.alpha * (x - season) + (1 - s.alpha) * (s.level + s.trend);
+    double new_trend = s.beta * (new_level - s.level) + (1 - s.beta) * s.trend;
+    season = s.gamma * (x - new_level) + (1 - s.gamma) * season;
+    bool diverged = new_level < 0 || std::abs(new_level) > HoltWinters::kDivergenceLimit;
+    s.level = diverged ? s.initial_level : new_level;
+    s.trend = diverged ? s.initial_trend : new_trend;
+    if (++s.season_pos == season_length) {
+        s.season_pos = 0;
+    }
+    return point;
+}
+
+double AnomalyFleet::sigma(size_t i) const {
+    if (i >= states.size()) {
+        throw std::invalid_argument("AnomalyFleet: ряд вне парка");
+    }
+    return states[i].mean_abs * kMeanAbsToSigma;
+}
+
+size_t AnomalyFleet::memoryBytes() const {
+    return states.capacity() * sizeof(SeriesState) + seasonal.capacity() * sizeof(double);
+}
+
+// ==================== AnomalyStream ====================
+
+AnomalyStream::AnomalyStream(AnomalyFleet& fleet, size_t num_workers, size_t queue_capacity)
+    : fleet(fleet) {
+    if (num_workers == 0) {
+        num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_workers = std::min(num_workers, fleet.numSeries());
+    for (size_t w = 0; w < num_workers; ++w) {
+        workers.push_back(std::make_unique<Worker>(queue_capacity));
+    }
+    for (auto& worker : workers) {
+        threads.emplace_back([this, &worker]() { run(*worker); });
+    }
+}
+
+AnomalyStream::~AnomalyStream() {
+    close();
+}
+
+bool AnomalyStream::tryPush(const Observation& observation) {
+    if (closed) {
+        throw std::logic_error("AnomalyStream: поток уже закрыт");
+    }
+    if (observation.series >= fleet.numSeries() || !fleet.hasModel(observation.series)) {
+        throw std::invalid_argument("AnomalyStream: ряд вне парка или без модели");
+    }
+    return workers[observation.series % workers.size()]->queue.tryPush(observation);
+}
+
+void AnomalyStream::push(const Observation& observation) {
+    while (!tryPush(observation)) {
+        std::this_thread::yield();
+    }
+}
+
+void AnomalyStream::close() {
+    if (closed) {
+        return;
+    }
+    closing.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    closed = true;
+}
+
+void AnomalyStream::run(Worker& worker) {
+    TRACE_SPAN("AnomalyStream worker");
+    Observation batch[kPopBatch];
+    for (;;) {
+        size_t count = worker.queue.tryPopBatch(batch, kPopBatch);
+        if (count == 0) {
+            // После closing все push уже видны: пустая очередь - конец потока
+            if (!closing.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+                continue;
+            }
+            count = worker.queue.tryPopBatch(batch, kPopBatch);
+            if (count == 0) {
+                break;
+            }
+        }
+        for (size_t k = 0; k < count; ++k) {
+            const Observation& observation = batch[k];
+            uint64_t index = fleet.observations(observation.series);
+            AnomalyPoint point = fleet.observe(observation.series, observation.value);
+            if (point.anomaly) {
+                AnomalyEvent event;
+                event.series = observation.series;
+                event.index = index;
+                event.value = observation.value;
+                event.forecast = point.forecast;
+                event.sigma = point.sigma;
+                worker.events.push_back(event);
+            }
+        }
+        worker.processed.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+std::vector<AnomalyEvent> AnomalyStream::events() const {
+    if (!closed) {
+        throw std::logic_error("AnomalyStream: events доступны после close()");
+    }
+    std::vector<AnomalyEvent> merged;
+    for (const auto& worker : workers) {
+        merged.insert(merged.end(), worker->events.begin(), worker->events.end());
+    }
+    std::sort(merged.begin(), merged.end(), [](const AnomalyEvent& a, const AnomalyEvent& b) {
+        return a.series != b.series ? a.series < b.series : a.index < b.index;
+    });
+    return merged;
+}
+
+size_t AnomalyStream::processed() const {
+    size_t total = 0;
+    for (const auto& worker : workers) {
+        total += worker->processed.load(std::memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,95 @@
+#include "backtest.h"
+#include "metrics.h"
+#include <algorithm>
+#include <stdexcept>
+
+Backtester::Backtester(std::vector<size_t> origins, size_t horizon, int season_length,
+                       BacktestScoring scoring)
+    : origins(std::move(origins)), horizon(horizon), season_length(season_length), scoring(scoring) {
+    if (this->origins.empty()) {
+        throw std::invalid_argument("Нужна хотя бы одна точка origin");
+    }
+    if (!std::is_sorted(this->origins.begin(), this->origins.end())) {
+        throw std::invalid_argument("Точки origin должны идти по возрастанию");
+    }
+    if (this->origins.front() < 2 * static_cast<size_t>(season_length)) {
+        throw std::invalid_argument("Первый origin короче двух сезонов");
+    }
+}
+
+std::vector<size_t> Backtester::originsFromRatios(size_t series_size, const std::vector<double>& ratios) {
+    std::vector<size_t> result;
+    for (double ratio : ratios) {
+        if (ratio <= 0.0 || ratio >= 1.0) {
+            throw std::invalid_argument("train_ratio должен быть между 0.0 и 1.0");
+        }
+        result.push_back(static_cast<size_t>(series_size * ratio));
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+BacktestResult Backtester::run(SeriesView series,
+                               double alpha, double beta, double gamma,
+                               bool keep_checkpoints) const {
+    if (origins.back() >= series.size()) {
+        throw std::invalid_argument("Ряд короче последнего origin");
+    }
+
+    BacktestResult result;
+    result.alpha = alpha;
+    result.beta = beta;
+    result.gamma = gamma;
+
+    // Единственный fit: начальные значения по первому origin
+    HoltWinters model(season_length);
+    if (!model.fit(series.data(), origins.front(), alpha, beta, gamma)) {
+        throw std::invalid_argument("Некорректные параметры для проверки");
+    }
+
+    std::vector<double> actual;
+    std::vector<double> predicted;
+    for (size_t origin : origins) {
+        // Догоняем состояние до точки origin
+        for (size_t t = model.getObservations(); t < origin; ++t) {
+            model.update(series[t]);
+        }
+
+        size_t fold_horizon = series.size() - origin;
+        if (horizon > 0) {
+            fold_horizon = std::min(horizon, fold_horizon);
+        }
+
+        actual.assign(series.begin() + origin, series.begin() + origin + fold_horizon);
+        predicted.resize(fold_horizon);
+        if (scoring == BacktestScoring::Predict) {
+            model.predictRange(1, static_cast<int>(fold_horizon), predicted.data());
+        } else {
+            for (size_t h = 1; h <= fold_horizon; ++h) {
+                predicted[h - 1] = model.forecast(static_cast<int>(h));
+            }
+        }
+
+        BacktestFold fold;
+        fold.origin = origin;
+        fold.horizon = fold_horizon;
+        ErrorStats stats = Metrics::all(actual, predicted);
+        fold.wape = stats.wape;
+        fold.mae = stats.mae;
+        fold.rmse = stats.rmse;
+        if (keep_checkpoints) {
+            fold.checkpoint = model.getState();
+        }
+        result.mean_wape += fold.wape;
+        result.mean_mae += fold.mae;
+        result.mean_rmse += fold.rmse;
+        result.folds.push_back(std::move(fold));
+    }
+
+    double folds = static_cast<double>(result.folds.size());
+    result.mean_wape /= folds;
+    result.mean_mae /= folds;
+    result.mean_rmse /= folds;
+    return result;
+}
@@ -0,0 +1,181 @@
+/**
+ * @brief Сравнение пакетного обучения (HoltWintersBatch) со скалярным HoltWinters::fit
+ *
+ * Обе реализации обучаются на одних и тех же наборах (alpha, beta, gamma)
+ * из сетки конфигурации; сравниваются время и прогнозы.
+ * Использование: batch_benchmark [config] [--repeat N] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "holt_winters_batch.h"
+#include "metrics.h"
+#include "tuning_engine.h"
+
+/**
+ * @brief Набор параметров одной оценки
+ */
+struct ParamTriple {
+    double alpha;
+    double beta;
+    double gamma;
+};
+
+int main(int argc, char* argv[]) {
+    std::string config_file = "../configs/forth_tuning.cfg";
+    std::string output_file = "../../../results/ml/batch_fit_benchmark.json";
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else {
+            config_file = arg;
+        }
+    }
+
+    std::cout << "=== ПАКЕТНОЕ ОБУЧЕНИЕ HOLT-WINTERS ===" << std::endl;
+
+    ParameterGrid grid;
+    try {
+        grid = ParameterGrid::loadConfig(config_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка конфигурации: " << e.what() << std::endl;
+        return 1;
+    }
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV(grid.data_file)) {
+        return 1;
+    }
+
+    // Один train_ratio: сравниваем именно обучение, а не разбиение
+    auto [train_data, test_data] = ts.split(grid.train_ratios.front());
+    const int horizon = static_cast<int>(test_data.size());
+
+    std::vector<ParamTriple> params;
+    params.reserve(grid.alphas.size() * grid.betas.size() * grid.gammas.size());
+    for (double alpha : grid.alphas) {
+        for (double beta : grid.betas) {
+            for (double gamma : grid.gammas) {
+                params.push_back({alpha, beta, gamma});
+            }
+        }
+    }
+
+    std::cout << "Реализация: " << HoltWintersBatch::backendName()
+              << " (" << HoltWintersBatch::kLanes << " дорожек)" << std::endl;
+    std::cout << "Наборов параметров: " << params.size()
+              << ", обучающая выборка: " << train_data.size() << " точек" << std::endl;
+
+    std::vector<double> scalar_forecasts(params.size() * horizon);
+    std::vector<double> batch_forecasts(params.size() * horizon);
+
+    // Скалярный цикл: одна модель, fit + прогноз на каждый набор
+    double scalar_ms = 1e300;
+    HoltWinters model(grid.season_length);
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < params.size(); ++i) {
+            model.fit(train_data.data(), train_data.size(),
+                      params[i].alpha, params[i].beta, params[i].gamma);
+            model.predictInto(horizon, scalar_forecasts.data() + i * horizon);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        scalar_ms = std::min(scalar_ms, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    // Пакетный цикл: kLanes наборов за один проход по данным
+    double batch_ms = 1e300;
+    HoltWintersBatch batch(grid.season_length);
+    const size_t lanes = HoltWintersBatch::kLanes;
+    double lane_alpha[lanes];
+    double lane_beta[lanes];
+    double lane_gamma[lanes];
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t first = 0; first < params.size(); first += lanes) {
+            size_t count = std::min(lanes, params.size() - first);
+            for (size_t lane = 0; lane < count; ++lane) {
+                lane_alpha[lane] = params[first + lane].alpha;
+                lane_beta[lane] = params[first + lane].beta;
+                lane_gamma[lane] = params[first + lane].gamma;
+            }
+            batch.fit(train_data.data(), train_data.size(), lane_alpha, lane_beta, lane_gamma, count);
+            for (size_t lane = 0; lane < count; ++lane) {
+                batch.predictInto(lane, horizon, batch_forecasts.data() + (first + lane) * horizon);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        batch_ms = std::min(batch_ms, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    // Сверка прогнозов и лучшего WAPE
+    double max_abs_diff = 0.0;
+    for (size_t i = 0; i < scalar_forecasts.size(); ++i) {
+        max_abs_diff = std::max(max_abs_diff, std::abs(scalar_forecasts[i] - batch_forecasts[i]));
+    }
+    double best_scalar = 1e300;
+    double best_batch = 1e300;
+    for (size_t i = 0; i < params.size(); ++i) {
+        std::vector<double> s(scalar_forecasts.begin() + i * horizon,
+                              scalar_forecasts.begin() + (i + 1) * horizon);
+        std::vector<double> b(batch_forecasts.begin() + i * horizon,
+                              batch_forecasts.begin() + (i + 1) * horizon);
+        best_scalar = std::min(best_scalar, Metrics::wape(test_data, s));
+        best_batch = std::min(best_batch, Metrics::wape(test_data, b));
+    }
+
+    double scalar_rate = params.size() / (scalar_ms / 1000.0);
+    double batch_rate = params.size() / (batch_ms / 1000.0);
+    double speedup = scalar_ms / batch_ms;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nСкалярный fit: " << scalar_ms << " мс ("
+              << std::setprecision(0) << scalar_rate << " обучений/с)" << std::endl;
+    std::cout << std::setprecision(2);
+    std::cout << "Пакетный fit:  " << batch_ms << " мс ("
+              << std::setprecision(0) << batch_rate << " обучений/с)" << std::endl;
+    std::cout << std::setprecision(2) << "Ускорение: " << speedup << "x" << std::endl;
+    std::cout << std::scientific << std::setprecision(3)
+              << "Макс. расхождение прогнозов: " << max_abs_diff << std::endl;
+    std::cout << std::fixed << std::setprecision(4)
+              << "Лучший WAPE: скалярный " << best_scalar << "%, пакетный " << best_batch << "%" << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"batch_fit\": {\n";
+    json_file << "    \"backend\": \"" << HoltWintersBatch::backendName() << "\",\n";
+    json_file << "    \"lanes\": " << HoltWintersBatch::kLanes << ",\n";
+    json_file << "    \"param_sets\": " << params.size() << ",\n";
+    json_file << "    \"train_size\": " << train_data.size() << ",\n";
+    json_file << "    \"horizon\": " << horizon << ",\n";
+    json_file << "    \"repeat\": " << repeat << ",\n";
+    json_file << "    \"scalar_ms\": " << scalar_ms << ",\n";
+    json_file << "    \"batch_ms\": " << batch_ms << ",\n";
+    json_file << "    \"scalar_fits_per_sec\": " << scalar_rate << ",\n";
+    json_file << "    \"batch_fits_per_sec\": " << batch_rate << ",\n";
+    json_file << "    \"speedup\": " << speedup << ",\n";
+    json_file << "    \"max_abs_forecast_diff\": " << max_abs_diff << ",\n";
+    json_file << "    \"best_wape_scalar\": " << best_scalar << ",\n";
+    json_file << "    \"best_wape_batch\": " << best_batch << "\n";
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return max_abs_diff == 0.0 ? 0 : 1;
+}
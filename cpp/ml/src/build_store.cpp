@@ -0,0 +1,108 @@
+/**
+ * @brief Конвертирует CSV в двоичное хранилище рядов (SeriesStore)
+ * и сравнивает время запуска: разбор CSV против открытия через mmap
+ *
+ * Ряды, в которых нет ни одного числа (например, колонка page_name), пропускаются.
+ * Использование: build_store [--input file.csv] [--layout column|row]
+ *                            [--float32] [--output file.hws]
+ */
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "series_matrix.h"
+#include "series_store.h"
+
+int main(int argc, char* argv[]) {
+    std::string input_file = "../../../data/processed/time_series.csv";
+    std::string output_file = "../../../data/processed/time_series.hws";
+    CsvLoadOptions options;
+    options.layout = CsvLayout::SeriesPerColumn;
+    StoreValueType type = StoreValueType::Float64;
+    const int repeat = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--input" && i + 1 < argc) {
+            input_file = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--layout" && i + 1 < argc) {
+            std::string layout = argv[++i];
+            options.layout = layout == "row" ? CsvLayout::SeriesPerRow : CsvLayout::SeriesPerColumn;
+        } else if (arg == "--float32") {
+            type = StoreValueType::Float32;
+        }
+    }
+
+    std::cout << "=== ДВОИЧНОЕ ХРАНИЛИЩЕ РЯДОВ ===" << std::endl;
+
+    SeriesMatrix matrix;
+    if (!matrix.loadWideCSV(input_file, options)) {
+        return 1;
+    }
+
+    // Только ряды, в которых есть хотя бы одно число
+    std::vector<std::string> names;
+    std::vector<double> values;
+    for (size_t i = 0; i < matrix.numSeries(); ++i) {
+        const double* s = matrix.series(i);
+        if (std::all_of(s, s + matrix.length(), [](double v) { return std::isnan(v); })) {
+            std::cout << "Пропущен ряд без чисел: " << matrix.name(i) << std::endl;
+            continue;
+        }
+        names.push_back(matrix.name(i));
+        values.insert(values.end(), s, s + matrix.length());
+    }
+    if (names.empty()) {
+        std::cerr << "Ошибка: в " << input_file << " нет числовых рядов" << std::endl;
+        return 1;
+    }
+
+    if (!SeriesStore::write(output_file, names, matrix.getDates(), values.data(), matrix.length(), type)) {
+        return 1;
+    }
+    std::cout << "Записано " << names.size() << " рядов x " << matrix.length() << " точек ("
+              << (type == StoreValueType::Float64 ? "float64" : "float32") << ") в "
+              << output_file << std::endl;
+
+    // Время запуска: loadFromCSV (колонка 1) против openStore (первый ряд)
+    if (options.layout != CsvLayout::SeriesPerColumn) {
+        return 0;
+    }
+    std::cout.setstate(std::ios::failbit); // loadFromCSV печатает строку на каждый вызов
+    double csv_ms = 1e300;
+    double store_ms = 1e300;
+    TimeSeries from_csv;
+    TimeSeries from_store;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        from_csv.loadFromCSV(input_file);
+        auto mid = std::chrono::high_resolution_clock::now();
+        from_store.openStore(output_file, names.front());
+        auto end = std::chrono::high_resolution_clock::now();
+        csv_ms = std::min(csv_ms, std::chrono::duration<double, std::milli>(mid - start).count());
+        store_ms = std::min(store_ms, std::chrono::duration<double, std::milli>(end - mid).count());
+    }
+    std::cout.clear();
+
+    auto [train, test] = from_store.splitView(0.7);
+    bool same = from_store.size() == from_csv.size();
+    for (size_t i = 0; same && i < from_csv.size(); ++i) {
+        double expected = type == StoreValueType::Float64 ? from_csv[i]
+                                                          : static_cast<float>(from_csv[i]);
+        same = from_store[i] == expected;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "TimeSeries::loadFromCSV: " << std::setw(9) << csv_ms << " мс" << std::endl;
+    std::cout << "TimeSeries::openStore:   " << std::setw(9) << store_ms << " мс  ("
+              << std::setprecision(1) << csv_ms / store_ms << "x)" << std::endl;
+    std::cout << "splitView(0.7): " << train.size() << " + " << test.size()
+              << " точек без копирования" << std::endl;
+    std::cout << "Значения совпадают с CSV: " << (same ? "да" : "НЕТ") << std::endl;
+    return same ? 0 : 1;
+}
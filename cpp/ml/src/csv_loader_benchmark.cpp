@@ -0,0 +1,223 @@
+/**
+ * @brief Скорость загрузки широкого CSV: SeriesMatrix (mmap + from_chars, потоки)
+ * против построчного чтения через stringstream + stod
+ *
+ * Без --input генерирует синтетический файл в формате Kaggle web traffic
+ * (Page,date1,...,dateN; часть значений пропущена).
+ * Использование: csv_loader_benchmark [--input file] [--series N] [--days D]
+ *                                     [--threads T] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include "time_series.h"
+#include "series_matrix.h"
+
+namespace {
+
+/**
+ * @brief Синтетический широкий CSV: недельная сезонность, ~2% пропусков
+ */
+bool generateWideCSV(const std::string& filename, size_t num_series, size_t days) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось создать файл " << filename << std::endl;
+        return false;
+    }
+    file << "Page";
+    for (size_t d = 0; d < days; ++d) {
+        file << ",day_" << d;
+    }
+    file << "\n";
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> base_dist(10.0, 5000.0);
+    std::uniform_real_distribution<double> noise(0.8, 1.2);
+    std::uniform_int_distribution<int> missing(0, 49);
+    for (size_t s = 0; s < num_series; ++s) {
+        file << "\"Page_" << s << "_en.wikipedia.org_all-access_all-agents\"";
+        double base = base_dist(rng);
+        for (size_t d = 0; d < days; ++d) {
+            file << ",";
+            if (missing(rng) == 0) {
+                continue;
+            }
+            double weekly = 1.0 + 0.3 * std::sin(2.0 * M_PI * (d % 7) / 7.0);
+            file << std::round(base * weekly * noise(rng));
+        }
+        file << "\n";
+    }
+    return true;
+}
+
+/**
+ * @brief Наивная загрузка: getline + stringstream + stod на каждое поле
+ */
+double naiveLoad(const std::string& filename, std::vector<double>& values) {
+    auto start = std::chrono::high_resolution_clock::now();
+    values.clear();
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line); // заголовок
+    while (std::getline(file, line)) {
+        std::stringstream ss(line);
+        std::string field;
+        std::getline(ss, field, ',');
+        if (!field.empty() && field.front() == '"') {
+            while (field.size() < 2 || field.back() != '"') {
+                std::string rest;
+                if (!std::getline(ss, rest, ',')) {
+                    break;
+                }
+                field += "," + rest;
+            }
+        }
+        while (std::getline(ss, field, ',')) {
+            try {
+                values.push_back(std::stod(field));
+            } catch (const std::exception&) {
+                values.push_back(std::nan(""));
+            }
+        }
+        if (!line.empty() && line.back() == ',') {
+            values.push_back(std::nan(""));
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Совпадают ли значения с учетом NaN
+ */
+bool sameValues(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::isnan(a[i]) != std::isnan(b[i]) || (!std::isnan(a[i]) && a[i] != b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/csv_loader_benchmark.json";
+    std::string input_file;
+    size_t num_series = 50000;
+    size_t days = 550;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--input" && i + 1 < argc) {
+            input_file = argv[++i];
+        } else if (arg == "--series" && i + 1 < argc) {
+            num_series = std::stoul(argv[++i]);
+        } else if (arg == "--days" && i + 1 < argc) {
+            days = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== ЗАГРУЗКА ШИРОКОГО CSV ===" << std::endl;
+
+    // Сверка с TimeSeries: колонка traffic в формате date,traffic,page_name
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesMatrix column_matrix;
+    CsvLoadOptions column_options;
+    column_options.layout = CsvLayout::SeriesPerColumn;
+    if (!column_matrix.loadWideCSV("../../../data/processed/time_series.csv", column_options)) {
+        return 1;
+    }
+    bool matches_time_series = column_matrix.numSeries() >= 1
+        && column_matrix.name(0) == "traffic"
+        && column_matrix.seriesVector(0) == ts.view().toVector();
+    std::cout << "time_series.csv по колонкам совпадает с TimeSeries: "
+              << (matches_time_series ? "да" : "НЕТ") << std::endl;
+
+    if (input_file.empty()) {
+        input_file = "/tmp/wide_series_" + std::to_string(num_series) + "x" + std::to_string(days) + ".csv";
+        std::cout << "Генерация " << input_file << " (" << num_series << " рядов x "
+                  << days << " дней)..." << std::endl;
+        if (!generateWideCSV(input_file, num_series, days)) {
+            return 1;
+        }
+    }
+
+    // Прогрев page cache, чтобы мерить разбор, а не диск
+    std::vector<double> naive_values;
+    naiveLoad(input_file, naive_values);
+    double naive_ms = naiveLoad(input_file, naive_values);
+
+    SeriesMatrix matrix;
+    CsvLoadOptions options;
+    options.num_threads = 1;
+    if (!matrix.loadWideCSV(input_file, options)) {
+        return 1;
+    }
+    CsvLoadStats single = matrix.lastLoadStats();
+    bool matches_naive = sameValues(matrix.getValues(), naive_values);
+
+    options.num_threads = threads;
+    matrix.loadWideCSV(input_file, options);
+    CsvLoadStats parallel = matrix.lastLoadStats();
+    matches_naive = matches_naive && sameValues(matrix.getValues(), naive_values);
+
+    double mb = single.bytes / (1024.0 * 1024.0);
+    double naive_mb_per_sec = mb / (naive_ms / 1000.0);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Файл: " << mb << " МБ, рядов: " << matrix.numSeries()
+              << ", длина: " << matrix.length() << ", пропусков: " << parallel.missing << std::endl;
+    std::cout << "stringstream + stod:        " << std::setw(9) << naive_ms << " мс  "
+              << std::setw(7) << naive_mb_per_sec << " МБ/с" << std::endl;
+    std::cout << "SeriesMatrix, 1 поток:      " << std::setw(9) << single.elapsed_ms << " мс  "
+              << std::setw(7) << single.mb_per_sec << " МБ/с" << std::endl;
+    std::cout << "SeriesMatrix, " << std::setw(2) << parallel.num_threads << " потоков:   "
+              << std::setw(9) << parallel.elapsed_ms << " мс  "
+              << std::setw(7) << parallel.mb_per_sec << " МБ/с" << std::endl;
+    std::cout << "Ускорение (1 поток): " << std::setprecision(2) << naive_ms / single.elapsed_ms
+              << "x, значения совпадают: " << (matches_naive ? "да" : "НЕТ") << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"bytes\": " << single.bytes << ",\n";
+    json_file << "  \"num_series\": " << matrix.numSeries() << ",\n";
+    json_file << "  \"length\": " << matrix.length() << ",\n";
+    json_file << "  \"missing\": " << parallel.missing << ",\n";
+    json_file << "  \"naive_ms\": " << naive_ms << ",\n";
+    json_file << "  \"naive_mb_per_sec\": " << naive_mb_per_sec << ",\n";
+    json_file << "  \"single_thread_ms\": " << single.elapsed_ms << ",\n";
+    json_file << "  \"single_thread_mb_per_sec\": " << single.mb_per_sec << ",\n";
+    json_file << "  \"threads\": " << parallel.num_threads << ",\n";
+    json_file << "  \"parallel_ms\": " << parallel.elapsed_ms << ",\n";
+    json_file << "  \"parallel_mb_per_sec\": " << parallel.mb_per_sec << ",\n";
+    json_file << "  \"matches_naive\": " << (matches_naive ? "true" : "false") << ",\n";
+    json_file << "  \"matches_time_series\": " << (matches_time_series ? "true" : "false") << "\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return matches_naive && matches_time_series ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include "fft.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Произведение без проверок NaN/inf из operator* (иначе вызов __muldc3)
+ */
+inline std::complex<double> mul(std::complex<double> a, std::complex<double> b) {
+    return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+} // namespace
+
+Fft::Fft(size_t n) : n(n) {
+    if (n == 0) {
+        throw std::invalid_argument("Длина FFT должна быть положительной");
+    }
+
+    if ((n & (n - 1)) == 0) {
+        int bits = 0;
+        while ((size_t(1) << bits) < n) {
+            ++bits;
+        }
+        bit_reverse.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t reversed = 0;
+            for (int b = 0; b < bits; ++b) {
+                reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+            }
+            bit_reverse[i] = reversed;
+        }
+        twiddles.resize(n / 2);
+        for (size_t k = 0; k < n / 2; ++k) {
+            double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n);
+            twiddles[k] = {std::cos(angle), std::sin(angle)};
+        }
+        return;
+    }
+
+    // Bluestein: kt = (k^2 + t^2 - (k - t)^2) / 2, X[k] = w[k] * sum (x[t] w[t]) conj(w[k - t])
+    size_t m = nextPowerOfTwo(2 * n - 1);
+    inner = std::make_unique<Fft>(m);
+    chirp.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        // k^2 по модулю 2n: угол без потери точности на больших k
+        uint64_t k2 = (static_cast<uint64_t>(k) * k) % (2 * static_cast<uint64_t>(n));
+        double angle = -M_PI * static_cast<double>(k2) / static_cast<double>(n);
+        chirp[k] = {std::cos(angle), std::sin(angle)};
+    }
+    chirp_spectrum.assign(m, {0.0, 0.0});
+    chirp_spectrum[0] = std::conj(chirp[0]);
+    for (size_t k = 1; k < n; ++k) {
+        chirp_spectrum[k] = std::conj(chirp[k]);
+        chirp_spectrum[m - k] = std::conj(chirp[k]);
+    }
+    inner->forward(chirp_spectrum.data());
+    work.resize(m);
+}
+
+Fft::~Fft() = default;
+Fft::Fft(Fft&&) noexcept = default;
+Fft& Fft::operator=(Fft&&) noexcept = default;
+
+size_t Fft::nextPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+void Fft::forward(std::complex<double>* data) {
+    if (inner) {
+        bluestein(data);
+    } else {
+        radix2(data, false);
+    }
+}
+
+void Fft::inverse(std::complex<double>* data) {
+    if (inner) {
+        // x = conj(F(conj(X))) / n
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = std::conj(data[i]);
+        }
+        bluestein(data);
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = std::conj(data[i]);
+        }
+    } else {
+        radix2(data, true);
+    }
+    const double scale = 1.0 / static_cast<double>(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] *= scale;
+    }
+}
+
+void Fft::radix2(std::complex<double>* data, bool inverse_direction) const {
+    for (size_t i = 0; i < n; ++i) {
+        size_t j = bit_reverse[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        size_t half = len / 2;
+        size_t step = n / len;
+        for (size_t start = 0; start < n; start += len) {
+            std::complex<double>* lo = data + start;
+            std::complex<double>* hi = lo + half;
+            for (size_t j = 0; j < half; ++j) {
+                std::complex<double> w = twiddles[j * step];
+                if (inverse_direction) {
+                    w = std::conj(w);
+                }
+                std::complex<double> t = mul(hi[j], w);
+                hi[j] = lo[j] - t;
+                lo[j] += t;
+            }
+        }
+    }
+}
+
+void Fft::bluestein(std::complex<double>* data) {
+    size_t m = work.size();
+    for (size_t k = 0; k < n; ++k) {
+        work[k] = mul(data[k], chirp[k]);
+    }
+    std::fill(work.begin() + n, work.end(), std::complex<double>(0.0, 0.0));
+    inner->forward(work.data());
+    for (size_t k = 0; k < m; ++k) {
+        work[k] = mul(work[k], chirp_spectrum[k]);
+    }
+    inner->inverse(work.data());
+    for (size_t k = 0; k < n; ++k) {
+        data[k] = mul(work[k], chirp[k]);
+    }
+}
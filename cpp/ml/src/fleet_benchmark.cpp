@@ -0,0 +1,186 @@
+/**
+ * @brief Бенчмарк парка моделей: обучение и оценка тысяч рядов сразу
+ *
+ * В репозитории один ряд (time_series.csv), поэтому парк строится из него:
+ * каждый ряд - копия со своим масштабом, сдвигом и шумом (детерминированно
+ * от номера ряда). Часть рядов сверяется со скалярным HoltWinters.
+ * Использование: fleet_benchmark [--series N] [--threads T] [--block B] [--output file]
+ *                                [--trace file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "holt_winters_fleet.h"
+#include "metrics.h"
+#include "trace.h"
+
+namespace {
+
+/**
+ * @brief splitmix64: детерминированное число по индексу
+ */
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double uniform(uint64_t key) {
+    return (mix(key) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Ряд номер i: масштаб 0.3-1.5, сдвиг на целое число недель, шум ±5%
+ */
+void makeSeries(SeriesView base, size_t i, std::vector<double>& out) {
+    double scale = 0.3 + 1.2 * uniform(i * 3);
+    size_t shift = 7 * static_cast<size_t>(uniform(i * 3 + 1) * (base.size() / 7));
+    for (size_t t = 0; t < base.size(); ++t) {
+        double noise = 1.0 + 0.1 * (uniform((i << 20) ^ t ^ 0xABCDEFull) - 0.5);
+        out[t] = scale * base[(t + shift) % base.size()] * noise;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/fleet_benchmark.json";
+    std::string trace_file;
+    size_t num_series = 20000;
+    size_t num_threads = 0;
+    size_t block_size = 256;
+    const double alpha = 0.07, beta = 0.01, gamma = 0.07;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--series" && i + 1 < argc) {
+            num_series = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoul(argv[++i]);
+        } else if (arg == "--block" && i + 1 < argc) {
+            block_size = std::stoul(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_file = argv[++i];
+        }
+    }
+    if (!trace_file.empty()) {
+        trace::start();
+    }
+
+    std::cout << "=== ПАРК МОДЕЛЕЙ HOLT-WINTERS ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesView base = ts.view();
+    const size_t length = base.size();
+    const size_t train_length = static_cast<size_t>(length * 0.7);
+
+    HoltWintersFleet fleet(num_series, length, 7);
+    std::vector<double> series(length);
+    for (size_t i = 0; i < num_series; ++i) {
+        makeSeries(base, i, series);
+        fleet.setSeries(i, series.data());
+    }
+    fleet.setParameters(alpha, beta, gamma);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    fleet.fit(train_length, num_threads, block_size);
+    auto mid = std::chrono::high_resolution_clock::now();
+    std::vector<SeriesMetrics> metrics = fleet.evaluate(num_threads, block_size);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double fit_ms = std::chrono::duration<double, std::milli>(mid - start).count();
+    double eval_ms = std::chrono::duration<double, std::milli>(end - mid).count();
+    double total_ms = fit_ms + eval_ms;
+    double series_per_sec = num_series / (total_ms / 1000.0);
+    double ns_per_point = total_ms * 1e6 / (static_cast<double>(num_series) * length);
+    double bytes_per_series = static_cast<double>(fleet.memoryBytes()) / num_series;
+
+    double mean_wape = 0.0;
+    for (const auto& m : metrics) {
+        mean_wape += m.wape;
+    }
+    mean_wape /= num_series;
+
+    // Тот же цикл по рядам через скалярный HoltWinters (по одной модели на ряд)
+    const size_t scalar_series = std::min<size_t>(num_series, 2000);
+    double max_diff = 0.0;
+    std::vector<double> test(length - train_length);
+    std::vector<double> predictions(test.size());
+    HoltWinters model(7);
+    auto scalar_start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < scalar_series; ++i) {
+        makeSeries(base, i, series);
+        model.fit(series.data(), train_length, alpha, beta, gamma);
+        for (size_t h = 1; h <= test.size(); ++h) {
+            predictions[h - 1] = model.forecast(static_cast<int>(h));
+        }
+        test.assign(series.begin() + train_length, series.end());
+        max_diff = std::max(max_diff, std::abs(Metrics::wape(test, predictions) - metrics[i].wape));
+        max_diff = std::max(max_diff, std::abs(Metrics::rmse(test, predictions) - metrics[i].rmse));
+    }
+    auto scalar_end = std::chrono::high_resolution_clock::now();
+    // Время скалярного пути включает генерацию ряда - это оценка сверху
+    double scalar_series_per_sec = scalar_series /
+        (std::chrono::duration<double>(scalar_end - scalar_start).count());
+
+    std::cout << "Рядов: " << num_series << " × " << length << " точек (обучение "
+              << train_length << "), блок " << block_size << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "fit: " << fit_ms << " мс, evaluate: " << eval_ms << " мс" << std::endl;
+    std::cout << "Пропускная способность: " << std::setprecision(0) << series_per_sec
+              << " рядов/с (" << std::setprecision(2) << ns_per_point << " нс/точка)" << std::endl;
+    std::cout << "Скалярный HoltWinters: " << std::setprecision(0) << scalar_series_per_sec
+              << " рядов/с" << std::endl;
+    std::cout << "Память: " << std::setprecision(0) << bytes_per_series << " байт/ряд ("
+              << std::setprecision(1) << fleet.memoryBytes() / (1024.0 * 1024.0) << " МБ)" << std::endl;
+    std::cout << "Средний WAPE: " << std::setprecision(3) << mean_wape << "%" << std::endl;
+    std::cout << std::scientific << std::setprecision(2)
+              << "Расхождение со скалярным fit (" << scalar_series << " рядов): " << max_diff << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"fleet\": {\n";
+    json_file << "    \"num_series\": " << num_series << ",\n";
+    json_file << "    \"series_length\": " << length << ",\n";
+    json_file << "    \"train_length\": " << train_length << ",\n";
+    json_file << "    \"block_size\": " << block_size << ",\n";
+    json_file << "    \"num_threads\": " << num_threads << ",\n";
+    json_file << "    \"fit_ms\": " << fit_ms << ",\n";
+    json_file << "    \"evaluate_ms\": " << eval_ms << ",\n";
+    json_file << "    \"series_per_sec\": " << series_per_sec << ",\n";
+    json_file << "    \"ns_per_point\": " << ns_per_point << ",\n";
+    json_file << "    \"scalar_series_per_sec\": " << scalar_series_per_sec << ",\n";
+    json_file << "    \"bytes_per_series\": " << bytes_per_series << ",\n";
+    json_file << "    \"mean_wape\": " << mean_wape << ",\n";
+    json_file << "    \"max_diff_vs_scalar\": " << max_diff << "\n";
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    if (!trace_file.empty()) {
+        trace::stop();
+        if (!trace::writeChromeJson(trace_file)) {
+            return 1;
+        }
+        std::cout << "Трасса сохранена в " << trace_file << std::endl;
+    }
+    return max_diff <= 1e-9 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/**
+ * @brief Генератор нагрузки для forecast_server: QPS и перцентили задержки
+ *
+ * Каждый клиент - свой поток и свое соединение; отправляет pipeline
+ * запросов подряд и ждет столько же ответов. Идентификаторы моделей
+ * берутся из того же снимка, что у сервера (без снимка - "traffic").
+ * Использование: forecast_load [--socket path] [--snapshot file] [--clients C]
+ *                              [--requests N] [--pipeline P] [--horizon H]
+ *                              [--append-ratio R] [--shutdown] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "model_snapshot.h"
+
+namespace {
+
+/**
+ * @brief Итог одного клиента
+ */
+struct ClientResult {
+    std::vector<double> latencies_us;
+    size_t errors = 0;
+    bool failed = false;
+};
+
+int connectTo(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Читает ровно count строк ответа
+ * @param errors увеличивается на число ответов ERR
+ */
+bool readLines(int fd, size_t count, std::string& pending, size_t& errors) {
+    char buffer[64 * 1024];
+    size_t lines = 0;
+    while (true) {
+        size_t begin = 0;
+        size_t newline;
+        while (lines < count && (newline = pending.find('\n', begin)) != std::string::npos) {
+            if (pending.compare(begin, 3, "ERR") == 0) {
+                ++errors;
+            }
+            begin = newline + 1;
+            ++lines;
+        }
+        pending.erase(0, begin);
+        if (lines == count) {
+            return true;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        pending.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string socket_path = "/tmp/holt_winters_forecast.sock";
+    std::string snapshot_file = "../../../data/processed/models.hwm";
+    std::string output_file = "../../../results/ml/forecast_server_load.json";
+    size_t num_clients = 8;
+    size_t requests_per_client = 20000;
+    size_t pipeline = 1;
+    int horizon = 14;
+    double append_ratio = 0.1;
+    bool shutdown = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshot_file = argv[++i];
+        } else if (arg == "--clients" && i + 1 < argc) {
+            num_clients = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--requests" && i + 1 < argc) {
+            requests_per_client = std::stoul(argv[++i]);
+        } else if (arg == "--pipeline" && i + 1 < argc) {
+            pipeline = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--horizon" && i + 1 < argc) {
+            horizon = std::stoi(argv[++i]);
+        } else if (arg == "--append-ratio" && i + 1 < argc) {
+            append_ratio = std::stod(argv[++i]);
+        } else if (arg == "--shutdown") {
+            shutdown = true;
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== НАГРУЗКА НА СЕРВЕР ПРОГНОЗОВ ===" << std::endl;
+
+    std::vector<std::string> ids;
+    ModelSnapshot snapshot;
+    if (snapshot.open(snapshot_file)) {
+        ids.reserve(snapshot.size());
+        for (size_t i = 0; i < snapshot.size(); ++i) {
+            ids.emplace_back(snapshot.name(i).empty() ? std::to_string(i) : std::string(snapshot.name(i)));
+        }
+    } else {
+        ids.push_back("traffic");
+    }
+
+    std::vector<ClientResult> results(num_clients);
+    const uint64_t append_threshold = static_cast<uint64_t>(append_ratio * 1000000);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < num_clients; ++c) {
+        threads.emplace_back([&, c]() {
+            ClientResult& result = results[c];
+            int fd = connectTo(socket_path);
+            if (fd < 0) {
+                result.failed = true;
+                return;
+            }
+            result.latencies_us.reserve(requests_per_client);
+            std::string request;
+            std::string pending;
+            for (size_t sent = 0; sent < requests_per_client; sent += pipeline) {
+                size_t count = std::min(pipeline, requests_per_client - sent);
+                request.clear();
+                for (size_t k = 0; k < count; ++k) {
+                    uint64_t r = mix((c << 40) ^ (sent + k));
+                    const std::string& id = ids[r % ids.size()];
+                    if ((r >> 32) % 1000000 < append_threshold) {
+                        request += "APPEND " + id + " " + std::to_string(100 + (r >> 48) % 400) + "\n";
+                    } else {
+                        request += "FORECAST " + id + " " + std::to_string(horizon) + "\n";
+                    }
+                }
+                auto sent_at = std::chrono::high_resolution_clock::now();
+                if (!sendAll(fd, request) || !readLines(fd, count, pending, result.errors)) {
+                    result.failed = true;
+                    break;
+                }
+                double latency = std::chrono::duration<double, std::micro>(
+                    std::chrono::high_resolution_clock::now() - sent_at).count();
+                // Задержка пачки - задержка каждого ее запроса
+                result.latencies_us.insert(result.latencies_us.end(), count, latency);
+            }
+            close(fd);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed_s = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    std::vector<double> latencies;
+    size_t errors = 0;
+    size_t failed = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies_us.begin(), result.latencies_us.end());
+        errors += result.errors;
+        failed += result.failed ? 1 : 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    if (failed == num_clients) {
+        std::cerr << "Ошибка: не удалось подключиться к " << socket_path << std::endl;
+        return 1;
+    }
+
+    if (shutdown) {
+        int fd = connectTo(socket_path);
+        if (fd >= 0) {
+            sendAll(fd, "SHUTDOWN\n");
+            close(fd);
+        }
+    }
+
+    double qps = latencies.size() / elapsed_s;
+    double p50 = percentile(latencies, 50), p90 = percentile(latencies, 90);
+    double p99 = percentile(latencies, 99), p999 = percentile(latencies, 99.9);
+    double max_latency = latencies.empty() ? 0.0 : latencies.back();
+
+    std::cout << "Моделей: " << ids.size() << ", клиентов: " << num_clients
+              << ", pipeline: " << pipeline << ", горизонт: " << horizon
+              << ", доля APPEND: " << append_ratio << std::endl;
+    std::cout << "Запросов: " << latencies.size() << " за " << std::fixed << std::setprecision(2)
+              << elapsed_s << " с, ошибок: " << errors << ", оборванных клиентов: " << failed << std::endl;
+    std::cout << "QPS: " << std::setprecision(0) << qps << std::endl;
+    std::cout << "Задержка, мкс: p50=" << std::setprecision(1) << p50 << " p90=" << p90
+              << " p99=" << p99 << " p99.9=" << p999 << " max=" << max_latency << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"models\": " << ids.size() << ",\n";
+    json_file << "  \"clients\": " << num_clients << ",\n";
+    json_file << "  \"pipeline\": " << pipeline << ",\n";
+    json_file << "  \"horizon\": " << horizon << ",\n";
+    json_file << "  \"append_ratio\": " << append_ratio << ",\n";
+    json_file << "  \"requests\": " << latencies.size() << ",\n";
+    json_file << "  \"errors\": " << errors << ",\n";
+    json_file << "  \"elapsed_s\": " << elapsed_s << ",\n";
+    json_file << "  \"qps\": " << qps << ",\n";
+    json_file << "  \"latency_us\": {\"p50\": " << p50 << ", \"p90\": " << p90
+              << ", \"p99\": " << p99 << ", \"p99_9\": " << p999 << ", \"max\": " << max_latency << "}\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return errors == 0 && failed == 0 ? 0 : 1;
+}
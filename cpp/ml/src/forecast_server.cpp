@@ -0,0 +1,257 @@
+/**
+ * @brief Локальный сервер прогнозов на Unix-сокете
+ *
+ * Держит обученные модели в памяти (ForecastService) вместо запуска
+ * CLI на каждый запрос. Модели берутся из снимка (snapshot_benchmark
+ * пишет data/processed/models.hwm); без снимка обучается одна модель
+ * "traffic" по time_series.csv.
+ *
+ * Один поток, poll(): все строки, пришедшие от всех клиентов за одно
+ * пробуждение, выполняются одним пакетом, ответы каждому клиенту
+ * отправляются одной записью. Протокол - см. ForecastService, плюс
+ * SHUTDOWN - остановить сервер.
+ * Использование: forecast_server [--socket path] [--snapshot file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <vector>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "model_snapshot.h"
+#include "forecast_service.h"
+
+namespace {
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void onSignal(int) {
+    stop_requested = 1;
+}
+
+/**
+ * @brief Соединение с клиентом: непрочитанный хвост и неотправленные ответы
+ */
+struct Client {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    size_t consumed = 0;   ///< Сколько байт input уже разобрано в текущем пакете
+};
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int listenOn(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Ошибка: слишком длинный путь сокета " << path << std::endl;
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Ошибка socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 128) != 0 || !setNonBlocking(fd)) {
+        std::cerr << "Ошибка: не удалось слушать " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Отправляет сколько получится без блокировки
+ * @return false если соединение разорвано
+ */
+bool flush(Client& client) {
+    while (!client.output.empty()) {
+        ssize_t sent = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client.output.erase(0, static_cast<size_t>(sent));
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string socket_path = "/tmp/holt_winters_forecast.sock";
+    std::string snapshot_file = "../../../data/processed/models.hwm";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshot_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== СЕРВЕР ПРОГНОЗОВ HOLT-WINTERS ===" << std::endl;
+
+    ForecastService service;
+    ModelSnapshot snapshot;
+    if (snapshot.open(snapshot_file)) {
+        service.loadSnapshot(snapshot);
+        std::cout << "Моделей из снимка " << snapshot_file << ": " << service.size() << std::endl;
+    } else {
+        TimeSeries ts;
+        if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+            return 1;
+        }
+        HoltWinters model(7);
+        if (!model.fit(ts.view().data(), ts.size(), 0.07, 0.01, 0.07)) {
+            std::cerr << "Ошибка: не удалось обучить модель" << std::endl;
+            return 1;
+        }
+        service.addModel("traffic", model);
+        std::cout << "Снимка нет, обучена модель \"traffic\"" << std::endl;
+    }
+
+    int listen_fd = listenOn(socket_path);
+    if (listen_fd < 0) {
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "Слушаю " << socket_path << std::endl;
+
+    std::vector<Client> clients;
+    std::vector<pollfd> fds;
+    std::vector<std::string_view> batch;
+    std::vector<size_t> batch_client;
+    std::vector<std::string> responses;
+    size_t largest_batch = 0;
+    bool shutdown = false;
+    char buffer[64 * 1024];
+
+    while (!shutdown && !stop_requested) {
+        fds.clear();
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (const auto& client : clients) {
+            short events = POLLIN;
+            if (!client.output.empty()) {
+                events |= POLLOUT;
+            }
+            fds.push_back({client.fd, events, 0});
+        }
+        if (poll(fds.data(), fds.size(), 500) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Ошибка poll: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        // Чтение: все готовые клиенты, затем один пакет на всех
+        batch.clear();
+        batch_client.clear();
+        for (size_t c = 0; c < clients.size(); ++c) {
+            Client& client = clients[c];
+            short revents = fds[c + 1].revents;
+            if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+                if (received > 0) {
+                    client.input.append(buffer, static_cast<size_t>(received));
+                } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    close(client.fd);
+                    client.fd = -1;
+                    continue;
+                }
+            }
+            // Полные строки - в пакет (виды указывают в client.input до конца пакета)
+            size_t line_begin = 0;
+            size_t newline;
+            while ((newline = client.input.find('\n', line_begin)) != std::string::npos) {
+                std::string_view line(client.input.data() + line_begin, newline - line_begin);
+                if (!line.empty() && line.back() == '\r') {
+                    line.remove_suffix(1);
+                }
+                if (line == "SHUTDOWN") {
+                    shutdown = true;
+                } else if (!line.empty()) {
+                    batch.push_back(line);
+                    batch_client.push_back(c);
+                }
+                line_begin = newline + 1;
+            }
+            client.consumed = line_begin;
+        }
+
+        if (!batch.empty()) {
+            service.handleBatch(batch, responses);
+            largest_batch = std::max(largest_batch, batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                std::string& output = clients[batch_client[i]].output;
+                output += responses[i];
+                output += '\n';
+            }
+        }
+
+        // Разобранные строки больше не нужны; ответы - одной записью на клиента
+        for (auto& client : clients) {
+            if (client.fd < 0) {
+                continue;
+            }
+            client.input.erase(0, client.consumed);
+            client.consumed = 0;
+            if (!flush(client)) {
+                close(client.fd);
+                client.fd = -1;
+            }
+        }
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [](const Client& client) { return client.fd < 0; }),
+                      clients.end());
+
+        // Новые клиенты
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listen_fd, nullptr, nullptr)) >= 0) {
+                if (!setNonBlocking(fd)) {
+                    close(fd);
+                    continue;
+                }
+                Client client;
+                client.fd = fd;
+                clients.push_back(std::move(client));
+            }
+        }
+    }
+
+    for (auto& client : clients) {
+        flush(client);
+        close(client.fd);
+    }
+    close(listen_fd);
+    unlink(socket_path.c_str());
+
+    const auto& stats = service.stats();
+    std::cout << "\nЗапросов: " << stats.requests << " (прогнозов: " << stats.forecasts
+              << ", добавлений: " << stats.appends << ", ошибок: " << stats.errors << ")" << std::endl;
+    std::cout << "Пакетов: " << stats.batches << ", средний размер: " << std::fixed << std::setprecision(2)
+              << (stats.batches ? static_cast<double>(stats.requests) / stats.batches : 0.0)
+              << ", наибольший: " << largest_batch
+              << ", прогнозов из пакетного кэша: " << stats.reused << std::endl;
+    return 0;
+}
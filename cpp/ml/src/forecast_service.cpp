@@ -0,0 +1,187 @@
+#include "forecast_service.h"
+#include "model_snapshot.h"
+#include <charconv>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Следующее слово строки (разделитель - пробелы)
+ */
+std::string_view nextToken(std::string_view& line) {
+    size_t begin = line.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        line = {};
+        return {};
+    }
+    size_t end = line.find(' ', begin);
+    if (end == std::string_view::npos) {
+        end = line.size();
+    }
+    std::string_view token = line.substr(begin, end - begin);
+    line.remove_prefix(end);
+    return token;
+}
+
+template <typename T>
+bool parseNumber(std::string_view token, T& value) {
+    if (token.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+    return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void appendNumber(std::string& out, size_t value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+} // namespace
+
+void ForecastService::addModel(const std::string& id, const HoltWinters& model) {
+    if (!model.isFitted()) {
+        throw std::invalid_argument("addModel: модель " + id + " не обучена");
+    }
+    auto [it, inserted] = index.emplace(id, models.size());
+    if (inserted) {
+        models.push_back(model);
+        cached.emplace_back();
+    } else {
+        models[it->second] = model;
+        cached[it->second].batch = 0;
+    }
+}
+
+size_t ForecastService::loadSnapshot(const ModelSnapshot& snapshot) {
+    models.reserve(models.size() + snapshot.size());
+    cached.reserve(cached.size() + snapshot.size());
+    index.reserve(index.size() + snapshot.size());
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        std::string id(snapshot.name(i));
+        if (id.empty()) {
+            id = std::to_string(i);
+        }
+        auto [it, inserted] = index.emplace(id, models.size());
+        if (inserted) {
+            models.push_back(snapshot.model(i));
+            cached.emplace_back();
+        } else {
+            snapshot.restore(i, models[it->second]);
+            cached[it->second].batch = 0;
+        }
+    }
+    return snapshot.size();
+}
+
+HoltWinters* ForecastService::find(std::string_view id, size_t& position) {
+    key.assign(id.data(), id.size());
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    position = it->second;
+    return &models[position];
+}
+
+void ForecastService::handle(std::string_view request, std::string& response) {
+    response.clear();
+    ++counters.requests;
+    std::string_view rest = request;
+    std::string_view command = nextToken(rest);
+
+    if (command == "FORECAST") {
+        std::string_view id = nextToken(rest);
+        int horizon = 0;
+        if (id.empty() || !parseNumber(nextToken(rest), horizon) || horizon <= 0 || horizon > 10000) {
+            ++counters.errors;
+            response = "ERR формат: FORECAST <id> <h>, 0 < h <= 10000";
+            return;
+        }
+        forecast(id, horizon, response);
+    } else if (command == "APPEND") {
+        std::string_view id = nextToken(rest);
+        double value = 0.0;
+        if (id.empty() || !parseNumber(nextToken(rest), value)) {
+            ++counters.errors;
+            response = "ERR формат: APPEND <id> <value>";
+            return;
+        }
+        append(id, value, response);
+    } else if (command == "STATS") {
+        response = "OK ";
+        appendNumber(response, models.size());
+        response += ' ';
+        appendNumber(response, counters.requests);
+        response += ' ';
+        appendNumber(response, counters.batches);
+    } else {
+        ++counters.errors;
+        response = "ERR неизвестная команда";
+    }
+}
+
+void ForecastService::handleBatch(const std::vector<std::string_view>& requests,
+                                  std::vector<std::string>& responses) {
+    ++counters.batches;
+    active_batch = counters.batches;
+    responses.resize(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        handle(requests[i], responses[i]);
+    }
+    active_batch = 0;
+}
+
+void ForecastService::forecast(std::string_view id, int horizon, std::string& response) {
+    size_t position = 0;
+    HoltWinters* model = find(id, position);
+    if (!model) {
+        ++counters.errors;
+        response = "ERR нет модели ";
+        response.append(id.data(), id.size());
+        return;
+    }
+    ++counters.forecasts;
+
+    CachedForecast& entry = cached[position];
+    if (active_batch != 0 && entry.batch == active_batch && entry.horizon == horizon) {
+        ++counters.reused;
+        response = entry.response;
+        return;
+    }
+
+    response = "OK";
+    for (int h = 1; h <= horizon; ++h) {
+        response += ' ';
+        appendNumber(response, model->forecast(h));
+    }
+    if (active_batch != 0) {
+        entry.batch = active_batch;
+        entry.horizon = horizon;
+        entry.response = response;
+    }
+}
+
+void ForecastService::append(std::string_view id, double value, std::string& response) {
+    size_t position = 0;
+    HoltWinters* model = find(id, position);
+    if (!model) {
+        ++counters.errors;
+        response = "ERR нет модели ";
+        response.append(id.data(), id.size());
+        return;
+    }
+    ++counters.appends;
+    model->update(value);
+    // Состояние изменилось: прогнозы этой модели в пакете больше не годятся
+    cached[position].batch = 0;
+    response = "OK ";
+    appendNumber(response, model->getObservations());
+}
@@ -1,125 +1,257 @@
 #include "holt_winters.h"
+#include "series_reader.h"
+#include "holt_winters_mixed.h"
+#include "trace.h"
 #include <cmath>
 #include <stdexcept>
-#include <iostream>
+#include <sstream>
 #include <numeric>
 #include <algorithm>
 
 HoltWinters::HoltWinters(int season_length) 
-    : season_length(season_length), level(0.0), trend(0.0) {
+    : season_length(season_length), level(0.0), trend(0.0), logger(nullptr),
+      alpha(0.0), beta(0.0), gamma(0.0), initial_level(0.0), initial_trend(0.0),
+      season_pos(0), observations(0), fitted(false) {
     if (season_length <= 0) {
         throw std::invalid_argument("season_length должен быть положительным");
     }
+    // Память под сезонность выделяется один раз, fit ее только перезаписывает
+    seasonal.assign(season_length, 0.0);
+}
+
+void HoltWinters::report(FitLogger::Level level, const std::string& message) const {
+    if (logger) {
+        logger->log(level, message);
+    }
 }
 
 bool HoltWinters::validateParameters(double alpha, double beta, double gamma) const {
     if (alpha < 0.0 || alpha > 1.0 || beta < 0.0 || beta > 1.0 || gamma < 0.0 || gamma > 1.0) {
-        std::cerr << "Ошибка: параметры alpha, beta, gamma должны быть в диапазоне [0, 1]" << std::endl;
+        if (logger) {
+            report(FitLogger::Level::Error, "Ошибка: параметры alpha, beta, gamma должны быть в диапазоне [0, 1]");
+        }
         return false;
     }
     return true;
 }
 
-void HoltWinters::initializeComponents(const std::vector<double>& data) {
-    // Простая и стабильная инициализация
-    int n = data.size();
-    
-    // Уровень - среднее всех данных
-    level = std::accumulate(data.begin(), data.end(), 0.0) / n;
-    
-    // Тренд - простой линейный тренд
-    trend = 0.0;
-    if (n > 1) {
-        double sum_x = 0.0, sum_y = 0.0, sum_xy = 0.0, sum_xx = 0.0;
-        for (int i = 0; i < n; ++i) {
-            sum_x += i;
-            sum_y += data[i];
-            sum_xy += i * data[i];
-            sum_xx += i * i;
+void HoltWinters::initializeComponents(const double* data, size_t size) {
+    TRACE_SPAN_VALUE("HoltWinters::initializeComponents", size);
+    // seasonal уже нужного размера (выделен в конструкторе)
+    initialComponents(data, size, season_length, level, trend, seasonal.data());
+}
+
+void HoltWinters::initialComponents(const double* data, size_t size, int season_length,
+                                    double& level, double& trend, double* seasonal) {
+    initialComponentsAs(data, size, season_length, level, trend, seasonal);
+}
+
+bool HoltWinters::fit(const std::vector<double>& data,
+                     double alpha, double beta, double gamma) {
+    return fit(data.data(), data.size(), alpha, beta, gamma);
+}
+
+bool HoltWinters::fit(const double* data, size_t size,
+                     double alpha, double beta, double gamma,
+                     size_t init_size) {
+    TRACE_SPAN_VALUE("HoltWinters::fit", size);
+    if (init_size == 0 || init_size > size) {
+        init_size = size;
+    }
+    if (init_size < 2 * static_cast<size_t>(season_length)) {
+        if (logger) {
+            std::ostringstream message;
+            message << "Ошибка: недостаточно данных для обучения. Нужно минимум "
+                    << 2 * season_length << " точек";
+            report(FitLogger::Level::Error, message.str());
         }
-        trend = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+        return false;
     }
     
-    // Сезонность - отклонения от тренда
-    seasonal.resize(season_length, 0.0);
-    std::vector<int> counts(season_length, 0);
-    
-    for (int i = 0; i < n; ++i) {
-        int season_idx = i % season_length;
-        double expected = level + trend * i;
-        seasonal[season_idx] += data[i] - expected;
-        counts[season_idx]++;
+    if (!validateParameters(alpha, beta, gamma)) {
+        return false;
     }
     
-    // Нормализация сезонности
-    for (int i = 0; i < season_length; ++i) {
-        if (counts[i] > 0) {
-            seasonal[i] /= counts[i];
+    // Инициализация компонент
+    initializeComponents(data, init_size);
+    
+    // Сохраняем начальные значения для контроля
+    initial_level = level;
+    initial_trend = trend;
+    this->alpha = alpha;
+    this->beta = beta;
+    this->gamma = gamma;
+    
+    // Основной цикл обучения (начинаем с season_length, индекс сезона 0)
+    season_pos = 0;
+    {
+        TRACE_SPAN("HoltWinters::fit loop");
+        for (size_t t = season_length; t < size; ++t) {
+            advance(data[t]);
         }
     }
+    observations = size;
+    fitted = true;
     
-    // Центрирование сезонности (сумма = 0)
-    double seasonal_sum = std::accumulate(seasonal.begin(), seasonal.end(), 0.0);
-    double seasonal_mean = seasonal_sum / season_length;
-    for (int i = 0; i < season_length; ++i) {
-        seasonal[i] -= seasonal_mean;
+    if (logger) {
+        std::ostringstream message;
+        message << "Модель Holt-Winters обучена. Параметры: level=" << level
+                << ", trend=" << trend;
+        report(FitLogger::Level::Info, message.str());
     }
+    return true;
 }
 
-bool HoltWinters::fit(const std::vector<double>& data,
-                     double alpha, double beta, double gamma) {
-    if (data.size() < 2 * season_length) {
-        std::cerr << "Ошибка: недостаточно данных для обучения. Нужно минимум " 
-                  << 2 * season_length << " точек" << std::endl;
+bool HoltWinters::fitStream(SeriesReader& reader,
+                            double alpha, double beta, double gamma,
+                            size_t init_seasons, size_t chunk_size) {
+    if (!validateParameters(alpha, beta, gamma)) {
         return false;
     }
-    
-    if (!validateParameters(alpha, beta, gamma)) {
+
+    // 1. Первые init_seasons сезонов - в буфер для инициализации
+    size_t init_size = std::max<size_t>(init_seasons, 2) * season_length;
+    std::vector<double> head(init_size);
+    size_t got = 0;
+    while (got < init_size) {
+        size_t n = reader.read(head.data() + got, init_size - got);
+        if (n == 0) {
+            break;
+        }
+        got += n;
+    }
+    // Ряд короче init_size - как fit по всему ряду
+    if (!fit(head.data(), got, alpha, beta, gamma, got)) {
         return false;
     }
+
+    // 2. Остаток ряда кусками: тот же шаг рекурсии, что в fit
+    std::vector<double> chunk(std::max<size_t>(chunk_size, 1));
+    for (;;) {
+        size_t n = reader.read(chunk.data(), chunk.size());
+        if (n == 0) {
+            break;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            advance(chunk[i]);
+        }
+        observations += n;
+    }
+
+    if (logger) {
+        std::ostringstream message;
+        message << "Потоковое обучение: " << observations << " точек, level=" << level
+                << ", trend=" << trend;
+        report(FitLogger::Level::Info, message.str());
+    }
+    return true;
+}
+
+void HoltWinters::advance(double value) {
+    // Сезон t и t - season_length совпадают: читаем и перезаписываем одну ячейку
+    double& season = seasonal[season_pos];
     
-    // Инициализация компонент
-    initializeComponents(data);
+    // Обновление компонент с защитой от расходимости
+    double new_level = alpha * (value - season) 
+                     + (1 - alpha) * (level + trend);
     
-    // Сохраняем начальные значения для контроля
-    double initial_level = level;
-    double initial_trend = trend;
+    double new_trend = beta * (new_level - level) 
+                     + (1 - beta) * trend;
+    
+    double new_seasonal = gamma * (value - new_level) 
+                        + (1 - gamma) * season;
     
-    // Основной цикл обучения (начинаем с season_length)
-    for (size_t t = season_length; t < data.size(); ++t) {
-        int season_idx = t % season_length;
-        int prev_season_idx = (t - season_length) % season_length;
-        
-        // Временно сохраняем предыдущие значения
-        double prev_level = level;
-        double prev_trend = trend;
-        
-        // Обновление компонент с защитой от расходимости
-        double new_level = alpha * (data[t] - seasonal[prev_season_idx]) 
-                         + (1 - alpha) * (level + trend);
-        
-        double new_trend = beta * (new_level - level) 
-                         + (1 - beta) * trend;
-        
-        double new_seasonal = gamma * (data[t] - new_level) 
-                            + (1 - gamma) * seasonal[prev_season_idx];
-        
-        // Применяем обновления
-        level = new_level;
-        trend = new_trend;
-        seasonal[season_idx] = new_seasonal;
-        
-        // Защита от расходимости - если значения уходят в отрицательные, сбрасываем
-        if (level < 0 || std::abs(level) > 10000) {
-            std::cout << "Предупреждение: уровень расходится, сброс к начальным значениям" << std::endl;
-            level = initial_level;
-            trend = initial_trend;
+    // Применяем обновления
+    level = new_level;
+    trend = new_trend;
+    season = new_seasonal;
+    
+    // Защита от расходимости - если значения уходят в отрицательные, сбрасываем
+    if (level < 0 || std::abs(level) > kDivergenceLimit) {
+        if (logger) {
+            report(FitLogger::Level::Warning, "Предупреждение: уровень расходится, сброс к начальным значениям");
         }
+        level = initial_level;
+        trend = initial_trend;
     }
     
-    std::cout << "Модель Holt-Winters обучена. Параметры: level=" << level 
-              << ", trend=" << trend << std::endl;
-    return true;
+    if (++season_pos == season_length) {
+        season_pos = 0;
+    }
+}
+
+void HoltWinters::update(double observation) {
+    if (!fitted) {
+        throw std::logic_error("update: модель еще не обучена");
+    }
+    advance(observation);
+    ++observations;
+}
+
+double HoltWinters::forecast(int h) const {
+    if (!fitted) {
+        throw std::logic_error("forecast: модель еще не обучена");
+    }
+    if (h <= 0) {
+        throw std::invalid_argument("h должен быть положительным");
+    }
+    // Сезон шага h считается от фазы следующего наблюдения
+    int season_idx = (season_pos + h - 1) % season_length;
+    double value = level + h * trend + seasonal[season_idx];
+    // Защита от отрицательных прогнозов
+    return std::max(value, 0.0);
+}
+
+HoltWinters::State HoltWinters::getState() const {
+    State state;
+    state.level = level;
+    state.trend = trend;
+    state.seasonal = seasonal;
+    state.season_pos = season_pos;
+    state.observations = observations;
+    return state;
+}
+
+void HoltWinters::setState(const State& state) {
+    if (state.seasonal.size() != seasonal.size()) {
+        throw std::invalid_argument("Снимок состояния от модели с другой длиной сезона");
+    }
+    level = state.level;
+    trend = state.trend;
+    std::copy(state.seasonal.begin(), state.seasonal.end(), seasonal.begin());
+    season_pos = state.season_pos;
+    observations = state.observations;
+}
+
+HoltWinters::Parameters HoltWinters::getParameters() const {
+    Parameters parameters;
+    parameters.alpha = alpha;
+    parameters.beta = beta;
+    parameters.gamma = gamma;
+    parameters.initial_level = initial_level;
+    parameters.initial_trend = initial_trend;
+    return parameters;
+}
+
+void HoltWinters::restore(const Parameters& parameters, double level, double trend,
+                          const double* seasonal, int season_pos, size_t observations) {
+    if (!validateParameters(parameters.alpha, parameters.beta, parameters.gamma)) {
+        throw std::invalid_argument("restore: параметры сглаживания должны быть в [0, 1]");
+    }
+    if (season_pos < 0 || season_pos >= season_length) {
+        throw std::invalid_argument("restore: season_pos вне сезона");
+    }
+    alpha = parameters.alpha;
+    beta = parameters.beta;
+    gamma = parameters.gamma;
+    initial_level = parameters.initial_level;
+    initial_trend = parameters.initial_trend;
+    this->level = level;
+    this->trend = trend;
+    std::copy(seasonal, seasonal + season_length, this->seasonal.begin());
+    this->season_pos = season_pos;
+    this->observations = observations;
+    fitted = true;
 }
 
 std::vector<double> HoltWinters::predict(int horizon) const {
@@ -127,15 +259,21 @@ std::vector<double> HoltWinters::predict(int horizon) const {
         throw std::invalid_argument("horizon должен быть положительным");
     }
     
-    std::vector<double> predictions;
-    predictions.reserve(horizon);
-    
-    for (int h = 1; h <= horizon; ++h) {
+    std::vector<double> predictions(horizon);
+    predictInto(horizon, predictions.data());
+    return predictions;
+}
+
+void HoltWinters::predictInto(int horizon, double* out) const {
+    TRACE_SPAN_VALUE("HoltWinters::predict", horizon);
+    predictRange(1, horizon, out);
+}
+
+void HoltWinters::predictRange(int first_step, int count, double* out) const {
+    for (int h = first_step; h < first_step + count; ++h) {
         int season_idx = (season_length + h - 1) % season_length;
         double forecast = level + h * trend + seasonal[season_idx];
         // Защита от отрицательных прогнозов
-        predictions.push_back(std::max(forecast, 0.0));
+        out[h - first_step] = std::max(forecast, 0.0);
     }
-    
-    return predictions;
 }
\ No newline at end of file
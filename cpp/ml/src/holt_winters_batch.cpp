@@ -0,0 +1,153 @@
+#include "holt_winters_batch.h"
+#include "holt_winters.h"
+#include "simd_lanes.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+using simd_lanes::Lanes;
+
+/**
+ * @brief Основной цикл Holt-Winters сразу для всех дорожек
+ *
+ * Повторяет HoltWinters::fit операция в операцию, поэтому результат
+ * каждой дорожки совпадает со скалярным обучением.
+ */
+void fitLanes(const double* data, size_t size, int season_length,
+              const double* alphas, const double* betas, const double* gammas,
+              double* level, double* trend, double* seasonal) {
+    using Vec = Lanes::Vec;
+    const size_t lanes = HoltWintersBatch::kLanes;
+
+    const Vec one = Lanes::set1(1.0);
+    const Vec alpha = Lanes::load(alphas);
+    const Vec beta = Lanes::load(betas);
+    const Vec gamma = Lanes::load(gammas);
+    const Vec one_alpha = Lanes::sub(one, alpha);
+    const Vec one_beta = Lanes::sub(one, beta);
+    const Vec one_gamma = Lanes::sub(one, gamma);
+    const Vec limit = Lanes::set1(HoltWinters::kDivergenceLimit);
+
+    const Vec initial_level = Lanes::load(level);
+    const Vec initial_trend = Lanes::load(trend);
+    Vec lvl = initial_level;
+    Vec trd = initial_trend;
+
+    // t % season_length без деления: индекс сезона идет по кругу
+    size_t season_idx = 0;
+    for (size_t t = season_length; t < size; ++t) {
+        double* s_ptr = seasonal + season_idx * lanes;
+        const Vec x = Lanes::set1(data[t]);
+        const Vec s = Lanes::load(s_ptr);
+
+        Vec new_level = Lanes::add(Lanes::mul(alpha, Lanes::sub(x, s)),
+                                   Lanes::mul(one_alpha, Lanes::add(lvl, trd)));
+        Vec new_trend = Lanes::add(Lanes::mul(beta, Lanes::sub(new_level, lvl)),
+                                   Lanes::mul(one_beta, trd));
+        Vec new_seasonal = Lanes::add(Lanes::mul(gamma, Lanes::sub(x, new_level)),
+                                      Lanes::mul(one_gamma, s));
+
+        Lanes::store(s_ptr, new_seasonal);
+
+        // Защита от расходимости, как в HoltWinters::fit, но по каждой дорожке отдельно
+        auto mask = Lanes::diverged(new_level, limit);
+        lvl = Lanes::select(mask, initial_level, new_level);
+        trd = Lanes::select(mask, initial_trend, new_trend);
+
+        if (++season_idx == static_cast<size_t>(season_length)) {
+            season_idx = 0;
+        }
+    }
+
+    Lanes::store(level, lvl);
+    Lanes::store(trend, trd);
+}
+
+} // namespace
+
+HoltWintersBatch::HoltWintersBatch(int season_length)
+    : season_length(season_length), active(0), level{}, trend{} {
+    if (season_length <= 0) {
+        throw std::invalid_argument("season_length должен быть положительным");
+    }
+    seasonal.assign(static_cast<size_t>(season_length) * kLanes, 0.0);
+    initial_seasonal.assign(season_length, 0.0);
+}
+
+const char* HoltWintersBatch::backendName() {
+    return simd_lanes::backendName();
+}
+
+bool HoltWintersBatch::fit(const double* data, size_t size,
+                           const double* alphas, const double* betas, const double* gammas,
+                           size_t count) {
+    if (count == 0 || count > kLanes) {
+        throw std::invalid_argument("Количество наборов параметров должно быть от 1 до kLanes");
+    }
+    if (size < 2 * static_cast<size_t>(season_length)) {
+        return false;
+    }
+    for (size_t lane = 0; lane < count; ++lane) {
+        if (alphas[lane] < 0.0 || alphas[lane] > 1.0 ||
+            betas[lane] < 0.0 || betas[lane] > 1.0 ||
+            gammas[lane] < 0.0 || gammas[lane] > 1.0) {
+            return false;
+        }
+    }
+
+    // Свободные дорожки повторяют первую: так в регистрах нет мусора
+    alignas(64) double lane_alpha[kLanes];
+    alignas(64) double lane_beta[kLanes];
+    alignas(64) double lane_gamma[kLanes];
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        size_t src = lane < count ? lane : 0;
+        lane_alpha[lane] = alphas[src];
+        lane_beta[lane] = betas[src];
+        lane_gamma[lane] = gammas[src];
+    }
+
+    // Начальное состояние зависит только от данных - считаем его один раз
+    double initial_level = 0.0;
+    double initial_trend = 0.0;
+    HoltWinters::initialComponents(data, size, season_length,
+                                   initial_level, initial_trend, initial_seasonal.data());
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        level[lane] = initial_level;
+        trend[lane] = initial_trend;
+    }
+    for (int s = 0; s < season_length; ++s) {
+        std::fill(seasonal.begin() + s * kLanes, seasonal.begin() + (s + 1) * kLanes,
+                  initial_seasonal[s]);
+    }
+
+    fitLanes(data, size, season_length, lane_alpha, lane_beta, lane_gamma,
+             level, trend, seasonal.data());
+    active = count;
+    return true;
+}
+
+void HoltWintersBatch::predictInto(size_t lane, int horizon, double* out) const {
+    predictRange(lane, 1, horizon, out);
+}
+
+void HoltWintersBatch::predictRange(size_t lane, int first_step, int count, double* out) const {
+    for (int h = first_step; h < first_step + count; ++h) {
+        int season_idx = (season_length + h - 1) % season_length;
+        double forecast = level[lane] + h * trend[lane] + seasonal[season_idx * kLanes + lane];
+        // Защита от отрицательных прогнозов
+        out[h - first_step] = std::max(forecast, 0.0);
+    }
+}
+
+std::vector<double> HoltWintersBatch::predictAll(int horizon) const {
+    if (horizon <= 0) {
+        throw std::invalid_argument("horizon должен быть положительным");
+    }
+    std::vector<double> out(active * horizon);
+    for (size_t lane = 0; lane < active; ++lane) {
+        predictInto(lane, horizon, out.data() + lane * horizon);
+    }
+    return out;
+}
@@ -0,0 +1,239 @@
+#include "holt_winters_fleet.h"
+#include "holt_winters.h"
+#include "simd_lanes.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Раздает блоки [begin, end) потокам через атомарный счетчик
+ */
+template <typename Fn>
+void forEachBlock(size_t count, size_t block_size, size_t num_threads, Fn&& fn) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    block_size = std::max<size_t>(1, block_size);
+    size_t num_blocks = (count + block_size - 1) / block_size;
+    num_threads = std::max<size_t>(1, std::min(num_threads, num_blocks));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (;;) {
+            size_t block = next.fetch_add(1);
+            if (block >= num_blocks) {
+                break;
+            }
+            size_t begin = block * block_size;
+            TRACE_SPAN_VALUE("HoltWintersFleet block", begin);
+            fn(begin, std::min(begin + block_size, count));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+HoltWintersFleet::HoltWintersFleet(size_t num_series, size_t length, int season_length)
+    : num_series(num_series), series_length(length), season_length(season_length),
+      train_length(0), season_pos(0) {
+    if (season_length <= 0) {
+        throw std::invalid_argument("season_length должен быть положительным");
+    }
+    if (num_series == 0 || length == 0) {
+        throw std::invalid_argument("Парк должен содержать хотя бы один непустой ряд");
+    }
+    values.assign(num_series * length, 0.0);
+    alpha.assign(num_series, 0.3);
+    beta.assign(num_series, 0.1);
+    gamma.assign(num_series, 0.1);
+    level.assign(num_series, 0.0);
+    trend.assign(num_series, 0.0);
+    initial_level.assign(num_series, 0.0);
+    initial_trend.assign(num_series, 0.0);
+    seasonal.assign(static_cast<size_t>(season_length) * num_series, 0.0);
+}
+
+void HoltWintersFleet::setSeries(size_t i, const double* data) {
+    for (size_t t = 0; t < series_length; ++t) {
+        values[t * num_series + i] = data[t];
+    }
+}
+
+void HoltWintersFleet::setParameters(double a, double b, double g) {
+    for (size_t i = 0; i < num_series; ++i) {
+        setParameters(i, a, b, g);
+    }
+}
+
+void HoltWintersFleet::setParameters(size_t i, double a, double b, double g) {
+    if (a < 0.0 || a > 1.0 || b < 0.0 || b > 1.0 || g < 0.0 || g > 1.0) {
+        throw std::invalid_argument("Параметры alpha, beta, gamma должны быть в диапазоне [0, 1]");
+    }
+    alpha[i] = a;
+    beta[i] = b;
+    gamma[i] = g;
+}
+
+void HoltWintersFleet::fit(size_t train, size_t num_threads, size_t block_size) {
+    if (train < 2 * static_cast<size_t>(season_length) || train > series_length) {
+        throw std::invalid_argument("train_length должен быть в [2 * season_length, length]");
+    }
+    train_length = train;
+    forEachBlock(num_series, block_size, num_threads,
+                 [this](size_t begin, size_t end) { fitBlock(begin, end); });
+    // Фаза одна на весь парк: все ряды начинаются в один день
+    season_pos = static_cast<int>(train_length % season_length);
+}
+
+void HoltWintersFleet::fitBlock(size_t begin, size_t end) {
+    const size_t N = num_series;
+    const size_t L = season_length;
+
+    // Начальные значения по каждому ряду отдельно (нужен непрерывный ряд)
+    std::vector<double> column(train_length);
+    std::vector<double> column_seasonal(L);
+    for (size_t i = begin; i < end; ++i) {
+        for (size_t t = 0; t < train_length; ++t) {
+            column[t] = values[t * N + i];
+        }
+        HoltWinters::initialComponents(column.data(), train_length, season_length,
+                                       initial_level[i], initial_trend[i], column_seasonal.data());
+        level[i] = initial_level[i];
+        trend[i] = initial_trend[i];
+        for (size_t s = 0; s < L; ++s) {
+            seasonal[s * N + i] = column_seasonal[s];
+        }
+    }
+
+    const double* a = alpha.data();
+    const double* b = beta.data();
+    const double* g = gamma.data();
+    const double* init_level = initial_level.data();
+    const double* init_trend = initial_trend.data();
+    double* lv = level.data();
+    double* tr = trend.data();
+
+    using simd_lanes::Lanes;
+    using Vec = Lanes::Vec;
+    const size_t W = simd_lanes::kWidth;
+    const Vec one = Lanes::set1(1.0);
+    const Vec limit = Lanes::set1(HoltWinters::kDivergenceLimit);
+    // Без AVX ряды обновляются обычным циклом: эмуляция дорожек здесь только мешает
+    const size_t vec_end = simd_lanes::kVectorized ? begin + (end - begin) / W * W : begin;
+
+    // Рекурсия блоком: шаг t для всех рядов блока, данные строки t идут подряд
+    size_t pos = 0;
+    for (size_t t = L; t < train_length; ++t) {
+        const double* x = values.data() + t * N;
+        double* s = seasonal.data() + pos * N;
+
+        // Те же формулы, что в HoltWinters::advance, по W рядов за раз
+        for (size_t i = begin; i < vec_end; i += W) {
+            Vec xv = Lanes::load(x + i);
+            Vec season = Lanes::load(s + i);
+            Vec av = Lanes::load(a + i);
+            Vec bv = Lanes::load(b + i);
+            Vec gv = Lanes::load(g + i);
+            Vec lvl = Lanes::load(lv + i);
+            Vec trd = Lanes::load(tr + i);
+
+            Vec new_level = Lanes::add(Lanes::mul(av, Lanes::sub(xv, season)),
+                                       Lanes::mul(Lanes::sub(one, av), Lanes::add(lvl, trd)));
+            Vec new_trend = Lanes::add(Lanes::mul(bv, Lanes::sub(new_level, lvl)),
+                                       Lanes::mul(Lanes::sub(one, bv), trd));
+            Lanes::store(s + i, Lanes::add(Lanes::mul(gv, Lanes::sub(xv, new_level)),
+                                           Lanes::mul(Lanes::sub(one, gv), season)));
+
+            auto mask = Lanes::diverged(new_level, limit);
+            Lanes::store(lv + i, Lanes::select(mask, Lanes::load(init_level + i), new_level));
+            Lanes::store(tr + i, Lanes::select(mask, Lanes::load(init_trend + i), new_trend));
+        }
+        for (size_t i = vec_end; i < end; ++i) {
+            double season = s[i];
+            double new_level = a[i] * (x[i] - season) + (1 - a[i]) * (lv[i] + tr[i]);
+            double new_trend = b[i] * (new_level - lv[i]) + (1 - b[i]) * tr[i];
+            s[i] = g[i] * (x[i] - new_level) + (1 - g[i]) * season;
+            bool diverged = new_level < 0 || std::abs(new_level) > HoltWinters::kDivergenceLimit;
+            lv[i] = diverged ? init_level[i] : new_level;
+            tr[i] = diverged ? init_trend[i] : new_trend;
+        }
+        if (++pos == L) {
+            pos = 0;
+        }
+    }
+}
+
+void HoltWintersFleet::forecastInto(size_t i, int horizon, double* out) const {
+    for (int h = 1; h <= horizon; ++h) {
+        int season_idx = (season_pos + h - 1) % season_length;
+        double forecast = level[i] + h * trend[i] + seasonal[season_idx * num_series + i];
+        // Защита от отрицательных прогнозов
+        out[h - 1] = std::max(forecast, 0.0);
+    }
+}
+
+std::vector<SeriesMetrics> HoltWintersFleet::evaluate(size_t num_threads, size_t block_size) const {
+    if (train_length == 0) {
+        throw std::logic_error("evaluate: парк еще не обучен");
+    }
+    if (train_length == series_length) {
+        throw std::invalid_argument("evaluate: нет тестовой части");
+    }
+
+    const size_t N = num_series;
+    const size_t horizon = series_length - train_length;
+    std::vector<SeriesMetrics> metrics(N);
+
+    forEachBlock(N, block_size, num_threads, [&](size_t begin, size_t end) {
+        size_t count = end - begin;
+        std::vector<double> abs_error(count, 0.0);
+        std::vector<double> sq_error(count, 0.0);
+        std::vector<double> abs_actual(count, 0.0);
+
+        // Шаг h для всех рядов блока: фактические значения строки идут подряд
+        for (size_t h = 1; h <= horizon; ++h) {
+            const double* actual = values.data() + (train_length + h - 1) * N;
+            const double* s = seasonal.data() + ((season_pos + h - 1) % season_length) * N;
+            for (size_t i = begin; i < end; ++i) {
+                double forecast = std::max(level[i] + h * trend[i] + s[i], 0.0);
+                double error = actual[i] - forecast;
+                abs_error[i - begin] += std::abs(error);
+                sq_error[i - begin] += error * error;
+                abs_actual[i - begin] += std::abs(actual[i]);
+            }
+        }
+
+        for (size_t k = 0; k < count; ++k) {
+            SeriesMetrics& m = metrics[begin + k];
+            // Ряд из одних нулей: WAPE не определен, Metrics::wape бросил бы исключение
+            m.wape = abs_actual[k] > 0.0 ? abs_error[k] / abs_actual[k] * 100.0
+                                         : std::numeric_limits<double>::quiet_NaN();
+            m.mae = abs_error[k] / horizon;
+            m.rmse = std::sqrt(sq_error[k] / horizon);
+        }
+    });
+
+    return metrics;
+}
+
+size_t HoltWintersFleet::memoryBytes() const {
+    size_t doubles = values.capacity() + alpha.capacity() + beta.capacity() + gamma.capacity() +
+                     level.capacity() + trend.capacity() + initial_level.capacity() +
+                     initial_trend.capacity() + seasonal.capacity();
+    return doubles * sizeof(double);
+}
@@ -1,34 +1,48 @@
 /**
  * @brief Основная программа для тестирования алгоритма Holt-Winters
  * 
- * Загружает данные, обучает модель и оценивает качество прогноза
+ * Загружает данные, обучает модель и оценивает качество прогноза.
+ * Использование: holt_winters_main [--trace file] - с --trace этапы
+ * пишутся в Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
  */
 #include <iostream>
 #include <vector>
 #include "time_series.h"
 #include "holt_winters.h"
 #include "metrics.h"
+#include "trace.h"
 
 /**
  * @brief Основная функция
  * @return код завершения программы
  */
-int main() {
+int main(int argc, char* argv[]) {
+    std::string trace_file;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc) {
+            trace_file = argv[++i];
+        }
+    }
+    if (!trace_file.empty()) {
+        trace::start();
+    }
+
     std::cout << "=== ТЕСТИРОВАНИЕ HOLT-WINTERS ===" << std::endl;
     
-    // 1. Загрузка данных
+    // 1. Загрузка данных (из time_series.hws, если его собрал build_store)
     TimeSeries ts;
     std::string data_file = "../../../data/processed/time_series.csv";
     
     std::cout << "Загрузка данных из: " << data_file << std::endl;
-    if (!ts.loadFromCSV(data_file)) {
+    if (!ts.load(data_file)) {
         std::cerr << "Не удалось загрузить данные!" << std::endl;
         return 1;
     }
     
     // 2. Разделение на обучающую и тестовую выборки
     std::cout << "Разделение данных (80% train, 20% test)..." << std::endl;
-    auto [train_data, test_data] = ts.split(0.7);
+    auto [train_data, test_data] = ts.splitView(0.7);
     
     std::cout << "Обучающая выборка: " << train_data.size() << " точек" << std::endl;
     std::cout << "Тестовая выборка: " << test_data.size() << " точек" << std::endl;
@@ -36,8 +50,10 @@ int main() {
     // 3. Обучение модели Holt-Winters
     std::cout << "\nОбучение модели Holt-Winters..." << std::endl;
     HoltWinters model(7); // недельная сезонность
+    ConsoleFitLogger console_logger;
+    model.setLogger(&console_logger);
     
-    if (!model.fit(train_data, 0.07, 0.01, 0.07)) {
+    if (!model.fit(train_data.data(), train_data.size(), 0.07, 0.01, 0.07)) {
         std::cerr << "Ошибка обучения модели!" << std::endl;
         return 1;
     }
@@ -49,13 +65,18 @@ int main() {
     // 5. Оценка качества
     std::cout << "\n=== РЕЗУЛЬТАТЫ ===" << std::endl;
     
-    double wape_value = Metrics::wape(test_data, predictions);
-    double mae_value = Metrics::mae(test_data, predictions);
-    double rmse_value = Metrics::rmse(test_data, predictions);
+    ErrorStats stats = Metrics::all(test_data.data(), predictions.data(), test_data.size(),
+                                    train_data.data(), train_data.size(), 7);
+    double wape_value = stats.wape;
+    double mae_value = stats.mae;
+    double rmse_value = stats.rmse;
     
     std::cout << "WAPE: " << wape_value << "%" << std::endl;
     std::cout << "MAE: " << mae_value << std::endl;
     std::cout << "RMSE: " << rmse_value << std::endl;
+    std::cout << "MAPE: " << stats.mape << "%" << std::endl;
+    std::cout << "sMAPE: " << stats.smape << "%" << std::endl;
+    std::cout << "MASE: " << stats.mase << std::endl;
     
     // 6. Проверка критерия успеха
     std::cout << "\n=== КРИТЕРИЙ УСПЕХА ===" << std::endl;
@@ -78,6 +99,14 @@ int main() {
         std::cout << predictions[i] << " ";
     }
     std::cout << std::endl;
+
+    if (!trace_file.empty()) {
+        trace::stop();
+        if (!trace::writeChromeJson(trace_file)) {
+            return 1;
+        }
+        std::cout << "\nТрасса сохранена в " << trace_file << std::endl;
+    }
     
     return 0;
 }
\ No newline at end of file
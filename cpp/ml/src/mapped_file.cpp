@@ -0,0 +1,84 @@
+#include "mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <algorithm>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : address(other.address), length(other.length), opened(other.opened) {
+    other.address = nullptr;
+    other.length = 0;
+    other.opened = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(address, other.address);
+        std::swap(length, other.length);
+        std::swap(opened, other.opened);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& filename, bool sequential) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        address = mapped;
+        if (sequential) {
+            madvise(address, length, MADV_SEQUENTIAL);
+        }
+    }
+
+    // Отображение остается действительным после закрытия дескриптора
+    ::close(fd);
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (address) {
+        munmap(address, length);
+    }
+    address = nullptr;
+    length = 0;
+    opened = false;
+}
+
+void MappedFile::release(size_t offset, size_t count) {
+    if (!address || offset >= length) {
+        return;
+    }
+    count = std::min(count, length - offset);
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t begin = (offset + page - 1) / page * page;
+    size_t end = (offset + count) / page * page;
+    if (end > begin) {
+        madvise(static_cast<char*>(address) + begin, end - begin, MADV_DONTNEED);
+    }
+}
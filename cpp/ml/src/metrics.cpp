@@ -1,7 +1,11 @@
 #include "metrics.h"
+#include "trace.h"
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
+#include <cfloat>
+#include <limits>
 
 /**
  * @brief Проверяет что векторы одинакового размера
@@ -78,4 +82,256 @@ double Metrics::rmse(const std::vector<double>& actual,
     }
     
     return std::sqrt(sum_squared_error / actual.size());
-}
\ No newline at end of file
+}
+namespace {
+
+/**
+ * @brief Ширина блока суммирования: kLanes независимых дорожек
+ *
+ * Дорожки не зависят друг от друга, поэтому компилятор раскладывает
+ * цикл по ним в SIMD-регистры без -ffast-math.
+ */
+constexpr size_t kLanes = 8;
+
+/**
+ * @brief Точек на блок: внутри блока - обычные суммы по дорожкам,
+ * между блоками - суммирование Кэхэна частичных сумм
+ */
+constexpr size_t kBlock = 16 * kLanes;
+
+/**
+ * @brief Суммы Кэхэна по дорожкам
+ */
+struct LaneSum {
+    double sum[kLanes] = {};
+    double comp[kLanes] = {};
+
+    void add(const double* x) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            double y = x[l] - comp[l];
+            double t = sum[l] + y;
+            comp[l] = (t - sum[l]) - y;
+            sum[l] = t;
+        }
+    }
+
+    double total() const {
+        double s = 0.0, c = 0.0;
+        for (size_t l = 0; l < kLanes; ++l) {
+            double y = (sum[l] - comp[l]) - c;
+            double t = s + y;
+            c = (t - s) - y;
+            s = t;
+        }
+        return s;
+    }
+};
+
+/**
+ * @brief Итоговые суммы одного прохода
+ */
+struct ErrorSums {
+    double abs_err = 0.0;
+    double sq_err = 0.0;
+    double ape = 0.0;
+    double sape = 0.0;
+    double abs_actual = 0.0;
+    double nonzero = 0.0;
+};
+
+/**
+ * @brief Один проход: ошибки прогноза и суммы по actual
+ *
+ * Ветвлений нет: при a == 0 вклад в MAPE обнуляется умножением,
+ * при |a| + |p| == 0 ошибка тоже 0, и деление на DBL_MIN дает 0.
+ */
+ErrorSums sumErrors(const double* __restrict actual, const double* __restrict predicted, size_t size) {
+    LaneSum abs_err, sq_err, ape, sape, abs_actual, nonzero;
+
+    double b_abs[kLanes], b_sq[kLanes], b_ape[kLanes], b_sape[kLanes], b_act[kLanes], b_nz[kLanes];
+    auto lanes = [&](const double* __restrict a, const double* __restrict p) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            double abs_a = std::abs(a[l]);
+            double err = std::abs(a[l] - p[l]);
+            double denom = std::max(abs_a + std::abs(p[l]), DBL_MIN);
+            double inv_a = (a[l] != 0.0 ? 1.0 : 0.0) / std::max(abs_a, DBL_MIN);
+            b_abs[l] += err;
+            b_sq[l] += err * err;
+            b_ape[l] += err * inv_a;
+            b_sape[l] += 2.0 * err / denom;
+            b_act[l] += abs_a;
+            b_nz[l] += a[l] != 0.0 ? 1.0 : 0.0;
+        }
+    };
+    auto flush = [&] {
+        abs_err.add(b_abs);
+        sq_err.add(b_sq);
+        ape.add(b_ape);
+        sape.add(b_sape);
+        abs_actual.add(b_act);
+        nonzero.add(b_nz);
+    };
+    auto reset = [&] {
+        std::fill(b_abs, b_abs + kLanes, 0.0);
+        std::fill(b_sq, b_sq + kLanes, 0.0);
+        std::fill(b_ape, b_ape + kLanes, 0.0);
+        std::fill(b_sape, b_sape + kLanes, 0.0);
+        std::fill(b_act, b_act + kLanes, 0.0);
+        std::fill(b_nz, b_nz + kLanes, 0.0);
+    };
+
+    size_t t = 0;
+    const size_t full = size - size % kLanes;
+    while (t < full) {
+        reset();
+        size_t block_end = std::min(full, t + kBlock);
+        for (; t < block_end; t += kLanes) {
+            lanes(actual + t, predicted + t);
+        }
+        flush();
+    }
+    if (t < size) {
+        // Хвост дополняется нулями: нулевые точки не меняют суммы
+        double a[kLanes] = {}, p[kLanes] = {};
+        std::copy(actual + t, actual + size, a);
+        std::copy(predicted + t, predicted + size, p);
+        reset();
+        lanes(a, p);
+        flush();
+    }
+
+    ErrorSums sums;
+    sums.abs_err = abs_err.total();
+    sums.sq_err = sq_err.total();
+    sums.ape = ape.total();
+    sums.sape = sape.total();
+    sums.abs_actual = abs_actual.total();
+    sums.nonzero = nonzero.total();
+    return sums;
+}
+
+/**
+ * @brief Знаменатель MASE: средняя |y[t] - y[t - m]| на обучающей выборке
+ */
+double naiveScale(const double* insample, size_t insample_size, int season_length) {
+    size_t m = static_cast<size_t>(std::max(1, season_length));
+    if (insample == nullptr || insample_size <= m) {
+        return std::nan("");
+    }
+    double sum = 0.0, comp = 0.0;
+    for (size_t t = m; t < insample_size; ++t) {
+        double y = std::abs(insample[t] - insample[t - m]) - comp;
+        double s = sum + y;
+        comp = (s - sum) - y;
+        sum = s;
+    }
+    return sum / (insample_size - m);
+}
+
+ErrorStats finish(const ErrorSums& sums, size_t size, double scale) {
+    const double n = static_cast<double>(size);
+    const double nan = std::nan("");
+    ErrorStats stats;
+    stats.wape = sums.abs_actual != 0.0 ? sums.abs_err / sums.abs_actual * 100.0 : nan;
+    stats.mae = sums.abs_err / n;
+    stats.rmse = std::sqrt(sums.sq_err / n);
+    stats.mape = sums.nonzero > 0.0 ? sums.ape / sums.nonzero * 100.0 : nan;
+    stats.smape = sums.sape / n * 100.0;
+    stats.mase = scale > 0.0 ? stats.mae / scale : nan;
+    return stats;
+}
+
+} // namespace
+
+double Metrics::mape(const std::vector<double>& actual,
+                     const std::vector<double>& predicted) {
+    double value = all(actual, predicted).mape;
+    if (std::isnan(value)) {
+        throw std::runtime_error("Все фактические значения равны 0, MAPE не может быть вычислен");
+    }
+    return value;
+}
+
+double Metrics::smape(const std::vector<double>& actual,
+                      const std::vector<double>& predicted) {
+    return all(actual, predicted).smape;
+}
+
+double Metrics::mase(const std::vector<double>& actual,
+                     const std::vector<double>& predicted,
+                     const std::vector<double>& insample,
+                     int season_length) {
+    double value = all(actual, predicted, insample, season_length).mase;
+    if (std::isnan(value)) {
+        throw std::runtime_error("Ошибка наивного прогноза на обучающей выборке равна 0 "
+                                 "или выборка короче сезона, MASE не может быть вычислен");
+    }
+    return value;
+}
+
+ErrorStats Metrics::all(const std::vector<double>& actual,
+                        const std::vector<double>& predicted,
+                        const std::vector<double>& insample,
+                        int season_length) {
+    validateInputs(actual, predicted);
+    return all(actual.data(), predicted.data(), actual.size(),
+               insample.empty() ? nullptr : insample.data(), insample.size(), season_length);
+}
+
+ErrorStats Metrics::all(const double* actual, const double* predicted, size_t size,
+                        const double* insample, size_t insample_size,
+                        int season_length) {
+    TRACE_SPAN_VALUE("Metrics::all", size);
+    if (size == 0) {
+        throw std::invalid_argument("Векторы не должны быть пустыми");
+    }
+    ErrorSums sums = sumErrors(actual, predicted, size);
+    return finish(sums, size, naiveScale(insample, insample_size, season_length));
+}
+
+void Metrics::allBatch(const double* actual, size_t size,
+                       const double* forecasts, size_t num_forecasts,
+                       ErrorStats* out,
+                       const double* insample, size_t insample_size,
+                       int season_length) {
+    if (size == 0) {
+        throw std::invalid_argument("Векторы не должны быть пустыми");
+    }
+    // Знаменатель MASE - один на пакет; actual остается в L1 между прогнозами
+    double scale = naiveScale(insample, insample_size, season_length);
+    for (size_t k = 0; k < num_forecasts; ++k) {
+        out[k] = finish(sumErrors(actual, forecasts + k * size, size), size, scale);
+    }
+}
+
+WapeAccumulator::WapeAccumulator(const double* actual, size_t size)
+    : actual(actual), length(size) {
+    if (size == 0) {
+        throw std::invalid_argument("Векторы не должны быть пустыми");
+    }
+    for (size_t i = 0; i < size; ++i) {
+        sum_actual += std::abs(actual[i]);
+    }
+    if (sum_actual == 0.0) {
+        throw std::runtime_error("Сумма фактических значений равна 0, WAPE не может быть вычислен");
+    }
+    reset(std::numeric_limits<double>::infinity());
+}
+
+void WapeAccumulator::reset(double bound_wape) {
+    abs_error = 0.0;
+    position = 0;
+    exceeded = false;
+    // Запас на округление: кандидат с WAPE, равным границе, не отбрасывается
+    limit = bound_wape / 100.0 * sum_actual * (1.0 + 1e-12);
+}
+
+bool WapeAccumulator::add(const double* predicted, size_t count) {
+    count = std::min(count, length - position);
+    for (size_t i = 0; i < count; ++i) {
+        abs_error += std::abs(actual[position + i] - predicted[i]);
+    }
+    position += count;
+    exceeded = abs_error > limit;
+    return !exceeded;
+}
@@ -0,0 +1,195 @@
+/**
+ * @brief Метрики за один проход (Metrics::all, Metrics::allBatch)
+ * против трех отдельных вызовов wape + mae + rmse
+ *
+ * Использование: metrics_benchmark [--repeat R] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <algorithm>
+#include "metrics.h"
+
+namespace {
+
+/**
+ * @brief Лучшее время fn() в наносекундах
+ */
+template <typename Fn>
+double bestNs(int repeat, Fn&& fn) {
+    double best = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    return best;
+}
+
+struct SizeResult {
+    size_t size = 0;
+    double separate_ns_per_point = 0.0;
+    double fused_ns_per_point = 0.0;
+};
+
+volatile double sink = 0.0;
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/metrics_benchmark.json";
+    int repeat = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== МЕТРИКИ ЗА ОДИН ПРОХОД ===" << std::endl;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> value(100.0, 1000.0);
+    std::normal_distribution<double> noise(0.0, 50.0);
+
+    // 1. wape + mae + rmse против all() (all считает еще MAPE, sMAPE, MASE)
+    std::vector<SizeResult> sizes;
+    for (size_t n : {220ul, 10000ul, 1000000ul}) {
+        std::vector<double> actual(n), predicted(n);
+        for (size_t i = 0; i < n; ++i) {
+            actual[i] = value(rng);
+            predicted[i] = actual[i] + noise(rng);
+        }
+        int reps = n >= 1000000 ? std::max(1, repeat / 4) : repeat * 50;
+        SizeResult r;
+        r.size = n;
+        r.separate_ns_per_point = bestNs(reps, [&] {
+            sink = Metrics::wape(actual, predicted) + Metrics::mae(actual, predicted)
+                 + Metrics::rmse(actual, predicted);
+        }) / n;
+        r.fused_ns_per_point = bestNs(reps, [&] {
+            ErrorStats s = Metrics::all(actual, predicted);
+            sink = s.wape + s.mae + s.rmse;
+        }) / n;
+        sizes.push_back(r);
+    }
+
+    // 2. Один ряд фактических значений против пакета прогнозов (как при подборе),
+    //    в том числе MASE по обучающей выборке
+    const size_t horizon = 220;
+    const size_t forecasts = 256;
+    const int season_length = 7;
+    std::vector<double> train(510), actual(horizon), batch(horizon * forecasts);
+    for (auto& x : train) {
+        x = value(rng);
+    }
+    for (size_t t = 0; t < horizon; ++t) {
+        actual[t] = value(rng);
+    }
+    for (size_t k = 0; k < forecasts; ++k) {
+        for (size_t t = 0; t < horizon; ++t) {
+            batch[k * horizon + t] = actual[t] + noise(rng);
+        }
+    }
+    std::vector<ErrorStats> batch_stats(forecasts);
+    std::vector<double> one(horizon);
+    double loop_ns = bestNs(repeat, [&] {
+        for (size_t k = 0; k < forecasts; ++k) {
+            one.assign(batch.begin() + k * horizon, batch.begin() + (k + 1) * horizon);
+            sink = Metrics::wape(actual, one) + Metrics::mae(actual, one) + Metrics::rmse(actual, one)
+                 + Metrics::mase(actual, one, train, season_length);
+        }
+    });
+    double all_loop_ns = bestNs(repeat, [&] {
+        for (size_t k = 0; k < forecasts; ++k) {
+            batch_stats[k] = Metrics::all(actual.data(), batch.data() + k * horizon, horizon,
+                                          train.data(), train.size(), season_length);
+        }
+    });
+    double batch_ns = bestNs(repeat, [&] {
+        Metrics::allBatch(actual.data(), horizon, batch.data(), forecasts, batch_stats.data(),
+                          train.data(), train.size(), season_length);
+    });
+
+    // 3. Точность: большой ряд с разбросом порядков, эталон - long double
+    const size_t n = 10000000;
+    std::vector<double> big_actual(n), big_predicted(n);
+    std::uniform_real_distribution<double> magnitude(-3.0, 6.0);
+    for (size_t i = 0; i < n; ++i) {
+        big_actual[i] = std::pow(10.0, magnitude(rng));
+        big_predicted[i] = big_actual[i] * (1.0 + 0.1 * std::sin(static_cast<double>(i)));
+    }
+    long double ref_err = 0.0L, ref_sum = 0.0L;
+    for (size_t i = 0; i < n; ++i) {
+        ref_err += std::abs(static_cast<long double>(big_actual[i]) - big_predicted[i]);
+        ref_sum += std::abs(static_cast<long double>(big_actual[i]));
+    }
+    double reference_wape = static_cast<double>(ref_err / ref_sum * 100.0L);
+    double plain_error = std::abs(Metrics::wape(big_actual, big_predicted) - reference_wape) / reference_wape;
+    double fused_error = std::abs(Metrics::all(big_actual, big_predicted).wape - reference_wape) / reference_wape;
+
+    // Сверка значений
+    ErrorStats check = Metrics::all(actual.data(), batch.data(), horizon);
+    one.assign(batch.begin(), batch.begin() + horizon);
+    double max_diff = std::max({std::abs(check.wape - Metrics::wape(actual, one)),
+                                std::abs(check.mae - Metrics::mae(actual, one)),
+                                std::abs(check.rmse - Metrics::rmse(actual, one)),
+                                std::abs(batch_stats[0].wape - check.wape)});
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "      точек   wape+mae+rmse   all (6 метрик)   ускорение" << std::endl;
+    for (const auto& r : sizes) {
+        std::cout << std::setw(11) << r.size
+                  << std::setw(12) << r.separate_ns_per_point << " нс/т"
+                  << std::setw(12) << r.fused_ns_per_point << " нс/т"
+                  << std::setw(11) << std::setprecision(2)
+                  << r.separate_ns_per_point / r.fused_ns_per_point << "x" << std::setprecision(3) << std::endl;
+    }
+    std::cout << "\nПакет: " << forecasts << " прогнозов x " << horizon << " точек" << std::endl;
+    std::cout << "  wape+mae+rmse+mase:    " << std::setw(9) << loop_ns / 1000.0 << " мкс" << std::endl;
+    std::cout << "  all в цикле:           " << std::setw(9) << all_loop_ns / 1000.0 << " мкс" << std::endl;
+    std::cout << "  allBatch:              " << std::setw(9) << batch_ns / 1000.0 << " мкс  ("
+              << std::setprecision(2) << loop_ns / batch_ns << "x)" << std::endl;
+    std::cout << "\nОтносительная ошибка WAPE на " << n << " точках (эталон long double):" << std::endl;
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "  обычная сумма:        " << plain_error << std::endl;
+    std::cout << "  сумма Кэхэна (all):   " << fused_error << std::endl;
+    std::cout << "Расхождение с wape/mae/rmse: " << max_diff << std::fixed << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"fused\": [\n";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        const auto& r = sizes[i];
+        json_file << "    {\"size\": " << r.size
+                  << ", \"separate_ns_per_point\": " << r.separate_ns_per_point
+                  << ", \"fused_ns_per_point\": " << r.fused_ns_per_point
+                  << ", \"speedup\": " << r.separate_ns_per_point / r.fused_ns_per_point << "}"
+                  << (i + 1 < sizes.size() ? "," : "") << "\n";
+    }
+    json_file << "  ],\n";
+    json_file << "  \"batch\": {\"forecasts\": " << forecasts << ", \"horizon\": " << horizon
+              << ", \"separate_us\": " << loop_ns / 1000.0
+              << ", \"all_loop_us\": " << all_loop_ns / 1000.0
+              << ", \"all_batch_us\": " << batch_ns / 1000.0 << "},\n";
+    json_file << "  \"accuracy\": {\"points\": " << n
+              << ", \"plain_relative_error\": " << plain_error
+              << ", \"compensated_relative_error\": " << fused_error << "},\n";
+    json_file << "  \"max_diff\": " << max_diff << "\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return max_diff < 1e-9 ? 0 : 1;
+}
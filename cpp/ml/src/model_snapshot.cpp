@@ -0,0 +1,219 @@
+#include "model_snapshot.h"
+#include "string_table.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+constexpr char ModelSnapshot::kMagic[8];
+
+bool ModelSnapshot::write(const std::string& filename,
+                          const std::vector<const HoltWinters*>& models,
+                          const std::vector<std::string>& names) {
+    if (!names.empty() && names.size() != models.size()) {
+        std::cerr << "Ошибка: число имен (" << names.size() << ") не равно числу моделей ("
+                  << models.size() << ")" << std::endl;
+        return false;
+    }
+
+    // Записи и сезонность собираются в памяти и пишутся двумя блоками
+    std::vector<ModelRecord> model_records(models.size());
+    std::vector<double> seasonal;
+    for (size_t i = 0; i < models.size(); ++i) {
+        const HoltWinters& model = *models[i];
+        if (!model.isFitted()) {
+            std::cerr << "Ошибка: модель " << i << " не обучена" << std::endl;
+            return false;
+        }
+        HoltWinters::Parameters parameters = model.getParameters();
+        HoltWinters::State state = model.getState();
+        ModelRecord& record = model_records[i];
+        record = ModelRecord{};
+        record.alpha = parameters.alpha;
+        record.beta = parameters.beta;
+        record.gamma = parameters.gamma;
+        record.level = state.level;
+        record.trend = state.trend;
+        record.initial_level = parameters.initial_level;
+        record.initial_trend = parameters.initial_trend;
+        record.observations = state.observations;
+        record.seasonal_index = seasonal.size();
+        record.season_length = model.getSeasonLength();
+        record.season_pos = state.season_pos;
+        seasonal.insert(seasonal.end(), state.seasonal.begin(), state.seasonal.end());
+    }
+    std::vector<std::string> empty_names;
+    if (names.empty()) {
+        empty_names.resize(models.size());
+    }
+    const std::vector<std::string>& table = names.empty() ? empty_names : names;
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.record_size = sizeof(ModelRecord);
+    header.num_models = models.size();
+    header.seasonal_count = seasonal.size();
+    header.records_offset = sizeof(SnapshotHeader);
+    header.seasonal_offset = string_table::alignUp(
+        header.records_offset + header.num_models * sizeof(ModelRecord), kSeasonalAlignment);
+    header.names_offset = header.seasonal_offset + header.seasonal_count * sizeof(double);
+    header.file_size = header.names_offset + string_table::size(table);
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(model_records.data()),
+              static_cast<std::streamsize>(model_records.size() * sizeof(ModelRecord)));
+    string_table::writePadding(out, header.records_offset + header.num_models * sizeof(ModelRecord),
+                               header.seasonal_offset);
+    out.write(reinterpret_cast<const char*>(seasonal.data()),
+              static_cast<std::streamsize>(seasonal.size() * sizeof(double)));
+    string_table::write(out, table);
+
+    if (!out.good()) {
+        std::cerr << "Ошибка записи в файл " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ModelSnapshot::save(const std::string& filename, const HoltWinters& model) {
+    return write(filename, {&model});
+}
+
+bool ModelSnapshot::load(const std::string& filename, HoltWinters& model) {
+    ModelSnapshot snapshot;
+    if (!snapshot.open(filename)) {
+        return false;
+    }
+    if (snapshot.size() == 0) {
+        std::cerr << "Ошибка: в снимке " << filename << " нет моделей" << std::endl;
+        return false;
+    }
+    if (snapshot.record(0).season_length != model.getSeasonLength()) {
+        std::cerr << "Ошибка: длина сезона в снимке (" << snapshot.record(0).season_length
+                  << ") не совпадает с моделью (" << model.getSeasonLength() << ")" << std::endl;
+        return false;
+    }
+    snapshot.restore(0, model);
+    return true;
+}
+
+bool ModelSnapshot::open(const std::string& filename) {
+    header = SnapshotHeader{};
+    records = nullptr;
+    seasonal_values = nullptr;
+    // Модели запрашиваются вразнобой - без MADV_SEQUENTIAL
+    if (!file.open(filename, false)) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    auto fail = [&](const char* reason) {
+        std::cerr << "Ошибка: " << filename << " - " << reason << std::endl;
+        file.close();
+        header = SnapshotHeader{};
+        records = nullptr;
+        seasonal_values = nullptr;
+        return false;
+    };
+
+    if (file.size() < sizeof(SnapshotHeader)) {
+        return fail("файл меньше заголовка снимка");
+    }
+    std::memcpy(&header, file.data(), sizeof(SnapshotHeader));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return fail("это не снимок моделей");
+    }
+    if (header.version != kVersion) {
+        return fail("неподдерживаемая версия снимка");
+    }
+    if (header.record_size != sizeof(ModelRecord)) {
+        return fail("размер записи модели не совпадает");
+    }
+    if (header.file_size != file.size()) {
+        return fail("размер файла не совпадает с заголовком (файл обрезан?)");
+    }
+
+    if (header.records_offset != sizeof(SnapshotHeader) ||
+        header.num_models > (header.file_size - header.records_offset) / sizeof(ModelRecord) ||
+        header.records_offset + header.num_models * sizeof(ModelRecord) > header.seasonal_offset) {
+        return fail("записи моделей выходят за пределы файла");
+    }
+    if (header.seasonal_offset % kSeasonalAlignment != 0 ||
+        header.seasonal_offset > header.file_size ||
+        header.seasonal_count > (header.file_size - header.seasonal_offset) / sizeof(double) ||
+        header.seasonal_offset + header.seasonal_count * sizeof(double) != header.names_offset) {
+        return fail("сезонные компоненты выходят за пределы файла");
+    }
+    if (!string_table::valid(file.data(), header.names_offset, header.num_models, header.file_size)) {
+        return fail("повреждена таблица имен");
+    }
+
+    records = reinterpret_cast<const ModelRecord*>(file.data() + header.records_offset);
+    seasonal_values = reinterpret_cast<const double*>(file.data() + header.seasonal_offset);
+
+    // Каждая запись должна ссылаться на свою часть сезонности
+    for (size_t i = 0; i < header.num_models; ++i) {
+        const ModelRecord& r = records[i];
+        if (r.season_length <= 0 || r.season_pos < 0 || r.season_pos >= r.season_length ||
+            r.seasonal_index > header.seasonal_count ||
+            static_cast<uint64_t>(r.season_length) > header.seasonal_count - r.seasonal_index) {
+            return fail("запись модели ссылается за пределы сезонных компонент");
+        }
+    }
+    return true;
+}
+
+std::string_view ModelSnapshot::name(size_t i) const {
+    return string_table::at(file.data(), header.names_offset, header.num_models, i);
+}
+
+size_t ModelSnapshot::find(std::string_view model_name) const {
+    for (size_t i = 0; i < header.num_models; ++i) {
+        if (name(i) == model_name) {
+            return i;
+        }
+    }
+    return header.num_models;
+}
+
+void ModelSnapshot::restore(size_t i, HoltWinters& model) const {
+    const ModelRecord& r = records[i];
+    if (r.season_length != model.getSeasonLength()) {
+        throw std::invalid_argument("restore: длина сезона модели не совпадает со снимком");
+    }
+    HoltWinters::Parameters parameters;
+    parameters.alpha = r.alpha;
+    parameters.beta = r.beta;
+    parameters.gamma = r.gamma;
+    parameters.initial_level = r.initial_level;
+    parameters.initial_trend = r.initial_trend;
+    model.restore(parameters, r.level, r.trend, seasonal(i), r.season_pos, r.observations);
+}
+
+HoltWinters ModelSnapshot::model(size_t i) const {
+    HoltWinters result(records[i].season_length);
+    restore(i, result);
+    return result;
+}
+
+void ModelSnapshot::forecastInto(size_t i, int horizon, double* out) const {
+    const ModelRecord& r = records[i];
+    const double* s = seasonal(i);
+    // Сезон шага h считается от фазы следующего наблюдения
+    int season_idx = r.season_pos;
+    for (int h = 1; h <= horizon; ++h) {
+        double value = r.level + h * r.trend + s[season_idx];
+        // Защита от отрицательных прогнозов
+        out[h - 1] = std::max(value, 0.0);
+        if (++season_idx == r.season_length) {
+            season_idx = 0;
+        }
+    }
+}
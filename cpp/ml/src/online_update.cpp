@@ -0,0 +1,180 @@
+/**
+ * @brief Проверка и замер онлайн-обновления HoltWinters::update
+ *
+ * Модель обучается на первых train_ratio точках, остальные подаются
+ * по одной через update. Состояние сравнивается с fit на всем ряду
+ * с тем же окном инициализации (должно совпасть точно) и с отдельно
+ * написанной рекурсией по формулам модели (совпадение до 1e-9), затем
+ * сравнивается цена update и полного переобучения на одну новую точку.
+ * Использование: online_update [--ratio R] [--updates N] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include "time_series.h"
+#include "holt_winters.h"
+
+namespace {
+
+/**
+ * @brief Прогнозы h = 1..horizon по формулам Holt-Winters, без HoltWinters::advance
+ *
+ * Как в fit, рекурсия идет с точки L. Сезонность хранится вся: seasonal[t] -
+ * компонента после точки t (первые L - начальные), точка t читает seasonal[t - L].
+ */
+std::vector<double> referenceForecast(SeriesView data, size_t init_size, int L,
+                                      double alpha, double beta, double gamma, int horizon) {
+    double level = 0.0;
+    double trend = 0.0;
+    std::vector<double> seasonal(data.size());
+    HoltWinters::initialComponents(data.data(), init_size, L, level, trend, seasonal.data());
+    const double level0 = level;
+    const double trend0 = trend;
+
+    for (size_t t = L; t < data.size(); ++t) {
+        double x = data[t];
+        double new_level = alpha * (x - seasonal[t - L]) + (1 - alpha) * (level + trend);
+        trend = beta * (new_level - level) + (1 - beta) * trend;
+        seasonal[t] = gamma * (x - new_level) + (1 - gamma) * seasonal[t - L];
+        level = new_level;
+        if (level < 0 || level > HoltWinters::kDivergenceLimit) {
+            level = level0;
+            trend = trend0;
+        }
+    }
+
+    std::vector<double> forecast(horizon);
+    for (int h = 1; h <= horizon; ++h) {
+        forecast[h - 1] = std::max(level + h * trend + seasonal[data.size() - L + (h - 1) % L], 0.0);
+    }
+    return forecast;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/online_update.json";
+    double ratio = 0.7;
+    size_t num_updates = 10000000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ratio" && i + 1 < argc) {
+            ratio = std::stod(argv[++i]);
+        } else if (arg == "--updates" && i + 1 < argc) {
+            num_updates = std::stoul(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== ОНЛАЙН-ОБНОВЛЕНИЕ HOLT-WINTERS ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesView values = ts.view();
+    const double alpha = 0.07, beta = 0.01, gamma = 0.07;
+    const size_t prefix = static_cast<size_t>(values.size() * ratio);
+
+    // 1. fit на префиксе + update на остатке против fit на всем ряду;
+    //    начальное состояние в обоих случаях считается по префиксу
+    HoltWinters online(7);
+    HoltWinters batch(7);
+    if (!online.fit(values.data(), prefix, alpha, beta, gamma) ||
+        !batch.fit(values.data(), values.size(), alpha, beta, gamma, prefix)) {
+        std::cerr << "Ошибка обучения модели!" << std::endl;
+        return 1;
+    }
+    for (size_t t = prefix; t < values.size(); ++t) {
+        online.update(values[t]);
+    }
+
+    double max_state_diff = std::max(std::abs(online.getLevel() - batch.getLevel()),
+                                     std::abs(online.getTrend() - batch.getTrend()));
+    for (size_t i = 0; i < online.getSeasonal().size(); ++i) {
+        max_state_diff = std::max(max_state_diff,
+                                  std::abs(online.getSeasonal()[i] - batch.getSeasonal()[i]));
+    }
+    const int horizon = 28;
+    double max_forecast_diff = 0.0;
+    for (int h = 1; h <= horizon; ++h) {
+        max_forecast_diff = std::max(max_forecast_diff, std::abs(online.forecast(h) - batch.forecast(h)));
+    }
+
+    // 2. Та же рекурсия, написанная отдельно: ловит ошибку в advance,
+    //    которую сравнение fit + update с fit не видит
+    std::vector<double> reference = referenceForecast(values, prefix, 7, alpha, beta, gamma, horizon);
+    double max_reference_diff = 0.0;
+    for (int h = 1; h <= horizon; ++h) {
+        double scale = std::max(1.0, std::abs(reference[h - 1]));
+        max_reference_diff = std::max(max_reference_diff,
+                                      std::abs(online.forecast(h) - reference[h - 1]) / scale);
+    }
+
+    std::cout << "fit(" << prefix << ") + " << values.size() - prefix << " × update против fit("
+              << values.size() << ")" << std::endl;
+    std::cout << "Макс. расхождение состояния: " << max_state_diff << std::endl;
+    std::cout << "Макс. расхождение прогноза (h=1..28): " << max_forecast_diff << std::endl;
+    std::cout << "Макс. отн. расхождение с отдельной рекурсией: " << max_reference_diff << std::endl;
+
+    // 3. Цена одной новой точки: update против полного fit
+    auto start = std::chrono::high_resolution_clock::now();
+    double sink = 0.0;
+    for (size_t i = 0; i < num_updates; ++i) {
+        online.update(values[i % values.size()]);
+        sink += online.getLevel();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double update_ns = std::chrono::duration<double, std::nano>(end - start).count() / num_updates;
+
+    const int refits = 2000;
+    HoltWinters refit_model(7);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < refits; ++i) {
+        refit_model.fit(values.data(), values.size(), alpha, beta, gamma);
+        sink += refit_model.getLevel();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double refit_ns = std::chrono::duration<double, std::nano>(end - start).count() / refits;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nupdate: " << update_ns << " нс/точка (" << num_updates << " обновлений)" << std::endl;
+    std::cout << "fit на " << values.size() << " точках: " << refit_ns << " нс" << std::endl;
+    std::cout << "Выигрыш на новую точку: " << refit_ns / update_ns << "x" << std::endl;
+    if (sink == 0.0) {
+        std::cout << std::endl; // не дает компилятору выбросить циклы
+    }
+
+    bool equal = max_state_diff == 0.0 && max_forecast_diff == 0.0 && max_reference_diff < 1e-9;
+    std::cout << (equal ? "✅ Состояния совпадают" : "❌ Состояния различаются") << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"online_update\": {\n";
+    json_file << "    \"prefix_points\": " << prefix << ",\n";
+    json_file << "    \"streamed_points\": " << values.size() - prefix << ",\n";
+    json_file << "    \"max_state_diff\": " << max_state_diff << ",\n";
+    json_file << "    \"max_forecast_diff\": " << max_forecast_diff << ",\n";
+    json_file << "    \"max_reference_rel_diff\": " << max_reference_diff << ",\n";
+    json_file << "    \"states_equal\": " << (equal ? "true" : "false") << ",\n";
+    json_file << "    \"update_ns_per_point\": " << update_ns << ",\n";
+    json_file << "    \"refit_ns\": " << refit_ns << ",\n";
+    json_file << "    \"refit_points\": " << values.size() << "\n";
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return equal ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/**
+ * @brief Подбор параметров Holt-Winters оптимизатором вместо перебора сетки
+ *
+ * Сначала сетка из конфигурации перебирается TuningEngine - это эталон.
+ * Затем Nelder-Mead и L-BFGS ищут минимум holdout WAPE (и in-sample SSE)
+ * на лучшем train_ratio сетки; фиксируется, сколько обучений и времени
+ * нужно, чтобы догнать лучший WAPE сетки.
+ * Использование: optimize [config] [--threads N] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include "time_series.h"
+#include "tuning_engine.h"
+#include "optimizer.h"
+
+namespace {
+
+void printResult(const std::string& name, const OptimizerResult& result, const std::string& unit) {
+    std::cout << std::left << std::setw(22) << name << std::right
+              << "α=" << std::fixed << std::setprecision(4) << result.alpha
+              << " β=" << result.beta << " γ=" << result.gamma
+              << " -> " << std::setprecision(4) << result.value << unit
+              << ", обучений: " << result.evaluations
+              << ", " << std::setprecision(2) << result.elapsed_ms << " мс";
+    if (result.reached_target) {
+        std::cout << " (цель за " << result.evaluations_to_target << " обучений, "
+                  << result.ms_to_target << " мс)";
+    }
+    std::cout << std::endl;
+}
+
+void writeResult(std::ofstream& json_file, const std::string& name,
+                 const OptimizerResult& result, double holdout_wape, bool last) {
+    json_file << "    \"" << name << "\": {"
+              << "\"alpha\": " << result.alpha
+              << ", \"beta\": " << result.beta
+              << ", \"gamma\": " << result.gamma
+              << ", \"objective\": " << result.value
+              << ", \"holdout_wape\": " << holdout_wape
+              << ", \"evaluations\": " << result.evaluations
+              << ", \"iterations\": " << result.iterations
+              << ", \"elapsed_ms\": " << result.elapsed_ms
+              << ", \"reached_grid_best\": " << (result.reached_target ? "true" : "false")
+              << ", \"evaluations_to_grid_best\": " << result.evaluations_to_target
+              << ", \"ms_to_grid_best\": " << result.ms_to_target << "}"
+              << (last ? "" : ",") << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string config_file = "../configs/forth_tuning.cfg";
+    std::string output_file = "../../../results/ml/optimizer_report.json";
+    size_t num_threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoul(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else {
+            config_file = arg;
+        }
+    }
+
+    std::cout << "=== ОПТИМИЗАЦИЯ ПАРАМЕТРОВ HOLT-WINTERS ===" << std::endl;
+
+    ParameterGrid grid;
+    try {
+        grid = ParameterGrid::loadConfig(config_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка конфигурации: " << e.what() << std::endl;
+        return 1;
+    }
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV(grid.data_file)) {
+        return 1;
+    }
+
+    // Эталон: полный перебор сетки
+    TuningEngine engine(num_threads, 1);
+    TuningReport report = engine.run(ts, grid);
+    if (report.leaderboard.empty()) {
+        std::cerr << "Ошибка: сетка не дала ни одного результата" << std::endl;
+        return 1;
+    }
+    const TuningResult& grid_best = report.leaderboard.front();
+    std::cout << "Сетка: " << report.evaluations << " обучений, "
+              << std::fixed << std::setprecision(1) << report.elapsed_ms << " мс, лучший WAPE "
+              << std::setprecision(4) << grid_best.wape << "% (ratio="
+              << std::setprecision(2) << grid_best.train_ratio << ")" << std::endl;
+
+    auto [train_data, test_data] = ts.split(grid_best.train_ratio);
+    HoltWintersOptimizer optimizer(train_data, test_data, grid.season_length);
+
+    OptimizerOptions options;
+    options.target = grid_best.wape;
+
+    std::cout << "\nЦель - holdout WAPE:" << std::endl;
+    OptimizerResult nm_wape = optimizer.nelderMead(Objective::HoldoutWAPE, options);
+    printResult("Nelder-Mead", nm_wape, "%");
+    OptimizerResult lbfgs_wape = optimizer.lbfgs(Objective::HoldoutWAPE, options);
+    printResult("L-BFGS", lbfgs_wape, "%");
+
+    // SSE не сравнима с WAPE напрямую: цели нет, WAPE считается в найденной точке
+    std::cout << "\nЦель - in-sample SSE (WAPE в найденной точке):" << std::endl;
+    OptimizerOptions sse_options;
+    OptimizerResult nm_sse = optimizer.nelderMead(Objective::InSampleSSE, sse_options);
+    OptimizerResult lbfgs_sse = optimizer.lbfgs(Objective::InSampleSSE, sse_options);
+    double params_nm[3] = {nm_sse.alpha, nm_sse.beta, nm_sse.gamma};
+    double params_lbfgs[3] = {lbfgs_sse.alpha, lbfgs_sse.beta, lbfgs_sse.gamma};
+    double nm_sse_wape = optimizer.evaluate(Objective::HoldoutWAPE, params_nm);
+    double lbfgs_sse_wape = optimizer.evaluate(Objective::HoldoutWAPE, params_lbfgs);
+    printResult("Nelder-Mead (SSE)", nm_sse, "");
+    std::cout << "    holdout WAPE: " << std::setprecision(4) << nm_sse_wape << "%" << std::endl;
+    printResult("L-BFGS (SSE)", lbfgs_sse, "");
+    std::cout << "    holdout WAPE: " << std::setprecision(4) << lbfgs_sse_wape << "%" << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"grid\": {\"config\": \"" << config_file << "\""
+              << ", \"evaluations\": " << report.evaluations
+              << ", \"elapsed_ms\": " << report.elapsed_ms
+              << ", \"num_threads\": " << report.num_threads
+              << ", \"best_wape\": " << grid_best.wape
+              << ", \"alpha\": " << grid_best.alpha
+              << ", \"beta\": " << grid_best.beta
+              << ", \"gamma\": " << grid_best.gamma
+              << ", \"train_ratio\": " << grid_best.train_ratio << "},\n";
+    json_file << "  \"optimizers\": {\n";
+    writeResult(json_file, "nelder_mead_wape", nm_wape, nm_wape.value, false);
+    writeResult(json_file, "lbfgs_wape", lbfgs_wape, lbfgs_wape.value, false);
+    writeResult(json_file, "nelder_mead_sse", nm_sse, nm_sse_wape, false);
+    writeResult(json_file, "lbfgs_sse", lbfgs_sse, lbfgs_sse_wape, true);
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "\nРезультаты сохранены в " << output_file << std::endl;
+
+    return 0;
+}
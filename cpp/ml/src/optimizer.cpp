@@ -0,0 +1,454 @@
+#include "optimizer.h"
+#include "holt_winters.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+using Point = std::array<double, 3>;
+using Clock = std::chrono::high_resolution_clock;
+
+Point clampToBox(Point p) {
+    for (double& v : p) {
+        v = std::min(1.0, std::max(0.0, v));
+    }
+    return p;
+}
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Счетчик оценок целевой функции и момента достижения цели
+ */
+struct EvaluationTracker {
+    OptimizerResult& result;
+    const OptimizerOptions& options;
+    Clock::time_point start;
+
+    void record(double value) {
+        result.evaluations++;
+        if (!result.reached_target && value <= options.target) {
+            result.reached_target = true;
+            result.evaluations_to_target = result.evaluations;
+            result.ms_to_target = elapsedMs(start);
+        }
+    }
+};
+
+} // namespace
+
+HoltWintersOptimizer::HoltWintersOptimizer(const std::vector<double>& train,
+                                           const std::vector<double>& test,
+                                           int season_length)
+    : train(train), test(test), season_length(season_length),
+      initial_level(0.0), initial_trend(0.0), test_abs_sum(0.0) {
+    if (season_length <= 0) {
+        throw std::invalid_argument("season_length должен быть положительным");
+    }
+    if (train.size() < 2 * static_cast<size_t>(season_length)) {
+        throw std::invalid_argument("Недостаточно данных для оптимизации");
+    }
+    // Начальное состояние от параметров не зависит - считаем один раз
+    initial_seasonal.assign(season_length, 0.0);
+    HoltWinters::initialComponents(train.data(), train.size(), season_length,
+                                   initial_level, initial_trend, initial_seasonal.data());
+    for (double value : test) {
+        test_abs_sum += std::abs(value);
+    }
+}
+
+double HoltWintersOptimizer::evaluate(Objective objective, const double* params, double* gradient) const {
+    const double alpha = params[0];
+    const double beta = params[1];
+    const double gamma = params[2];
+    const bool with_gradient = gradient != nullptr;
+    const size_t L = season_length;
+
+    double level = initial_level;
+    double trend = initial_trend;
+    std::vector<double> seasonal(initial_seasonal);
+
+    // Производные состояния по (alpha, beta, gamma); в начале нули
+    Point d_level{}, d_trend{};
+    std::vector<Point> d_seasonal(with_gradient ? L : 0, Point{});
+
+    double sse = 0.0;
+    Point d_sse{};
+
+    size_t season_idx = 0;
+    for (size_t t = L; t < train.size(); ++t) {
+        const double x = train[t];
+        const double s = seasonal[season_idx];
+
+        if (objective == Objective::InSampleSSE) {
+            // Прогноз на шаг вперед из состояния до обновления
+            double error = x - (level + trend + s);
+            sse += error * error;
+            if (with_gradient) {
+                for (int k = 0; k < 3; ++k) {
+                    d_sse[k] += -2.0 * error * (d_level[k] + d_trend[k] + d_seasonal[season_idx][k]);
+                }
+            }
+        }
+
+        // Те же формулы, что в HoltWinters::fit
+        double new_level = alpha * (x - s) + (1 - alpha) * (level + trend);
+        double new_trend = beta * (new_level - level) + (1 - beta) * trend;
+        double new_seasonal = gamma * (x - new_level) + (1 - gamma) * s;
+
+        if (with_gradient) {
+            Point& ds = d_seasonal[season_idx];
+            Point dl, dt, dsn;
+            // Цепное правило; слагаемое с явной производной есть только у "своего" параметра
+            for (int k = 0; k < 3; ++k) {
+                dl[k] = -alpha * ds[k] + (1 - alpha) * (d_level[k] + d_trend[k]);
+            }
+            dl[0] += x - s - (level + trend);
+            for (int k = 0; k < 3; ++k) {
+                dt[k] = beta * (dl[k] - d_level[k]) + (1 - beta) * d_trend[k];
+            }
+            dt[1] += new_level - level - trend;
+            for (int k = 0; k < 3; ++k) {
+                dsn[k] = -gamma * dl[k] + (1 - gamma) * ds[k];
+            }
+            dsn[2] += x - new_level - s;
+            d_level = dl;
+            d_trend = dt;
+            ds = dsn;
+        }
+
+        level = new_level;
+        trend = new_trend;
+        seasonal[season_idx] = new_seasonal;
+
+        // Сброс при расходимости: состояние больше не зависит от параметров
+        if (level < 0 || std::abs(level) > HoltWinters::kDivergenceLimit) {
+            level = initial_level;
+            trend = initial_trend;
+            d_level = Point{};
+            d_trend = Point{};
+        }
+
+        if (++season_idx == L) {
+            season_idx = 0;
+        }
+    }
+
+    if (objective == Objective::InSampleSSE) {
+        if (with_gradient) {
+            std::copy(d_sse.begin(), d_sse.end(), gradient);
+        }
+        return sse;
+    }
+
+    // Holdout WAPE: прогноз как в HoltWinters::predict
+    double abs_error = 0.0;
+    Point d_abs_error{};
+    for (size_t h = 1; h <= test.size(); ++h) {
+        size_t idx = (h - 1) % L;
+        double raw = level + h * trend + seasonal[idx];
+        double forecast = std::max(raw, 0.0);
+        double diff = test[h - 1] - forecast;
+        abs_error += std::abs(diff);
+        if (with_gradient && raw > 0.0 && diff != 0.0) {
+            double sign = diff > 0 ? -1.0 : 1.0;
+            for (int k = 0; k < 3; ++k) {
+                d_abs_error[k] += sign * (d_level[k] + h * d_trend[k] + d_seasonal[idx][k]);
+            }
+        }
+    }
+
+    if (test_abs_sum == 0.0) {
+        throw std::runtime_error("Сумма фактических значений равна 0, WAPE не может быть вычислен");
+    }
+    if (with_gradient) {
+        for (int k = 0; k < 3; ++k) {
+            gradient[k] = d_abs_error[k] / test_abs_sum * 100.0;
+        }
+    }
+    return abs_error / test_abs_sum * 100.0;
+}
+
+OptimizerResult HoltWintersOptimizer::nelderMead(Objective objective, const OptimizerOptions& options) const {
+    OptimizerResult result;
+    EvaluationTracker tracker{result, options, Clock::now()};
+
+    auto f = [&](const Point& p) {
+        double value = evaluate(objective, p.data());
+        tracker.record(value);
+        return value;
+    };
+
+    Point best = clampToBox({options.alpha, options.beta, options.gamma});
+    double best_value = f(best);
+
+    for (size_t restart = 0; restart <= options.restarts; ++restart) {
+        // Начальный симплекс: шаг 0.1 по каждой оси (внутрь области у границы);
+        // при перезапусках шаг уменьшается
+        double step = 0.1 / (1 << restart);
+        std::array<Point, 4> simplex;
+        std::array<double, 4> values;
+        simplex[0] = best;
+        values[0] = best_value;
+        for (int k = 0; k < 3; ++k) {
+            Point p = best;
+            p[k] += (p[k] + step <= 1.0) ? step : -step;
+            simplex[k + 1] = clampToBox(p);
+            values[k + 1] = f(simplex[k + 1]);
+        }
+
+        while (result.evaluations < options.max_evaluations) {
+            result.iterations++;
+            std::array<int, 4> order{0, 1, 2, 3};
+            std::sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+            std::array<Point, 4> sorted_simplex;
+            std::array<double, 4> sorted_values;
+            for (int i = 0; i < 4; ++i) {
+                sorted_simplex[i] = simplex[order[i]];
+                sorted_values[i] = values[order[i]];
+            }
+            simplex = sorted_simplex;
+            values = sorted_values;
+
+            double diameter = 0.0;
+            for (int i = 1; i < 4; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    diameter = std::max(diameter, std::abs(simplex[i][k] - simplex[0][k]));
+                }
+            }
+            if (values[3] - values[0] <= options.tolerance || diameter < 1e-7) {
+                break;
+            }
+
+            Point centroid{};
+            for (int i = 0; i < 3; ++i) {
+                for (int k = 0; k < 3; ++k) {
+                    centroid[k] += simplex[i][k] / 3.0;
+                }
+            }
+            auto along = [&](double coeff) {
+                Point p;
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = centroid[k] + coeff * (simplex[3][k] - centroid[k]);
+                }
+                return clampToBox(p);
+            };
+
+            Point reflected = along(-1.0);
+            double reflected_value = f(reflected);
+            if (reflected_value < values[0]) {
+                Point expanded = along(-2.0);
+                double expanded_value = f(expanded);
+                if (expanded_value < reflected_value) {
+                    simplex[3] = expanded;
+                    values[3] = expanded_value;
+                } else {
+                    simplex[3] = reflected;
+                    values[3] = reflected_value;
+                }
+            } else if (reflected_value < values[2]) {
+                simplex[3] = reflected;
+                values[3] = reflected_value;
+            } else {
+                bool outside = reflected_value < values[3];
+                Point contracted = along(outside ? -0.5 : 0.5);
+                double contracted_value = f(contracted);
+                if (contracted_value < std::min(values[3], reflected_value)) {
+                    simplex[3] = contracted;
+                    values[3] = contracted_value;
+                } else {
+                    // Сжатие к лучшей вершине
+                    for (int i = 1; i < 4; ++i) {
+                        for (int k = 0; k < 3; ++k) {
+                            simplex[i][k] = simplex[0][k] + 0.5 * (simplex[i][k] - simplex[0][k]);
+                        }
+                        values[i] = f(simplex[i]);
+                    }
+                }
+            }
+        }
+
+        int best_vertex = static_cast<int>(std::min_element(values.begin(), values.end()) - values.begin());
+        if (values[best_vertex] < best_value) {
+            best = simplex[best_vertex];
+            best_value = values[best_vertex];
+        }
+        if (result.evaluations >= options.max_evaluations) {
+            break;
+        }
+    }
+
+    result.alpha = best[0];
+    result.beta = best[1];
+    result.gamma = best[2];
+    result.value = best_value;
+    result.elapsed_ms = elapsedMs(tracker.start);
+    return result;
+}
+
+OptimizerResult HoltWintersOptimizer::lbfgs(Objective objective, const OptimizerOptions& options) const {
+    OptimizerResult result;
+    EvaluationTracker tracker{result, options, Clock::now()};
+    const size_t memory = 5;
+
+    auto f = [&](const Point& p, Point& grad) {
+        double value = evaluate(objective, p.data(), grad.data());
+        tracker.record(value);
+        return value;
+    };
+
+    // Координаты на границе, где градиент выталкивает наружу, закреплены
+    auto freeMask = [](const Point& x, const Point& g) {
+        std::array<bool, 3> free{};
+        for (int k = 0; k < 3; ++k) {
+            free[k] = !((x[k] <= 0.0 && g[k] > 0.0) || (x[k] >= 1.0 && g[k] < 0.0));
+        }
+        return free;
+    };
+
+    Point x = clampToBox({options.alpha, options.beta, options.gamma});
+    Point g;
+    double value = f(x, g);
+
+    std::vector<Point> s_history;
+    std::vector<Point> y_history;
+
+    while (result.evaluations < options.max_evaluations) {
+        result.iterations++;
+        auto free = freeMask(x, g);
+
+        double projected_norm = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            if (free[k]) {
+                projected_norm = std::max(projected_norm, std::abs(g[k]));
+            }
+        }
+        if (projected_norm <= options.tolerance) {
+            break;
+        }
+
+        // Двухцикловая рекурсия L-BFGS по свободным координатам
+        Point q{};
+        for (int k = 0; k < 3; ++k) {
+            q[k] = free[k] ? g[k] : 0.0;
+        }
+        std::vector<double> rho(s_history.size());
+        std::vector<double> a(s_history.size());
+        for (size_t i = s_history.size(); i-- > 0;) {
+            double ys = 0.0, sq = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                ys += y_history[i][k] * s_history[i][k];
+                sq += s_history[i][k] * q[k];
+            }
+            rho[i] = 1.0 / ys;
+            a[i] = rho[i] * sq;
+            for (int k = 0; k < 3; ++k) {
+                q[k] -= a[i] * y_history[i][k];
+            }
+        }
+        double scale = 1.0 / std::max(1.0, projected_norm);
+        if (!s_history.empty()) {
+            const Point& s = s_history.back();
+            const Point& y = y_history.back();
+            double ys = 0.0, yy = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                ys += y[k] * s[k];
+                yy += y[k] * y[k];
+            }
+            scale = ys / yy;
+        }
+        for (int k = 0; k < 3; ++k) {
+            q[k] *= scale;
+        }
+        for (size_t i = 0; i < s_history.size(); ++i) {
+            double yq = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                yq += y_history[i][k] * q[k];
+            }
+            double b = rho[i] * yq;
+            for (int k = 0; k < 3; ++k) {
+                q[k] += s_history[i][k] * (a[i] - b);
+            }
+        }
+
+        Point direction;
+        double slope = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            direction[k] = free[k] ? -q[k] : 0.0;
+            slope += direction[k] * g[k];
+        }
+        if (slope >= 0.0) {
+            // Направление не спусковое - сбрасываем память и идем по антиградиенту
+            s_history.clear();
+            y_history.clear();
+            slope = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                direction[k] = free[k] ? -g[k] * scale : 0.0;
+                slope += direction[k] * g[k];
+            }
+        }
+
+        // Поиск шага по проекции (условие Армихо)
+        double step = 1.0;
+        Point x_new;
+        Point g_new;
+        double value_new = value;
+        bool accepted = false;
+        while (result.evaluations < options.max_evaluations && step > 1e-12) {
+            for (int k = 0; k < 3; ++k) {
+                x_new[k] = x[k] + step * direction[k];
+            }
+            x_new = clampToBox(x_new);
+            value_new = f(x_new, g_new);
+            double decrease = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                decrease += g[k] * (x_new[k] - x[k]);
+            }
+            if (value_new <= value + 1e-4 * decrease) {
+                accepted = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        if (!accepted) {
+            break;
+        }
+
+        Point s, y;
+        double ys = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            s[k] = x_new[k] - x[k];
+            y[k] = g_new[k] - g[k];
+            ys += s[k] * y[k];
+        }
+        // Кривизна должна быть положительной, иначе пара портит приближение гессиана
+        if (ys > 1e-12) {
+            s_history.push_back(s);
+            y_history.push_back(y);
+            if (s_history.size() > memory) {
+                s_history.erase(s_history.begin());
+                y_history.erase(y_history.begin());
+            }
+        }
+
+        double change = std::abs(value - value_new);
+        x = x_new;
+        g = g_new;
+        value = value_new;
+        if (change <= options.tolerance * std::max(1.0, std::abs(value))) {
+            break;
+        }
+    }
+
+    result.alpha = x[0];
+    result.beta = x[1];
+    result.gamma = x[2];
+    result.value = value;
+    result.elapsed_ms = elapsedMs(tracker.start);
+    return result;
+}
@@ -1,150 +1,365 @@
 /**
- * @brief Бенчмарк для анализа производительности Holt-Winters
+ * @brief Бенчмарк производительности Holt-Winters: замеры вместо оценок
+ *
+ * Синтетические ряды от 10^min до 10^max точек (шаг - степень 10):
+ * 70% на обучение, 30% на прогноз, как в прежней версии. На каждый
+ * размер - warmup прогонов без учета, затем repeat замеров fit и
+ * predict; в отчет идут минимум и медиана в нс на точку.
+ *
+ * Память меряется, а не считается по формуле: вершина кучи - через
+ * подмененные operator new/delete этого файла, вершина RSS - VmHWM из
+ * /proc/self/status (сбрасывается перед каждым размером через
+ * /proc/self/clear_refs, где это разрешено).
+ *
+ * Использование: performance_benchmark [--min-exp A] [--max-exp B]
+ *                [--repeat R] [--warmup W] [--output file] [--trace file]
  */
 #include <iostream>
 #include <vector>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
-#include "time_series.h"
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
 #include "holt_winters.h"
 #include "metrics.h"
+#include "trace.h"
+
+namespace {
+
+std::atomic<size_t> heap_current{0};
+std::atomic<size_t> heap_peak{0};
+
+void countAllocation(void* ptr) {
+    size_t size = malloc_usable_size(ptr);
+    size_t now = heap_current.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = heap_peak.load(std::memory_order_relaxed);
+    while (now > peak && !heap_peak.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* allocate(size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    countAllocation(ptr);
+    return ptr;
+}
+
+void release(void* ptr) {
+    if (ptr) {
+        heap_current.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+        std::free(ptr);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void operator delete(void* ptr) noexcept { release(ptr); }
+void operator delete[](void* ptr) noexcept { release(ptr); }
+void operator delete(void* ptr, size_t) noexcept { release(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { release(ptr); }
+
+namespace {
 
 /**
- * @brief Замеряет время выполнения алгоритма на данных разного размера
+ * @brief Горизонт для проверки качества: прогноз на 30% ряда из 10^8 точек
+ * уходит трендом далеко, и WAPE по нему ничего не говорит о модели
  */
-void benchmark_time_complexity() {
-    std::cout << "=== БЕНЧМАРК ВРЕМЕННОЙ СЛОЖНОСТИ ===" << std::endl;
-    
-    TimeSeries ts;
-    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
-        return;
-    }
-    
-    auto full_data = ts.getValues();
-    std::vector<int> data_sizes = {100, 200, 400, 600, 730};
-    std::vector<double> training_times;
-    std::vector<double> prediction_times;
-    
-    std::cout << std::setw(10) << "Размер" 
-              << std::setw(15) << "Время обучения" 
-              << std::setw(15) << "Время прогноза" 
-              << std::setw(15) << "WAPE" << std::endl;
-    std::cout << std::string(55, '-') << std::endl;
-    
-    for (int size : data_sizes) {
-        if (size > full_data.size()) continue;
-        
-        std::vector<double> sample_data(full_data.begin(), full_data.begin() + size);
-        int train_size = static_cast<int>(size * 0.7);
-        int test_size = size - train_size;
-        
-        std::vector<double> train_data(sample_data.begin(), sample_data.begin() + train_size);
-        std::vector<double> test_data(sample_data.begin() + train_size, sample_data.end());
-        
-        HoltWinters model(7);
-        
-        // Замер времени обучения
-        auto start_train = std::chrono::high_resolution_clock::now();
-        model.fit(train_data, 0.07, 0.01, 0.07);
-        auto end_train = std::chrono::high_resolution_clock::now();
-        double train_time = std::chrono::duration<double, std::milli>(end_train - start_train).count();
-        
-        // Замер времени прогноза
-        auto start_pred = std::chrono::high_resolution_clock::now();
-        auto predictions = model.predict(test_size);
-        auto end_pred = std::chrono::high_resolution_clock::now();
-        double pred_time = std::chrono::duration<double, std::milli>(end_pred - start_pred).count();
-        
-        double wape = Metrics::wape(test_data, predictions);
-        
-        training_times.push_back(train_time);
-        prediction_times.push_back(pred_time);
-        
-        std::cout << std::setw(10) << size 
-                  << std::setw(15) << std::fixed << std::setprecision(2) << train_time << " мс"
-                  << std::setw(15) << pred_time << " мс"
-                  << std::setw(15) << std::setprecision(1) << wape << "%" << std::endl;
-    }
-    
-    // Сохраняем результаты в JSON
-    std::ofstream json_file("../../../results/time_complexity.json");
-    json_file << "{\n";
-    json_file << "  \"time_complexity\": {\n";
-    json_file << "    \"data_sizes\": [";
-    for (size_t i = 0; i < data_sizes.size(); ++i) {
-        json_file << data_sizes[i] << (i < data_sizes.size() - 1 ? ", " : "");
-    }
-    json_file << "],\n";
-    json_file << "    \"training_times_ms\": [";
-    for (size_t i = 0; i < training_times.size(); ++i) {
-        json_file << training_times[i] << (i < training_times.size() - 1 ? ", " : "");
-    }
-    json_file << "],\n";
-    json_file << "    \"prediction_times_ms\": [";
-    for (size_t i = 0; i < prediction_times.size(); ++i) {
-        json_file << prediction_times[i] << (i < prediction_times.size() - 1 ? ", " : "");
-    }
-    json_file << "]\n";
-    json_file << "  }\n";
-    json_file << "}\n";
-    json_file.close();
+constexpr size_t kWapeHorizon = 28;
+
+/**
+ * @brief Замеры для одного размера ряда
+ */
+struct SizeResult {
+    size_t points = 0;
+    size_t train_size = 0;
+    size_t test_size = 0;
+    double fit_ms_min = 0.0;
+    double fit_ms_median = 0.0;
+    double predict_ms_min = 0.0;
+    double predict_ms_median = 0.0;
+    size_t data_bytes = 0;
+    size_t fit_heap_bytes = 0;       ///< Вершина кучи во время fit сверх данных
+    size_t predict_heap_bytes = 0;   ///< Вершина кучи во время predict
+    size_t peak_heap_bytes = 0;      ///< Вершина кучи на весь размер, включая ряд
+    size_t peak_rss_kb = 0;          ///< VmHWM процесса
+    double wape = 0.0;               ///< WAPE первых kWapeHorizon шагов прогноза
+
+    double fitNsPerPoint() const { return fit_ms_median * 1e6 / train_size; }
+    double predictNsPerPoint() const { return predict_ms_median * 1e6 / test_size; }
+};
+
+/**
+ * @brief Поле "Name: value kB" из /proc/self/status
+ * @return значение в КБ или 0, если поля нет
+ */
+size_t procStatusKb(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() &&
+            line[field.size()] == ':') {
+            return std::strtoull(line.c_str() + field.size() + 1, nullptr, 10);
+        }
+    }
+    return 0;
 }
 
 /**
- * @brief Анализирует использование памяти (теоретически)
+ * @brief Сбрасывает VmHWM до текущего RSS
+ * @return false если ядро не разрешает (тогда VmHWM - вершина за весь процесс)
  */
-void analyze_memory_complexity() {
-    std::cout << "\n=== АНАЛИЗ ИСПОЛЬЗОВАНИЯ ПАМЯТИ ===" << std::endl;
-    
-    std::vector<int> data_sizes = {100, 200, 400, 600, 730};
-    std::vector<double> memory_kb;
-    
-    std::cout << std::setw(10) << "Размер" 
-              << std::setw(20) << "Память (теор.)" 
-              << std::setw(20) << "Сложность" << std::endl;
-    std::cout << std::string(50, '-') << std::endl;
-    
-    for (int size : data_sizes) {
-        // Теоретическая оценка: O(n) для данных + O(m) для сезонных компонент
-        double memory_bytes = size * sizeof(double) +  // данные
-                             7 * sizeof(double) +      // сезонные компоненты
-                             2 * sizeof(double);       // уровень и тренд
-        
-        memory_kb.push_back(memory_bytes / 1024.0);
-        
-        std::cout << std::setw(10) << size 
-                  << std::setw(20) << std::fixed << std::setprecision(2) << memory_kb.back() << " КБ"
-                  << std::setw(20) << "O(n)" << std::endl;
-    }
-    
-    // Сохраняем результаты
-    std::ofstream json_file("../../../results/memory_complexity.json");
-    json_file << "{\n";
-    json_file << "  \"memory_complexity\": {\n";
-    json_file << "    \"data_sizes\": [";
-    for (size_t i = 0; i < data_sizes.size(); ++i) {
-        json_file << data_sizes[i] << (i < data_sizes.size() - 1 ? ", " : "");
+bool resetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.flush();
+    return clear_refs.good();
+}
+
+void resetPeakHeap() {
+    heap_peak.store(heap_current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Синтетический ряд: уровень с годовой волной, недельная сезонность и шум
+ *
+ * Детерминирован (шум из хеша номера точки), поэтому замеры повторяемы.
+ */
+void generateSeries(size_t n, std::vector<double>& out) {
+    static const double weekly[7] = {1.00, 1.05, 1.10, 1.08, 1.15, 0.85, 0.77};
+    out.resize(n);
+    for (size_t t = 0; t < n; ++t) {
+        double noise = static_cast<double>(mix(t) >> 11) * 0x1.0p-53 - 0.5;
+        double base = 500.0 + 50.0 * std::sin(static_cast<double>(t % 365) * (2.0 * M_PI / 365.0));
+        out[t] = base * weekly[t % 7] * (1.0 + 0.1 * noise);
+    }
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+template <typename F>
+double timeMs(F&& body) {
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Замеряет fit и predict на ряде из n точек
+ */
+SizeResult measureSize(size_t n, int repeat, int warmup) {
+    TRACE_SPAN_VALUE("measureSize", n);
+    SizeResult result;
+    result.points = n;
+    result.train_size = static_cast<size_t>(n * 0.7);
+    result.test_size = n - result.train_size;
+
+    resetPeakRss();
+    resetPeakHeap();
+    size_t heap_before = heap_current.load();
+
+    std::vector<double> data;
+    {
+        TRACE_SPAN_VALUE("generateSeries", n);
+        generateSeries(n, data);
+    }
+    result.data_bytes = n * sizeof(double);
+    const double* train = data.data();
+    const double* test = data.data() + result.train_size;
+
+    std::vector<double> fit_ms;
+    std::vector<double> predict_ms;
+    std::vector<double> predictions;
+    HoltWinters model(7);
+    for (int run = 0; run < warmup + repeat; ++run) {
+        size_t heap_base = heap_current.load();
+        resetPeakHeap();
+        double fit_time = timeMs([&]() { model.fit(train, result.train_size, 0.07, 0.01, 0.07); });
+        result.fit_heap_bytes = std::max(result.fit_heap_bytes, heap_peak.load() - heap_base);
+
+        // Прогноз прошлого прогона освобождается до замера
+        predictions = std::vector<double>();
+        heap_base = heap_current.load();
+        resetPeakHeap();
+        double predict_time = timeMs([&]() { predictions = model.predict(static_cast<int>(result.test_size)); });
+        result.predict_heap_bytes = std::max(result.predict_heap_bytes, heap_peak.load() - heap_base);
+
+        if (run >= warmup) {
+            fit_ms.push_back(fit_time);
+            predict_ms.push_back(predict_time);
+        }
     }
-    json_file << "],\n";
-    json_file << "    \"memory_kb\": [";
-    for (size_t i = 0; i < memory_kb.size(); ++i) {
-        json_file << memory_kb[i] << (i < memory_kb.size() - 1 ? ", " : "");
+
+    result.fit_ms_min = *std::min_element(fit_ms.begin(), fit_ms.end());
+    result.fit_ms_median = median(fit_ms);
+    result.predict_ms_min = *std::min_element(predict_ms.begin(), predict_ms.end());
+    result.predict_ms_median = median(predict_ms);
+    result.wape = Metrics::wape(test, predictions.data(), std::min(result.test_size, kWapeHorizon));
+
+    // Вершина за весь размер: ряд + модель + прогноз
+    result.peak_heap_bytes = std::max(result.data_bytes + result.fit_heap_bytes,
+                                      result.data_bytes + result.predict_heap_bytes);
+    result.peak_heap_bytes = std::max(result.peak_heap_bytes, heap_current.load() - heap_before);
+    result.peak_rss_kb = procStatusKb("VmHWM");
+    return result;
+}
+
+void writeArray(std::ofstream& out, const std::vector<SizeResult>& results,
+                double (*field)(const SizeResult&)) {
+    out << "[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << field(results[i]) << (i + 1 < results.size() ? ", " : "");
     }
-    json_file << "]\n";
-    json_file << "  }\n";
-    json_file << "}\n";
-    json_file.close();
+    out << "]";
 }
 
-int main() {
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int min_exp = 3;
+    int max_exp = 8;
+    int repeat = 5;
+    int warmup = 1;
+    std::string output_file = "../../../results/ml/performance_benchmark.json";
+    std::string trace_file;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--min-exp" && i + 1 < argc) {
+            min_exp = std::stoi(argv[++i]);
+        } else if (arg == "--max-exp" && i + 1 < argc) {
+            max_exp = std::stoi(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            trace_file = argv[++i];
+        }
+    }
+    min_exp = std::max(min_exp, 2);
+    if (max_exp < min_exp) {
+        std::cerr << "Ошибка: --max-exp меньше --min-exp" << std::endl;
+        return 1;
+    }
+
     std::cout << "ПРОИЗВОДИТЕЛЬНОСТЬ HOLT-WINTERS АЛГОРИТМА\n" << std::endl;
-    
-    benchmark_time_complexity();
-    analyze_memory_complexity();
-    
-    std::cout << "\n=== РЕЗУЛЬТАТЫ СОХРАНЕНЫ ===" << std::endl;
-    std::cout << "Файлы созданы в results/" << std::endl;
-    
+    std::cout << "Размеры: 10^" << min_exp << " .. 10^" << max_exp
+              << ", прогонов: " << repeat << " (+" << warmup << " разогрев)" << std::endl;
+    if (!resetPeakRss()) {
+        std::cout << "VmHWM не сбрасывается: RSS - вершина за весь процесс" << std::endl;
+    }
+
+    std::cout << std::setw(12) << "Точек"
+              << "   fit, нс/т"
+              << "  predict, нс/т"
+              << "  куча fit, КБ"
+              << "  куча всего, МБ"
+              << "    RSS, МБ"
+              << "  WAPE(" << kWapeHorizon << ")" << std::endl;
+    std::cout << std::string(92, '-') << std::endl;
+
+    if (!trace_file.empty()) {
+        trace::start();
+    }
+    std::vector<SizeResult> results;
+    size_t n = 1;
+    for (int e = 0; e < min_exp; ++e) {
+        n *= 10;
+    }
+    for (int e = min_exp; e <= max_exp; ++e, n *= 10) {
+        SizeResult r = measureSize(n, repeat, warmup);
+        results.push_back(r);
+        std::cout << std::setw(12) << r.points
+                  << std::setw(12) << std::fixed << std::setprecision(2) << r.fitNsPerPoint()
+                  << std::setw(15) << r.predictNsPerPoint()
+                  << std::setw(14) << r.fit_heap_bytes / 1024.0
+                  << std::setw(16) << r.peak_heap_bytes / (1024.0 * 1024.0)
+                  << std::setw(11) << r.peak_rss_kb / 1024.0
+                  << std::setw(9) << std::setprecision(1) << r.wape << "%" << std::endl;
+    }
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"repeat\": " << repeat << ",\n";
+    json_file << "  \"warmup\": " << warmup << ",\n";
+    json_file << "  \"season_length\": 7,\n";
+    json_file << "  \"wape_horizon\": " << kWapeHorizon << ",\n";
+    json_file << "  \"sizes\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SizeResult& r = results[i];
+        json_file << "    {\"points\": " << r.points
+                  << ", \"train_size\": " << r.train_size
+                  << ", \"test_size\": " << r.test_size
+                  << ", \"fit_ms_min\": " << r.fit_ms_min
+                  << ", \"fit_ms_median\": " << r.fit_ms_median
+                  << ", \"fit_ns_per_point\": " << r.fitNsPerPoint()
+                  << ", \"predict_ms_min\": " << r.predict_ms_min
+                  << ", \"predict_ms_median\": " << r.predict_ms_median
+                  << ", \"predict_ns_per_point\": " << r.predictNsPerPoint()
+                  << ", \"data_bytes\": " << r.data_bytes
+                  << ", \"fit_heap_bytes\": " << r.fit_heap_bytes
+                  << ", \"predict_heap_bytes\": " << r.predict_heap_bytes
+                  << ", \"peak_heap_bytes\": " << r.peak_heap_bytes
+                  << ", \"peak_rss_kb\": " << r.peak_rss_kb
+                  << ", \"wape\": " << r.wape << "}"
+                  << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json_file << "  ],\n";
+    // Те же ключи, что читает python/ml/scripts/plot_performance.py
+    json_file << "  \"time_complexity\": {\n";
+    json_file << "    \"data_sizes\": ";
+    writeArray(json_file, results, [](const SizeResult& r) { return static_cast<double>(r.points); });
+    json_file << ",\n    \"training_times_ms\": ";
+    writeArray(json_file, results, [](const SizeResult& r) { return r.fit_ms_median; });
+    json_file << ",\n    \"prediction_times_ms\": ";
+    writeArray(json_file, results, [](const SizeResult& r) { return r.predict_ms_median; });
+    json_file << "\n  },\n";
+    json_file << "  \"memory_complexity\": {\n";
+    json_file << "    \"data_sizes\": ";
+    writeArray(json_file, results, [](const SizeResult& r) { return static_cast<double>(r.points); });
+    json_file << ",\n    \"memory_kb\": ";
+    writeArray(json_file, results, [](const SizeResult& r) { return r.peak_heap_bytes / 1024.0; });
+    json_file << "\n  }\n";
+    json_file << "}\n";
+
+    std::cout << "\nРезультаты сохранены в " << output_file << std::endl;
+
+    if (!trace_file.empty()) {
+        trace::stop();
+        if (!trace::writeChromeJson(trace_file)) {
+            return 1;
+        }
+        std::cout << "Трасса сохранена в " << trace_file << std::endl;
+    }
     return 0;
-}
\ No newline at end of file
+}
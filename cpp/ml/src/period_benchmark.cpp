@@ -0,0 +1,294 @@
+/**
+ * @brief Бенчмарк автоматического выбора длины сезона (SeasonDetector)
+ *
+ * Синтетический парк: у каждого ряда свой период из {4, 7, 12, 24, 30, 52}
+ * или нет сезонности, плюс уровень, тренд и шум (детерминированно от
+ * номера ряда). Меряется скорость пакетного поиска (рядов в секунду),
+ * доля верно найденных периодов, выигрыш от упаковки пары рядов в одно
+ * FFT и от FFT против прямой ACF. FFT сверяется с прямым DFT, реальный
+ * ряд time_series.csv должен дать 7.
+ * Использование: period_benchmark [--series N] [--length L] [--threads T]
+ *                                 [--block B] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "time_series.h"
+#include "fft.h"
+#include "season_detector.h"
+
+namespace {
+
+const int kPeriods[] = {0, 4, 7, 12, 24, 30, 52};
+constexpr size_t kNumPeriods = sizeof(kPeriods) / sizeof(kPeriods[0]);
+
+/**
+ * @brief splitmix64: детерминированное число по индексу
+ */
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double uniform(uint64_t key) {
+    return (mix(key) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int truePeriod(size_t i) {
+    return kPeriods[mix(i * 7 + 3) % kNumPeriods];
+}
+
+/**
+ * @brief Ряд номер i: уровень 50-150, тренд, сезонный профиль случайной формы, шум
+ *
+ * Амплитуда профиля - около 10, шум - равномерный ±6 (SNR около 2).
+ */
+void makeSeries(size_t i, size_t length, double* out) {
+    int period = truePeriod(i);
+    double level = 50.0 + 100.0 * uniform(i * 5);
+    double trend = 0.05 * (uniform(i * 5 + 1) - 0.5);
+    double profile[64] = {};
+    if (period > 0) {
+        double mean = 0.0;
+        for (int s = 0; s < period; ++s) {
+            profile[s] = 20.0 * (uniform((i << 8) ^ s ^ 0x5EA50Dull) - 0.5);
+            mean += profile[s];
+        }
+        for (int s = 0; s < period; ++s) {
+            profile[s] -= mean / period;
+        }
+    }
+    size_t phase = static_cast<size_t>(uniform(i * 5 + 2) * 64);
+    for (size_t t = 0; t < length; ++t) {
+        double seasonal = period > 0 ? profile[(t + phase) % period] : 0.0;
+        double noise = 12.0 * (uniform((i << 24) ^ t ^ 0xC0FFEEull) - 0.5);
+        out[t] = level + trend * t + seasonal + noise;
+    }
+}
+
+/**
+ * @brief Наибольшее расхождение FFT с прямым DFT на случайном векторе длины n
+ */
+double fftError(size_t n) {
+    std::vector<std::complex<double>> x(n);
+    for (size_t t = 0; t < n; ++t) {
+        x[t] = {uniform(t * 2) - 0.5, uniform(t * 2 + 1) - 0.5};
+    }
+    std::vector<std::complex<double>> fast = x;
+    Fft plan(n);
+    plan.forward(fast.data());
+    double max_error = 0.0;
+    for (size_t k = 0; k < n; ++k) {
+        std::complex<double> sum(0.0, 0.0);
+        for (size_t t = 0; t < n; ++t) {
+            double angle = -2.0 * M_PI * static_cast<double>((k * t) % n) / static_cast<double>(n);
+            sum += x[t] * std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        max_error = std::max(max_error, std::abs(sum - fast[k]));
+    }
+    plan.inverse(fast.data());
+    for (size_t t = 0; t < n; ++t) {
+        max_error = std::max(max_error, std::abs(fast[t] - x[t]));
+    }
+    return max_error;
+}
+
+/**
+ * @brief Прямая ACF до max_lag (для сравнения скорости): O(n * max_lag)
+ */
+double directAcfChecksum(const double* series, size_t n, int max_lag, std::vector<double>& centered) {
+    double mean = 0.0;
+    for (size_t t = 0; t < n; ++t) {
+        mean += series[t];
+    }
+    mean /= n;
+    for (size_t t = 0; t < n; ++t) {
+        centered[t] = series[t] - mean;
+    }
+    double checksum = 0.0;
+    for (int lag = 0; lag <= max_lag; ++lag) {
+        double sum = 0.0;
+        for (size_t t = lag; t < n; ++t) {
+            sum += centered[t] * centered[t - lag];
+        }
+        checksum += sum;
+    }
+    return checksum;
+}
+
+double secondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/period_benchmark.json";
+    size_t num_series = 20000;
+    size_t length = 730;
+    size_t num_threads = 0;
+    size_t block_size = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--series" && i + 1 < argc) {
+            num_series = std::max<size_t>(1, std::stoul(argv[++i]));
+        } else if (arg == "--length" && i + 1 < argc) {
+            length = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoul(argv[++i]);
+        } else if (arg == "--block" && i + 1 < argc) {
+            block_size = std::stoul(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+    if (length < 3 * 52) {
+        std::cerr << "Ошибка: --length должна быть не меньше " << 3 * 52 << " (три самых длинных сезона)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== ПОИСК ДЛИНЫ СЕЗОНА (FFT + ACF) ===" << std::endl;
+
+    // 1. Сверка FFT с прямым DFT: степень двойки и Bluestein
+    double radix2_error = fftError(1024);
+    double bluestein_error = fftError(length == 1024 ? 730 : length);
+    std::cout << std::scientific << std::setprecision(2)
+              << "Сверка с DFT: radix-2 (1024) " << radix2_error
+              << ", Bluestein (" << (length == 1024 ? 730 : length) << ") " << bluestein_error << std::endl;
+
+    // 2. Реальный ряд
+    int real_period = 0;
+    double real_acf = 0.0;
+    TimeSeries ts;
+    if (ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        SeasonDetector detector(ts.size());
+        SeasonEstimate estimate = detector.detect(ts.view().data());
+        real_period = estimate.period;
+        real_acf = estimate.acf;
+        std::cout << std::fixed << std::setprecision(3) << "time_series.csv: сезон " << real_period
+                  << " (ACF " << real_acf << ", доля мощности " << estimate.power_share << ")" << std::endl;
+    }
+
+    // 3. Синтетический парк
+    std::vector<double> values(num_series * length);
+    for (size_t i = 0; i < num_series; ++i) {
+        makeSeries(i, length, values.data() + i * length);
+    }
+    SeasonDetectorOptions options;
+
+    auto batch_start = std::chrono::high_resolution_clock::now();
+    std::vector<SeasonEstimate> estimates =
+        SeasonDetector::detectBatch(values.data(), num_series, length, options, num_threads, block_size);
+    double batch_s = secondsSince(batch_start);
+
+    // Тот же поиск по одному ряду в одном потоке: без упаковки пар
+    const size_t single_series = std::min<size_t>(num_series, 5000);
+    SeasonDetector single(length, options);
+    size_t single_mismatch = 0;
+    auto single_start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < single_series; ++i) {
+        SeasonEstimate estimate = single.detect(values.data() + i * length);
+        single_mismatch += estimate.period != estimates[i].period ? 1 : 0;
+    }
+    double single_s = secondsSince(single_start);
+
+    // Пары в одном потоке - чистый выигрыш упаковки
+    std::vector<SeasonEstimate> paired(single_series);
+    auto pair_start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i + 1 < single_series; i += 2) {
+        single.detectPair(values.data() + i * length, values.data() + (i + 1) * length,
+                          paired[i], paired[i + 1]);
+    }
+    double pair_s = secondsSince(pair_start);
+
+    // Прямая ACF до того же max_period - без периодограммы и выбора
+    const size_t direct_series = std::min<size_t>(num_series, 2000);
+    std::vector<double> centered(length);
+    double checksum = 0.0;
+    auto direct_start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < direct_series; ++i) {
+        checksum += directAcfChecksum(values.data() + i * length, length, single.maxPeriod(), centered);
+    }
+    double direct_s = secondsSince(direct_start);
+
+    // Точность по истинным периодам
+    size_t correct = 0;
+    size_t per_total[kNumPeriods] = {};
+    size_t per_correct[kNumPeriods] = {};
+    for (size_t i = 0; i < num_series; ++i) {
+        int period = truePeriod(i);
+        size_t slot = std::find(kPeriods, kPeriods + kNumPeriods, period) - kPeriods;
+        ++per_total[slot];
+        if (estimates[i].period == period) {
+            ++correct;
+            ++per_correct[slot];
+        }
+    }
+    double accuracy = 100.0 * correct / num_series;
+    double batch_rate = num_series / batch_s;
+    double single_rate = single_series / single_s;
+    double pair_rate = (single_series & ~size_t(1)) / pair_s;
+    double direct_rate = direct_series / direct_s;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Рядов: " << num_series << " × " << length << " точек, max_period "
+              << single.maxPeriod() << ", ACF через FFT длины " << Fft::nextPowerOfTwo(2 * length) << std::endl;
+    std::cout << "Пакетно (потоков " << (num_threads ? std::to_string(num_threads) : std::string("все"))
+              << "): " << std::setprecision(0) << batch_rate << " рядов/с ("
+              << std::setprecision(1) << batch_s * 1000.0 << " мс)" << std::endl;
+    std::cout << "Один поток: по одному ряду " << std::setprecision(0) << single_rate
+              << " рядов/с, парами " << pair_rate << " рядов/с (x" << std::setprecision(2)
+              << pair_rate / single_rate << ")" << std::endl;
+    std::cout << "Прямая ACF до лага " << single.maxPeriod() << ": " << std::setprecision(0)
+              << direct_rate << " рядов/с (только ACF)" << std::endl;
+    std::cout << "Верно найдено: " << std::setprecision(1) << accuracy << "%" << std::endl;
+    for (size_t p = 0; p < kNumPeriods; ++p) {
+        std::cout << "  период " << std::setw(2) << kPeriods[p] << ": "
+                  << (per_total[p] ? 100.0 * per_correct[p] / per_total[p] : 0.0) << "% из "
+                  << per_total[p] << std::endl;
+    }
+    if (single_mismatch > 0) {
+        std::cerr << "Ошибка: пакетный и одиночный поиск разошлись на " << single_mismatch << " рядах" << std::endl;
+    }
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"num_series\": " << num_series << ",\n";
+    json_file << "  \"length\": " << length << ",\n";
+    json_file << "  \"max_period\": " << single.maxPeriod() << ",\n";
+    json_file << "  \"fft_error\": {\"radix2\": " << radix2_error << ", \"bluestein\": " << bluestein_error << "},\n";
+    json_file << "  \"real_series\": {\"period\": " << real_period << ", \"acf\": " << real_acf << "},\n";
+    json_file << "  \"batch_ms\": " << batch_s * 1000.0 << ",\n";
+    json_file << "  \"batch_series_per_sec\": " << batch_rate << ",\n";
+    json_file << "  \"single_series_per_sec\": " << single_rate << ",\n";
+    json_file << "  \"paired_series_per_sec\": " << pair_rate << ",\n";
+    json_file << "  \"direct_acf_series_per_sec\": " << direct_rate << ",\n";
+    json_file << "  \"direct_acf_checksum\": " << checksum << ",\n";
+    json_file << "  \"accuracy_percent\": " << accuracy << ",\n";
+    json_file << "  \"accuracy_by_period\": {";
+    for (size_t p = 0; p < kNumPeriods; ++p) {
+        json_file << "\"" << kPeriods[p] << "\": "
+                  << (per_total[p] ? 100.0 * per_correct[p] / per_total[p] : 0.0)
+                  << (p + 1 < kNumPeriods ? ", " : "");
+    }
+    json_file << "}\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return single_mismatch == 0 && real_period == 7 ? 0 : 1;
+}
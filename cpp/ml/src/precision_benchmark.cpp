@@ -0,0 +1,274 @@
+/**
+ * @brief Точность против скорости: double, float32 с double-вычислениями и float32
+ *
+ * 1. Один ряд time_series.csv: WAPE при параметрах main_ml и лучший WAPE по сетке
+ *    для каждого варианта точности, время fit на длинном ряде.
+ * 2. Парк рядов (производные от time_series.csv): время fit на точку
+ *    и расхождение WAPE с double по всем рядам.
+ * Использование: precision_benchmark [--series N] [--points N] [--repeat R] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "holt_winters_mixed.h"
+#include "metrics.h"
+
+namespace {
+
+/**
+ * @brief Результат одного варианта точности
+ */
+struct PrecisionResult {
+    std::string name;
+    double wape = 0.0;              ///< При параметрах main_ml
+    double max_forecast_diff = 0.0; ///< Максимальное расхождение прогноза с double
+    double best_wape = 0.0;         ///< Лучший по сетке
+    double best_alpha = 0.0;
+    double best_beta = 0.0;
+    double best_gamma = 0.0;
+    double fit_ns_per_point = 0.0;  ///< Один длинный ряд
+    double fleet_ns_per_point = 0.0;
+    double fleet_mean_wape_diff = 0.0;
+    double fleet_max_wape_diff = 0.0;
+    size_t fleet_bytes_per_point = 0;
+};
+
+const double kAlpha = 0.07, kBeta = 0.01, kGamma = 0.07;
+const double kTrainRatio = 0.7;
+const int kSeasonLength = 7;
+
+template <typename T>
+std::vector<T> convert(const std::vector<double>& data) {
+    return std::vector<T>(data.begin(), data.end());
+}
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/**
+ * @brief Вариант точности на одном ряде и на парке
+ * @param reference прогноз double при параметрах main_ml (пустой - это и есть double)
+ */
+template <typename Storage, typename Compute>
+PrecisionResult measure(const std::string& name,
+                        const std::vector<double>& train, const std::vector<double>& test,
+                        const std::vector<double>& long_series,
+                        const std::vector<double>& fleet_values, size_t num_series, size_t length,
+                        std::vector<double>& reference, std::vector<double>& fleet_reference,
+                        int repeat) {
+    PrecisionResult result;
+    result.name = name;
+    const auto train_s = convert<Storage>(train);
+    const auto test_s = convert<Storage>(test);
+    const int horizon = static_cast<int>(test.size());
+
+    // WAPE при параметрах main_ml
+    HoltWintersMixed<Storage, Compute> model(kSeasonLength);
+    model.fit(train_s, Compute(kAlpha), Compute(kBeta), Compute(kGamma));
+    auto forecast = model.predict(horizon);
+    result.wape = Metrics::wape(test_s.data(), forecast.data(), test.size());
+    if (reference.empty()) {
+        reference.assign(forecast.begin(), forecast.end());
+    }
+    for (int h = 0; h < horizon; ++h) {
+        result.max_forecast_diff = std::max(result.max_forecast_diff,
+                                            std::abs(static_cast<double>(forecast[h]) - reference[h]));
+    }
+
+    // Сетка как в first_tuning: лучший WAPE в каждой точности
+    result.best_wape = 1e300;
+    for (int a = 1; a <= 30; ++a) {
+        for (int b = 0; b <= 10; ++b) {
+            for (int g = 1; g <= 30; ++g) {
+                Compute alpha = Compute(a * 0.01), beta = Compute(b * 0.005), gamma = Compute(g * 0.01);
+                if (!model.fit(train_s, alpha, beta, gamma)) {
+                    continue;
+                }
+                model.predictInto(horizon, forecast.data());
+                double wape = Metrics::wape(test_s.data(), forecast.data(), test.size());
+                if (wape < result.best_wape) {
+                    result.best_wape = wape;
+                    result.best_alpha = alpha;
+                    result.best_beta = beta;
+                    result.best_gamma = gamma;
+                }
+            }
+        }
+    }
+
+    // Один длинный ряд: рекурсия последовательная, важна задержка
+    const auto long_s = convert<Storage>(long_series);
+    double best_ms = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        model.fit(long_s, Compute(kAlpha), Compute(kBeta), Compute(kGamma));
+        best_ms = std::min(best_ms, elapsedMs(start));
+    }
+    result.fit_ns_per_point = best_ms * 1e6 / long_s.size();
+
+    // Парк: ряды подряд в строке времени, шаг векторизуется по рядам
+    const auto fleet_s = convert<Storage>(fleet_values);
+    const size_t train_length = static_cast<size_t>(length * kTrainRatio);
+    HoltWintersMixedFleet<Storage, Compute> fleet(kSeasonLength);
+    best_ms = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fleet.fit(fleet_s.data(), num_series, length, train_length,
+                  Compute(kAlpha), Compute(kBeta), Compute(kGamma));
+        best_ms = std::min(best_ms, elapsedMs(start));
+    }
+    result.fleet_ns_per_point = best_ms * 1e6 / (static_cast<double>(num_series) * train_length);
+    result.fleet_bytes_per_point = sizeof(Storage);
+
+    auto wapes = fleet.evaluateWape();
+    if (fleet_reference.empty()) {
+        fleet_reference = wapes;
+    }
+    size_t counted = 0;
+    for (size_t i = 0; i < num_series; ++i) {
+        if (std::isnan(wapes[i]) || std::isnan(fleet_reference[i])) {
+            continue;
+        }
+        double diff = std::abs(wapes[i] - fleet_reference[i]);
+        result.fleet_mean_wape_diff += diff;
+        result.fleet_max_wape_diff = std::max(result.fleet_max_wape_diff, diff);
+        ++counted;
+    }
+    if (counted > 0) {
+        result.fleet_mean_wape_diff /= counted;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/precision_benchmark.json";
+    size_t num_series = 4096;
+    size_t points = 10000000;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--series" && i + 1 < argc) {
+            num_series = std::stoul(argv[++i]);
+        } else if (arg == "--points" && i + 1 < argc) {
+            points = std::stoul(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== ТОЧНОСТЬ ПРОТИВ СКОРОСТИ: DOUBLE / FLOAT32 ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    auto [train, test] = ts.split(kTrainRatio);
+    SeriesView base = ts.view();
+    const size_t length = base.size();
+
+    std::vector<double> long_series(points);
+    for (size_t i = 0; i < points; ++i) {
+        long_series[i] = base[i % length];
+    }
+
+    // Ряд i - исходный ряд с масштабом 0.5..1.5 и сдвигом на i % length дней
+    std::vector<double> fleet_values(num_series * length);
+    for (size_t i = 0; i < num_series; ++i) {
+        double scale = 0.5 + static_cast<double>(i % 101) / 100.0;
+        size_t shift = i % length;
+        for (size_t t = 0; t < length; ++t) {
+            fleet_values[t * num_series + i] = scale * base[(t + shift) % length];
+        }
+    }
+
+    // Проверка: HoltWintersMixed<double, double> совпадает с HoltWinters
+    HoltWinters baseline(kSeasonLength);
+    baseline.fit(train, kAlpha, kBeta, kGamma);
+    auto baseline_forecast = baseline.predict(static_cast<int>(test.size()));
+
+    std::vector<double> reference(baseline_forecast.begin(), baseline_forecast.end());
+    std::vector<double> fleet_reference;
+    std::vector<PrecisionResult> results;
+    results.push_back(measure<double, double>("double", train, test, long_series,
+                                              fleet_values, num_series, length,
+                                              reference, fleet_reference, repeat));
+    results.push_back(measure<float, double>("float32 + double", train, test, long_series,
+                                             fleet_values, num_series, length,
+                                             reference, fleet_reference, repeat));
+    results.push_back(measure<float, float>("float32", train, test, long_series,
+                                            fleet_values, num_series, length,
+                                            reference, fleet_reference, repeat));
+    // С -march=native компилятор может по-разному сжимать a * b + c в FMA
+    // в двух местах кода - тогда расхождение в последних битах
+    const bool identical = results[0].max_forecast_diff == 0.0;
+    const bool matches = results[0].max_forecast_diff <= 1e-9;
+
+    std::cout << "Ряд: " << length << " точек, длинный ряд: " << points
+              << ", парк: " << num_series << " рядов, повторов: " << repeat << std::endl;
+    std::cout << "\n           вариант   WAPE    |Δпрогноз|   лучший WAPE   fit, нс/т   парк, нс/т   |ΔWAPE| парка (ср./макс.)" << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::setw(18) << r.name
+                  << std::setw(9) << std::fixed << std::setprecision(4) << r.wape
+                  << std::setw(12) << std::scientific << std::setprecision(1) << r.max_forecast_diff
+                  << std::fixed << std::setw(11) << std::setprecision(4) << r.best_wape
+                  << std::setw(13) << std::setprecision(3) << r.fit_ns_per_point
+                  << std::setw(13) << r.fleet_ns_per_point
+                  << std::setw(12) << std::scientific << std::setprecision(1) << r.fleet_mean_wape_diff
+                  << " / " << r.fleet_max_wape_diff << std::fixed << std::endl;
+    }
+    std::cout << "\ndouble совпадает с HoltWinters: "
+              << (identical ? "да, до бита" : (matches ? "да, с точностью до FMA" : "НЕТ")) << std::endl;
+    std::cout << "Ускорение парка float32 + double: " << std::setprecision(2)
+              << results[0].fleet_ns_per_point / results[1].fleet_ns_per_point
+              << "x, float32: " << results[0].fleet_ns_per_point / results[2].fleet_ns_per_point
+              << "x" << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"series_length\": " << length << ",\n";
+    json_file << "  \"long_series_points\": " << points << ",\n";
+    json_file << "  \"fleet_series\": " << num_series << ",\n";
+    json_file << "  \"repeat\": " << repeat << ",\n";
+    json_file << "  \"double_matches_holt_winters\": " << (identical ? "true" : "false") << ",\n";
+    json_file << "  \"precision\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json_file << "    {\"name\": \"" << r.name << "\""
+                  << ", \"wape\": " << r.wape
+                  << ", \"max_forecast_diff\": " << r.max_forecast_diff
+                  << ", \"best_wape\": " << r.best_wape
+                  << ", \"best_alpha\": " << r.best_alpha
+                  << ", \"best_beta\": " << r.best_beta
+                  << ", \"best_gamma\": " << r.best_gamma
+                  << ", \"fit_ns_per_point\": " << r.fit_ns_per_point
+                  << ", \"fleet_ns_per_point\": " << r.fleet_ns_per_point
+                  << ", \"fleet_bytes_per_point\": " << r.fleet_bytes_per_point
+                  << ", \"fleet_mean_wape_diff\": " << r.fleet_mean_wape_diff
+                  << ", \"fleet_max_wape_diff\": " << r.fleet_max_wape_diff << "}"
+                  << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json_file << "  ]\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/**
+ * @brief Скользящая проверка параметров по всем разбиениям за один проход
+ *
+ * Для каждого (alpha, beta, gamma) сетки все фолды (train_ratios
+ * конфигурации) считаются Backtester за один проход рекурсии. Для
+ * сравнения те же фолды считаются переобучением с нуля на каждом
+ * разбиении (fit + predict, как в forth_tuning, с тем же окном
+ * инициализации) - метрики должны совпасть, время - нет.
+ *
+ * Для лучших параметров печатается и WAPE ровно как у TuningEngine:
+ * fit по всей обучающей части, включая начальные значения. Он отличается
+ * от WAPE фолдов только окном инициализации.
+ * Использование: rolling_cv [config] [--horizon H] [--scoring predict|forecast]
+ *                           [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "tuning_engine.h"
+#include "backtest.h"
+#include "metrics.h"
+
+int main(int argc, char* argv[]) {
+    std::string config_file = "../configs/forth_tuning.cfg";
+    std::string output_file = "../../../results/ml/rolling_cv.json";
+    size_t horizon = 0;
+    BacktestScoring scoring = BacktestScoring::Predict;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--horizon" && i + 1 < argc) {
+            horizon = std::stoul(argv[++i]);
+        } else if (arg == "--scoring" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "predict") {
+                scoring = BacktestScoring::Predict;
+            } else if (mode == "forecast") {
+                scoring = BacktestScoring::Forecast;
+            } else {
+                std::cerr << "Ошибка: --scoring должен быть predict или forecast" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else {
+            config_file = arg;
+        }
+    }
+
+    std::cout << "=== СКОЛЬЗЯЩАЯ ПРОВЕРКА (ROLLING ORIGIN) ===" << std::endl;
+
+    ParameterGrid grid;
+    try {
+        grid = ParameterGrid::loadConfig(config_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка конфигурации: " << e.what() << std::endl;
+        return 1;
+    }
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV(grid.data_file)) {
+        return 1;
+    }
+    SeriesView series = ts.view();
+
+    auto origins = Backtester::originsFromRatios(series.size(), grid.train_ratios);
+    Backtester backtester(origins, horizon, grid.season_length, scoring);
+    const bool predict_scoring = scoring == BacktestScoring::Predict;
+    const size_t param_sets = grid.alphas.size() * grid.betas.size() * grid.gammas.size();
+
+    std::cout << "Фолдов: " << origins.size() << " (origin:";
+    for (size_t origin : origins) {
+        std::cout << " " << origin;
+    }
+    std::cout << "), наборов параметров: " << param_sets
+              << ", прогноз: " << (predict_scoring ? "predict" : "forecast") << std::endl;
+
+    // WAPE фолда после fit на первых origin точках (init_size = 0 - по всем)
+    std::vector<double> actual, predicted;
+    auto refitWape = [&](size_t origin, double alpha, double beta, double gamma,
+                         size_t init_size, double& wape) {
+        HoltWinters model(grid.season_length);
+        if (!model.fit(series.data(), origin, alpha, beta, gamma, init_size)) {
+            return false;
+        }
+        size_t fold_horizon = horizon > 0 ? std::min(horizon, series.size() - origin)
+                                          : series.size() - origin;
+        actual.assign(series.begin() + origin, series.begin() + origin + fold_horizon);
+        if (predict_scoring) {
+            predicted = model.predict(static_cast<int>(fold_horizon));
+        } else {
+            predicted.resize(fold_horizon);
+            for (size_t h = 1; h <= fold_horizon; ++h) {
+                predicted[h - 1] = model.forecast(static_cast<int>(h));
+            }
+        }
+        wape = Metrics::wape(actual, predicted);
+        return true;
+    };
+
+    // 1. Один проход на набор параметров
+    BacktestResult best;
+    best.mean_wape = 1e300;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (double alpha : grid.alphas) {
+        for (double beta : grid.betas) {
+            for (double gamma : grid.gammas) {
+                BacktestResult result = backtester.run(series, alpha, beta, gamma);
+                if (result.mean_wape < best.mean_wape) {
+                    best = std::move(result);
+                }
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double single_pass_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // 2. Эталон: переобучение на каждом разбиении с тем же окном инициализации
+    double best_refit_wape = 1e300;
+    start = std::chrono::high_resolution_clock::now();
+    for (double alpha : grid.alphas) {
+        for (double beta : grid.betas) {
+            for (double gamma : grid.gammas) {
+                double wape_sum = 0.0;
+                for (size_t origin : origins) {
+                    double wape = 0.0;
+                    if (!refitWape(origin, alpha, beta, gamma, origins.front(), wape)) {
+                        std::cerr << "Ошибка: fit не удался (origin " << origin << ")" << std::endl;
+                        return 1;
+                    }
+                    wape_sum += wape;
+                }
+                best_refit_wape = std::min(best_refit_wape, wape_sum / origins.size());
+            }
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double refit_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    // 3. Лучшие параметры так, как их оценивает TuningEngine: инициализация по всему обучению
+    double tuner_wape = 0.0;
+    for (size_t origin : origins) {
+        double wape = 0.0;
+        if (!refitWape(origin, best.alpha, best.beta, best.gamma, 0, wape)) {
+            std::cerr << "Ошибка: fit не удался (origin " << origin << ")" << std::endl;
+            return 1;
+        }
+        tuner_wape += wape;
+    }
+    tuner_wape /= origins.size();
+
+    std::cout << "\nЛучшие параметры: α=" << std::fixed << std::setprecision(4) << best.alpha
+              << " β=" << best.beta << " γ=" << best.gamma << std::endl;
+    std::cout << std::setw(8) << "origin" << std::setw(10) << "horizon"
+              << std::setw(12) << "WAPE" << std::setw(12) << "MAE" << std::setw(12) << "RMSE" << std::endl;
+    for (const auto& fold : best.folds) {
+        std::cout << std::setw(8) << fold.origin << std::setw(10) << fold.horizon
+                  << std::setw(11) << std::setprecision(3) << fold.wape << "%"
+                  << std::setw(12) << std::setprecision(2) << fold.mae
+                  << std::setw(12) << fold.rmse << std::endl;
+    }
+    std::cout << "Среднее: WAPE " << std::setprecision(3) << best.mean_wape << "%, MAE "
+              << std::setprecision(2) << best.mean_mae << ", RMSE " << best.mean_rmse << std::endl;
+    std::cout << "Те же параметры с инициализацией по всему обучению (как TuningEngine): WAPE "
+              << std::setprecision(3) << tuner_wape << "%" << std::endl;
+
+    bool match = std::abs(best.mean_wape - best_refit_wape) < 1e-9;
+    std::cout << "\nОдин проход:   " << std::setprecision(1) << single_pass_ms << " мс" << std::endl;
+    std::cout << "Переобучение:  " << refit_ms << " мс" << std::endl;
+    std::cout << "Ускорение: " << std::setprecision(2) << refit_ms / single_pass_ms << "x, "
+              << (match ? "метрики совпадают" : "МЕТРИКИ РАЗЛИЧАЮТСЯ") << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"rolling_cv\": {\n";
+    json_file << "    \"param_sets\": " << param_sets << ",\n";
+    json_file << "    \"scoring\": \"" << (predict_scoring ? "predict" : "forecast") << "\",\n";
+    json_file << "    \"single_pass_ms\": " << single_pass_ms << ",\n";
+    json_file << "    \"refit_ms\": " << refit_ms << ",\n";
+    json_file << "    \"speedup\": " << refit_ms / single_pass_ms << ",\n";
+    json_file << "    \"metrics_match\": " << (match ? "true" : "false") << ",\n";
+    json_file << "    \"best\": {\"alpha\": " << best.alpha << ", \"beta\": " << best.beta
+              << ", \"gamma\": " << best.gamma << ", \"mean_wape\": " << best.mean_wape
+              << ", \"mean_mae\": " << best.mean_mae << ", \"mean_rmse\": " << best.mean_rmse
+              << ", \"tuner_mean_wape\": " << tuner_wape << "},\n";
+    json_file << "    \"folds\": [\n";
+    for (size_t i = 0; i < best.folds.size(); ++i) {
+        const auto& fold = best.folds[i];
+        json_file << "      {\"origin\": " << fold.origin << ", \"horizon\": " << fold.horizon
+                  << ", \"wape\": " << fold.wape << ", \"mae\": " << fold.mae
+                  << ", \"rmse\": " << fold.rmse << "}"
+                  << (i + 1 < best.folds.size() ? "," : "") << "\n";
+    }
+    json_file << "    ]\n";
+    json_file << "  }\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return match ? 0 : 1;
+}
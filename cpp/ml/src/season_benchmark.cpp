@@ -0,0 +1,133 @@
+/**
+ * @brief Цена одной точки fit: HoltWinters (длина сезона во время выполнения)
+ * против HoltWintersFixed<SeasonLen> (длина сезона при компиляции)
+ *
+ * Ряд собирается повторением time_series.csv до нужной длины.
+ * Использование: season_benchmark [--points N] [--repeat R] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "holt_winters_fixed.h"
+
+namespace {
+
+/**
+ * @brief Результат сравнения для одной длины сезона
+ */
+struct SeasonResult {
+    int season_length = 0;
+    double runtime_ns_per_point = 0.0;
+    double fixed_ns_per_point = 0.0;
+    double max_diff = 0.0;
+};
+
+template <int SeasonLen>
+SeasonResult compare(const std::vector<double>& data, int repeat) {
+    const double alpha = 0.07, beta = 0.01, gamma = 0.07;
+    SeasonResult result;
+    result.season_length = SeasonLen;
+
+    HoltWinters runtime_model(SeasonLen);
+    HoltWintersFixed<SeasonLen> fixed_model;
+
+    double runtime_ms = 1e300;
+    double fixed_ms = 1e300;
+    for (int r = 0; r < repeat; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        runtime_model.fit(data.data(), data.size(), alpha, beta, gamma);
+        auto mid = std::chrono::high_resolution_clock::now();
+        fixed_model.fit(data.data(), data.size(), alpha, beta, gamma);
+        auto end = std::chrono::high_resolution_clock::now();
+        runtime_ms = std::min(runtime_ms, std::chrono::duration<double, std::milli>(mid - start).count());
+        fixed_ms = std::min(fixed_ms, std::chrono::duration<double, std::milli>(end - mid).count());
+    }
+
+    result.runtime_ns_per_point = runtime_ms * 1e6 / data.size();
+    result.fixed_ns_per_point = fixed_ms * 1e6 / data.size();
+
+    result.max_diff = std::max(std::abs(runtime_model.getLevel() - fixed_model.getLevel()),
+                               std::abs(runtime_model.getTrend() - fixed_model.getTrend()));
+    for (int s = 0; s < SeasonLen; ++s) {
+        result.max_diff = std::max(result.max_diff,
+                                   std::abs(runtime_model.getSeasonal()[s] - fixed_model.getSeasonal()[s]));
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/season_specialization.json";
+    size_t points = 10000000;
+    int repeat = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--points" && i + 1 < argc) {
+            points = std::stoul(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== СПЕЦИАЛИЗАЦИЯ ПО ДЛИНЕ СЕЗОНА ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesView base = ts.view();
+    std::vector<double> data(points);
+    for (size_t i = 0; i < points; ++i) {
+        data[i] = base[i % base.size()];
+    }
+
+    std::vector<SeasonResult> results = {compare<7>(data, repeat), compare<24>(data, repeat)};
+
+    std::cout << "Точек: " << points << ", повторов: " << repeat << " (лучшее время)" << std::endl;
+    std::cout << "   сезон       HoltWinters   HoltWintersFixed   ускорение   расхождение" << std::endl;
+    bool equal = true;
+    for (const auto& r : results) {
+        std::cout << std::setw(8) << r.season_length
+                  << std::setw(13) << std::fixed << std::setprecision(3) << r.runtime_ns_per_point << " нс/т"
+                  << std::setw(15) << r.fixed_ns_per_point << " нс/т"
+                  << std::setw(11) << std::setprecision(2) << r.runtime_ns_per_point / r.fixed_ns_per_point << "x"
+                  << std::setw(14) << std::scientific << std::setprecision(1) << r.max_diff
+                  << std::fixed << std::endl;
+        equal = equal && r.max_diff == 0.0;
+    }
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"points\": " << points << ",\n";
+    json_file << "  \"repeat\": " << repeat << ",\n";
+    json_file << "  \"season_specialization\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json_file << "    {\"season_length\": " << r.season_length
+                  << ", \"runtime_ns_per_point\": " << r.runtime_ns_per_point
+                  << ", \"fixed_ns_per_point\": " << r.fixed_ns_per_point
+                  << ", \"speedup\": " << r.runtime_ns_per_point / r.fixed_ns_per_point
+                  << ", \"max_diff\": " << r.max_diff << "}"
+                  << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json_file << "  ]\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return equal ? 0 : 1;
+}
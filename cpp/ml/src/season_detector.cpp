@@ -0,0 +1,266 @@
+#include "season_detector.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Делитель заменяет кратный период, если его ACF не ниже этой доли
+ */
+constexpr double kDivisorAcfRatio = 0.85;
+
+} // namespace
+
+SeasonDetector::SeasonDetector(size_t length, const SeasonDetectorOptions& options)
+    : series_length(length),
+      min_period(options.min_period),
+      max_period(options.max_period > 0 ? options.max_period : static_cast<int>(length / 3)),
+      min_acf(options.min_acf),
+      candidates(std::max<size_t>(1, options.candidates)),
+      spectrum_plan(std::max<size_t>(1, length)),
+      acf_plan(Fft::nextPowerOfTwo(2 * std::max<size_t>(1, length))) {
+    if (min_period < 2 || static_cast<size_t>(2 * min_period) > length) {
+        throw std::invalid_argument("SeasonDetector: ряд короче двух минимальных сезонов");
+    }
+    if (max_period < min_period || static_cast<size_t>(max_period) >= length) {
+        throw std::invalid_argument("SeasonDetector: max_period должен быть в [min_period, length)");
+    }
+    spectrum.resize(length);
+    padded.resize(acf_plan.size());
+    for (int s = 0; s < 2; ++s) {
+        detrended[s].resize(length);
+        power[s].resize(length / 2 + 1);
+        acf[s].resize(static_cast<size_t>(max_period) + 2);
+    }
+}
+
+bool SeasonDetector::detrend(const double* series, std::vector<double>& out) const {
+    const size_t n = series_length;
+    // МНК-прямая по t = 0..n-1: суммы t и t^2 известны в закрытом виде
+    double sum_y = 0.0, sum_ty = 0.0;
+    for (size_t t = 0; t < n; ++t) {
+        sum_y += series[t];
+        sum_ty += static_cast<double>(t) * series[t];
+    }
+    double dn = static_cast<double>(n);
+    double mean_t = (dn - 1.0) / 2.0;
+    double var_t = (dn * dn - 1.0) / 12.0;
+    double mean_y = sum_y / dn;
+    double slope = (sum_ty / dn - mean_t * mean_y) / var_t;
+    double intercept = mean_y - slope * mean_t;
+
+    double energy = 0.0;
+    for (size_t t = 0; t < n; ++t) {
+        out[t] = series[t] - (intercept + slope * static_cast<double>(t));
+        energy += out[t] * out[t];
+    }
+    return std::isfinite(energy) && energy > 1e-12 * std::max(1.0, mean_y * mean_y) * dn;
+}
+
+void SeasonDetector::computeSpectra() {
+    const size_t n = series_length;
+    const size_t m = acf_plan.size();
+
+    // Периодограмма пары: z = x + iy, X[k] = (Z[k] + conj(Z[n-k])) / 2, Y[k] = (Z[k] - conj(Z[n-k])) / 2i
+    for (size_t t = 0; t < n; ++t) {
+        spectrum[t] = {detrended[0][t], detrended[1][t]};
+    }
+    spectrum_plan.forward(spectrum.data());
+    for (size_t k = 0; k <= n / 2; ++k) {
+        std::complex<double> z = spectrum[k];
+        std::complex<double> zc = std::conj(spectrum[(n - k) % n]);
+        std::complex<double> sum = z + zc;
+        std::complex<double> diff = z - zc;
+        power[0][k] = 0.25 * std::norm(sum);
+        power[1][k] = 0.25 * std::norm(diff);
+    }
+
+    // ACF пары: спектры мощности вещественны и четны, поэтому одно обратное
+    // преобразование (Px + iPy) дает автоковариации x в real и y в imag
+    std::fill(padded.begin(), padded.end(), std::complex<double>(0.0, 0.0));
+    for (size_t t = 0; t < n; ++t) {
+        padded[t] = {detrended[0][t], detrended[1][t]};
+    }
+    acf_plan.forward(padded.data());
+    for (size_t k = 0; k <= m / 2; ++k) {
+        std::complex<double> z = padded[k];
+        std::complex<double> zc = std::conj(padded[(m - k) % m]);
+        std::complex<double> packed(0.25 * std::norm(z + zc), 0.25 * std::norm(z - zc));
+        padded[k] = packed;
+        padded[(m - k) % m] = packed;
+    }
+    acf_plan.inverse(padded.data());
+    for (int s = 0; s < 2; ++s) {
+        double lag0 = s == 0 ? padded[0].real() : padded[0].imag();
+        for (size_t lag = 0; lag < acf[s].size(); ++lag) {
+            double value = s == 0 ? padded[lag].real() : padded[lag].imag();
+            acf[s][lag] = lag0 > 0.0 ? value / lag0 : 0.0;
+        }
+    }
+}
+
+SeasonEstimate SeasonDetector::choose(const std::vector<double>& power_values,
+                                      const std::vector<double>& acf_values) {
+    const size_t n = series_length;
+    const size_t half = n / 2;
+    size_t k_min = std::max<size_t>(1, (n + max_period - 1) / max_period);
+    size_t k_max = std::min(half, n / min_period);
+
+    double total_power = 0.0;
+    for (size_t k = 1; k <= half; ++k) {
+        total_power += power_values[k];
+    }
+
+    peaks.clear();
+    for (size_t k = k_min; k <= k_max; ++k) {
+        bool above_left = power_values[k] > power_values[k - 1];
+        bool above_right = k == half || power_values[k] >= power_values[k + 1];
+        if (above_left && above_right) {
+            peaks.push_back(k);
+        }
+    }
+    size_t keep = std::min(candidates, peaks.size());
+    std::partial_sort(peaks.begin(), peaks.begin() + keep, peaks.end(),
+                      [&](size_t a, size_t b) { return power_values[a] > power_values[b]; });
+
+    // Кандидаты: периоды пиков и их кратные (у профиля сложной формы
+    // основная частота бывает слабее гармоник n / (j * period))
+    hills.clear();
+    for (size_t c = 0; c < keep; ++c) {
+        size_t k = peaks[c];
+        double period_lo = static_cast<double>(n) / (k + 1);
+        double period_hi = k > 1 ? static_cast<double>(n) / (k - 1) : static_cast<double>(max_period);
+        for (int multiple = 1; multiple * period_lo <= max_period; ++multiple) {
+            // Период между периодами соседних частот, умноженными на multiple
+            int lo = std::max(static_cast<int>(multiple * period_lo), min_period);
+            int hi = std::min(static_cast<int>(std::ceil(multiple * period_hi)), max_period);
+            double share = total_power > 0.0 ? power_values[k] / total_power : 0.0;
+            for (int lag = lo; lag <= hi; ++lag) {
+                double value = acf_values[lag];
+                if (value >= acf_values[lag - 1] && value >= acf_values[lag + 1]) {
+                    hills.push_back({lag, value, share});
+                }
+            }
+        }
+    }
+
+    SeasonEstimate best;
+    best.acf = -1.0;
+    for (const auto& hill : hills) {
+        if (hill.acf > best.acf || (hill.acf == best.acf && hill.period < best.period)) {
+            best = hill;
+        }
+    }
+    // Кратное истинного периода коррелирует почти так же: берем наименьший
+    // делитель победителя, чья автокорреляция не сильно ниже
+    const SeasonEstimate winner = best;
+    for (const auto& hill : hills) {
+        if (winner.period == 0 || hill.period >= best.period) {
+            continue;
+        }
+        int multiple = static_cast<int>(std::lround(static_cast<double>(winner.period) / hill.period));
+        bool divides = multiple >= 2 && std::abs(winner.period - multiple * hill.period) <= 1;
+        if (divides && hill.acf >= kDivisorAcfRatio * winner.acf) {
+            best = hill;
+        }
+    }
+
+    if (best.period == 0 || best.acf < min_acf) {
+        SeasonEstimate none;
+        none.acf = std::max(best.acf, 0.0);
+        none.power_share = best.power_share;
+        return none;
+    }
+    return best;
+}
+
+SeasonEstimate SeasonDetector::detect(const double* series) {
+    SeasonEstimate estimate;
+    if (!detrend(series, detrended[0])) {
+        return estimate;
+    }
+    std::fill(detrended[1].begin(), detrended[1].end(), 0.0);
+    computeSpectra();
+    return choose(power[0], acf[0]);
+}
+
+void SeasonDetector::detectPair(const double* first, const double* second,
+                                SeasonEstimate& first_estimate, SeasonEstimate& second_estimate) {
+    bool first_valid = detrend(first, detrended[0]);
+    bool second_valid = detrend(second, detrended[1]);
+    // Постоянный ряд дает нулевой вклад и не мешает второму
+    if (!first_valid) {
+        std::fill(detrended[0].begin(), detrended[0].end(), 0.0);
+    }
+    if (!second_valid) {
+        std::fill(detrended[1].begin(), detrended[1].end(), 0.0);
+    }
+    first_estimate = SeasonEstimate();
+    second_estimate = SeasonEstimate();
+    if (!first_valid && !second_valid) {
+        return;
+    }
+    computeSpectra();
+    if (first_valid) {
+        first_estimate = choose(power[0], acf[0]);
+    }
+    if (second_valid) {
+        second_estimate = choose(power[1], acf[1]);
+    }
+}
+
+std::vector<SeasonEstimate> SeasonDetector::detectBatch(const double* values, size_t num_series, size_t length,
+                                                        const SeasonDetectorOptions& options,
+                                                        size_t num_threads, size_t block_size) {
+    std::vector<SeasonEstimate> estimates(num_series);
+    if (num_series == 0) {
+        return estimates;
+    }
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    block_size = std::max<size_t>(2, block_size);
+    size_t num_blocks = (num_series + block_size - 1) / block_size;
+    num_threads = std::max<size_t>(1, std::min(num_threads, num_blocks));
+
+    // Проверка параметров до запуска потоков: исключение - в вызывающий поток
+    SeasonDetector first_detector(length, options);
+
+    std::atomic<size_t> next(0);
+    auto worker = [&](SeasonDetector& detector) {
+        for (;;) {
+            size_t block = next.fetch_add(1);
+            if (block >= num_blocks) {
+                break;
+            }
+            size_t begin = block * block_size;
+            size_t end = std::min(begin + block_size, num_series);
+            TRACE_SPAN_VALUE("SeasonDetector block", begin);
+            size_t i = begin;
+            for (; i + 1 < end; i += 2) {
+                detector.detectPair(values + i * length, values + (i + 1) * length,
+                                    estimates[i], estimates[i + 1]);
+            }
+            if (i < end) {
+                estimates[i] = detector.detect(values + i * length);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back([&]() {
+            SeasonDetector detector(length, options);
+            worker(detector);
+        });
+    }
+    worker(first_detector);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return estimates;
+}
@@ -0,0 +1,271 @@
+#include "series_matrix.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace {
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+/**
+ * @brief Курсор по одной строке CSV
+ */
+struct LineCursor {
+    const char* pos;
+    const char* end;
+    char delimiter;
+
+    bool atEnd() const { return pos > end; }
+
+    /**
+     * @brief Возвращает следующее поле [begin, end) и сдвигается за разделитель
+     *
+     * Кавычки снимаются; "" внутри кавычек в имени не раскрывается
+     * (для чисел кавычки не используются).
+     */
+    void next(const char*& field_begin, const char*& field_end) {
+        if (pos < end && *pos == '"') {
+            field_begin = ++pos;
+            while (pos < end && !(*pos == '"' && (pos + 1 >= end || pos[1] != '"'))) {
+                pos += (*pos == '"') ? 2 : 1;
+            }
+            field_end = pos;
+            if (pos < end) {
+                ++pos; // закрывающая кавычка
+            }
+            while (pos < end && *pos != delimiter) {
+                ++pos;
+            }
+        } else {
+            field_begin = pos;
+            const char* found = static_cast<const char*>(std::memchr(pos, delimiter, end - pos));
+            pos = found ? found : end;
+            field_end = pos;
+        }
+        ++pos; // разделитель (или шаг за конец строки)
+    }
+};
+
+/**
+ * @brief Конец строки без \r\n
+ */
+const char* lineEnd(const char* begin, const char* file_end, const char*& next_line) {
+    const char* nl = static_cast<const char*>(std::memchr(begin, '\n', file_end - begin));
+    next_line = nl ? nl + 1 : file_end;
+    const char* end = nl ? nl : file_end;
+    if (end > begin && end[-1] == '\r') {
+        --end;
+    }
+    return end;
+}
+
+/**
+ * @brief Разбирает число; пустое поле или мусор (в том числе после числа, "12abc") - пропуск
+ */
+double parseValue(const char* begin, const char* end, size_t& missing) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) {
+        ++begin;
+    }
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) {
+        --end;
+    }
+    double value = 0.0;
+    auto result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc() || begin == end || result.ptr != end) {
+        ++missing;
+        return kMissing;
+    }
+    return value;
+}
+
+/**
+ * @brief Количество непустых строк в [begin, end)
+ */
+size_t countLines(const char* begin, const char* end) {
+    size_t count = 0;
+    const char* pos = begin;
+    while (pos < end) {
+        const char* next_line;
+        const char* line_end = lineEnd(pos, end, next_line);
+        if (line_end > pos) {
+            ++count;
+        }
+        pos = next_line;
+    }
+    return count;
+}
+
+/**
+ * @brief Запускает fn(chunk) для каждого куска в своем потоке
+ */
+template <typename Fn>
+void runChunks(size_t num_chunks, Fn&& fn) {
+    std::vector<std::thread> threads;
+    for (size_t c = 1; c < num_chunks; ++c) {
+        threads.emplace_back(fn, c);
+    }
+    fn(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+bool SeriesMatrix::loadWideCSV(const std::string& filename, const CsvLoadOptions& options) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    names.clear();
+    dates.clear();
+    values.clear();
+    series_length = 0;
+    stats = CsvLoadStats();
+
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    const char* data = file.data();
+    const char* file_end = data + file.size();
+    if (file.size() == 0) {
+        std::cerr << "Ошибка: файл " << filename << " пуст" << std::endl;
+        return false;
+    }
+
+    // Заголовок: имена колонок
+    const char* body;
+    const char* header_end = lineEnd(data, file_end, body);
+    std::vector<std::string> header;
+    LineCursor cursor{data, header_end, options.delimiter};
+    while (!cursor.atEnd()) {
+        const char* b;
+        const char* e;
+        cursor.next(b, e);
+        header.emplace_back(b, e);
+    }
+    if (header.size() < 2) {
+        std::cerr << "Ошибка: в заголовке " << filename << " меньше двух колонок" << std::endl;
+        return false;
+    }
+    const size_t value_columns = header.size() - 1;
+
+    // Куски по границам строк
+    size_t num_threads = options.num_threads;
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t body_size = static_cast<size_t>(file_end - body);
+    num_threads = std::max<size_t>(1, std::min(num_threads, body_size / (1 << 16) + 1));
+    std::vector<const char*> bounds(num_threads + 1);
+    bounds[0] = body;
+    bounds[num_threads] = file_end;
+    for (size_t c = 1; c < num_threads; ++c) {
+        const char* guess = body + body_size * c / num_threads;
+        guess = std::max(guess, bounds[c - 1]);
+        const char* nl = static_cast<const char*>(std::memchr(guess, '\n', file_end - guess));
+        bounds[c] = nl ? nl + 1 : file_end;
+    }
+
+    // Проход 1: строк в каждом куске -> номер первой строки куска
+    std::vector<size_t> chunk_rows(num_threads, 0);
+    runChunks(num_threads, [&](size_t c) {
+        chunk_rows[c] = countLines(bounds[c], bounds[c + 1]);
+    });
+    std::vector<size_t> first_row(num_threads + 1, 0);
+    for (size_t c = 0; c < num_threads; ++c) {
+        first_row[c + 1] = first_row[c] + chunk_rows[c];
+    }
+    const size_t rows = first_row[num_threads];
+    if (rows == 0) {
+        std::cerr << "Ошибка: в " << filename << " нет строк данных" << std::endl;
+        return false;
+    }
+
+    const bool per_row = options.layout == CsvLayout::SeriesPerRow;
+    const size_t num_series = per_row ? rows : value_columns;
+    series_length = per_row ? value_columns : rows;
+    values.assign(num_series * series_length, kMissing);
+    if (per_row) {
+        names.resize(rows);
+        dates.assign(header.begin() + 1, header.end());
+    } else {
+        names.assign(header.begin() + 1, header.end());
+        dates.resize(rows);
+    }
+
+    // Проход 2: разбор прямо в матрицу
+    std::vector<size_t> chunk_missing(num_threads, 0);
+    runChunks(num_threads, [&](size_t c) {
+        size_t row = first_row[c];
+        size_t missing = 0;
+        const char* pos = bounds[c];
+        const char* end = bounds[c + 1];
+        while (pos < end) {
+            const char* next_line;
+            const char* line_end = lineEnd(pos, end, next_line);
+            if (line_end == pos) {
+                pos = next_line;
+                continue;
+            }
+
+            LineCursor line{pos, line_end, options.delimiter};
+            const char* b;
+            const char* e;
+            line.next(b, e);
+            if (per_row) {
+                names[row].assign(b, e);
+            } else {
+                dates[row].assign(b, e);
+            }
+
+            size_t column = 0;
+            for (; column < value_columns && !line.atEnd(); ++column) {
+                line.next(b, e);
+                double value = parseValue(b, e, missing);
+                size_t index = per_row ? row * series_length + column
+                                       : column * series_length + row;
+                values[index] = value;
+            }
+            // Недостающие колонки в конце строки - тоже пропуски
+            missing += value_columns - column;
+
+            ++row;
+            pos = next_line;
+        }
+        chunk_missing[c] = missing;
+    });
+
+    for (size_t missing : chunk_missing) {
+        stats.missing += missing;
+    }
+
+    if (options.missing != MissingPolicy::KeepNaN && stats.missing > 0) {
+        runChunks(num_threads, [&](size_t c) {
+            for (size_t i = c; i < num_series; i += num_threads) {
+                double* s = values.data() + i * series_length;
+                double previous = 0.0;
+                for (size_t t = 0; t < series_length; ++t) {
+                    if (std::isnan(s[t])) {
+                        s[t] = options.missing == MissingPolicy::Zero ? 0.0 : previous;
+                    }
+                    previous = s[t];
+                }
+            }
+        });
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    stats.bytes = file.size();
+    stats.rows = rows;
+    stats.num_threads = num_threads;
+    stats.elapsed_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    stats.mb_per_sec = stats.elapsed_ms > 0
+        ? (stats.bytes / (1024.0 * 1024.0)) / (stats.elapsed_ms / 1000.0) : 0.0;
+    return true;
+}
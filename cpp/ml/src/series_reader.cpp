@@ -0,0 +1,132 @@
+#include "series_reader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+CsvColumnReader::CsvColumnReader(const std::string& filename, int value_col, size_t buffer_size)
+    : file(filename, std::ios::binary), value_col(value_col),
+      buffer(std::max<size_t>(buffer_size, 4096)) {
+    if (!file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+    }
+}
+
+bool CsvColumnReader::refill() {
+    if (eof) {
+        return false;
+    }
+    // Хвост незаконченной строки переносится в начало буфера
+    size_t tail = end - begin;
+    if (tail == buffer.size()) {
+        // Строка длиннее буфера - растим буфер
+        buffer.resize(buffer.size() * 2);
+    }
+    std::memmove(buffer.data(), buffer.data() + begin, tail);
+    begin = 0;
+    end = tail;
+    file.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+    size_t got = static_cast<size_t>(file.gcount());
+    end += got;
+    if (got == 0) {
+        eof = true;
+        // Последняя строка без перевода строки
+        if (end > begin) {
+            buffer.resize(std::max(buffer.size(), end + 1));
+            buffer[end++] = '\n';
+            return true;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool CsvColumnReader::parseLine(const char* line, const char* line_end, double& value) const {
+    if (line_end > line && line_end[-1] == '\r') {
+        --line_end;
+    }
+    const char* field = line;
+    for (int col = 0; col < value_col; ++col) {
+        const char* comma = static_cast<const char*>(std::memchr(field, ',', line_end - field));
+        if (!comma) {
+            return false;
+        }
+        field = comma + 1;
+    }
+    const char* field_end = static_cast<const char*>(std::memchr(field, ',', line_end - field));
+    if (!field_end) {
+        field_end = line_end;
+    }
+    while (field < field_end && *field == ' ') {
+        ++field;
+    }
+    auto result = std::from_chars(field, field_end, value);
+    return result.ec == std::errc() && field != field_end;
+}
+
+size_t CsvColumnReader::read(double* out, size_t max_count) {
+    if (!file.is_open()) {
+        return 0;
+    }
+    size_t count = 0;
+    while (count < max_count) {
+        const char* data = buffer.data();
+        const char* nl = static_cast<const char*>(std::memchr(data + begin, '\n', end - begin));
+        if (!nl) {
+            if (!refill()) {
+                break;
+            }
+            continue;
+        }
+        const char* line = data + begin;
+        begin = static_cast<size_t>(nl - data) + 1;
+        if (!header_skipped) {
+            header_skipped = true;
+            continue;
+        }
+        if (nl == line || (nl == line + 1 && *line == '\r')) {
+            continue;
+        }
+        double value;
+        if (parseLine(line, nl, value)) {
+            out[count++] = value;
+        } else {
+            ++skipped_lines;
+        }
+    }
+    return count;
+}
+
+StoreSeriesReader::StoreSeriesReader(const std::string& filename, const std::string& series_name) {
+    if (!store.open(filename)) {
+        series = 0;
+        return;
+    }
+    series = series_name.empty() ? 0 : store.find(series_name);
+    if (series >= store.numSeries()) {
+        std::cerr << "Ошибка: в " << filename << " нет ряда "
+                  << (series_name.empty() ? "(хранилище пусто)" : series_name) << std::endl;
+    }
+}
+
+size_t StoreSeriesReader::read(double* out, size_t max_count) {
+    if (!isOpen()) {
+        return 0;
+    }
+    size_t count = std::min(max_count, store.length() - position);
+    if (const double* f64 = store.seriesF64(series)) {
+        std::copy(f64 + position, f64 + position + count, out);
+    } else {
+        const float* f32 = store.seriesF32(series);
+        std::copy(f32 + position, f32 + position + count, out);
+    }
+    position += count;
+
+    // Отдаем прочитанное ядру крупными кусками (~4 МБ)
+    const size_t kReleaseStep = 1 << 19;
+    if (position - released >= kReleaseStep || (count == 0 && position > released)) {
+        store.releaseValues(series, released, position);
+        released = position;
+    }
+    return count;
+}
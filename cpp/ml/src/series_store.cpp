@@ -0,0 +1,160 @@
+#include "series_store.h"
+#include "string_table.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+constexpr char SeriesStore::kMagic[8];
+
+bool SeriesStore::write(const std::string& filename,
+                        const std::vector<std::string>& names,
+                        const std::vector<std::string>& dates,
+                        const double* values, size_t length,
+                        StoreValueType type) {
+    if (!dates.empty() && dates.size() != length) {
+        std::cerr << "Ошибка: число дат (" << dates.size() << ") не равно длине ряда ("
+                  << length << ")" << std::endl;
+        return false;
+    }
+
+    StoreHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.value_type = static_cast<uint32_t>(type);
+    header.num_series = names.size();
+    header.length = length;
+    header.dates_offset = sizeof(StoreHeader);
+    header.names_offset = string_table::alignUp(header.dates_offset + string_table::size(dates), sizeof(uint64_t));
+    header.values_offset = string_table::alignUp(header.names_offset + string_table::size(names), kValueAlignment);
+    size_t element = type == StoreValueType::Float64 ? sizeof(double) : sizeof(float);
+    header.file_size = header.values_offset + header.num_series * length * element;
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    string_table::write(out, dates);
+    string_table::writePadding(out, header.dates_offset + string_table::size(dates), header.names_offset);
+    string_table::write(out, names);
+    string_table::writePadding(out, header.names_offset + string_table::size(names), header.values_offset);
+
+    size_t total = header.num_series * length;
+    if (type == StoreValueType::Float64) {
+        out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(total * sizeof(double)));
+    } else {
+        std::vector<float> converted(length);
+        for (size_t i = 0; i < header.num_series; ++i) {
+            for (size_t t = 0; t < length; ++t) {
+                converted[t] = static_cast<float>(values[i * length + t]);
+            }
+            out.write(reinterpret_cast<const char*>(converted.data()),
+                      static_cast<std::streamsize>(length * sizeof(float)));
+        }
+    }
+
+    if (!out.good()) {
+        std::cerr << "Ошибка записи в файл " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SeriesStore::open(const std::string& filename) {
+    header = StoreHeader{};
+    date_count = 0;
+    // Доступ к рядам произвольный - без MADV_SEQUENTIAL
+    if (!file.open(filename, false)) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    auto fail = [&](const char* reason) {
+        std::cerr << "Ошибка: " << filename << " - " << reason << std::endl;
+        file.close();
+        header = StoreHeader{};
+        return false;
+    };
+
+    if (file.size() < sizeof(StoreHeader)) {
+        return fail("файл меньше заголовка хранилища");
+    }
+    std::memcpy(&header, file.data(), sizeof(StoreHeader));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return fail("это не хранилище рядов");
+    }
+    if (header.version != kVersion) {
+        return fail("неподдерживаемая версия хранилища");
+    }
+    if (header.value_type > static_cast<uint32_t>(StoreValueType::Float32)) {
+        return fail("неизвестный тип значений");
+    }
+    if (header.file_size != file.size()) {
+        return fail("размер файла не совпадает с заголовком (файл обрезан?)");
+    }
+
+    uint64_t element = valueType() == StoreValueType::Float64 ? sizeof(double) : sizeof(float);
+    if (header.values_offset % kValueAlignment != 0 ||
+        header.values_offset > header.file_size ||
+        (header.length != 0 && header.num_series > (header.file_size - header.values_offset) / element / header.length) ||
+        header.values_offset + header.num_series * header.length * element != header.file_size) {
+        return fail("матрица значений выходит за пределы файла");
+    }
+
+    // Таблица дат либо пустая (один нулевой offset), либо на каждую точку
+    date_count = header.names_offset - header.dates_offset == sizeof(uint64_t) ? 0 : header.length;
+    if (header.names_offset < header.dates_offset ||
+        !validTable(header.dates_offset, date_count, header.names_offset)) {
+        return fail("повреждена таблица дат");
+    }
+    if (!validTable(header.names_offset, header.num_series, header.values_offset)) {
+        return fail("повреждена таблица имен");
+    }
+    return true;
+}
+
+bool SeriesStore::validTable(uint64_t table_offset, size_t count, uint64_t limit) const {
+    return string_table::valid(file.data(), table_offset, count, limit);
+}
+
+std::string_view SeriesStore::stringAt(uint64_t table_offset, size_t count, size_t i) const {
+    return string_table::at(file.data(), table_offset, count, i);
+}
+
+const double* SeriesStore::seriesF64(size_t i) const {
+    if (valueType() != StoreValueType::Float64) {
+        return nullptr;
+    }
+    return reinterpret_cast<const double*>(file.data() + header.values_offset) + i * header.length;
+}
+
+const float* SeriesStore::seriesF32(size_t i) const {
+    if (valueType() != StoreValueType::Float32) {
+        return nullptr;
+    }
+    return reinterpret_cast<const float*>(file.data() + header.values_offset) + i * header.length;
+}
+
+std::vector<double> SeriesStore::seriesVector(size_t i) const {
+    if (const double* f64 = seriesF64(i)) {
+        return std::vector<double>(f64, f64 + header.length);
+    }
+    const float* f32 = seriesF32(i);
+    return std::vector<double>(f32, f32 + header.length);
+}
+
+size_t SeriesStore::find(std::string_view series_name) const {
+    for (size_t i = 0; i < header.num_series; ++i) {
+        if (name(i) == series_name) {
+            return i;
+        }
+    }
+    return header.num_series;
+}
+
+void SeriesStore::releaseValues(size_t i, size_t begin, size_t end) {
+    size_t element = valueType() == StoreValueType::Float64 ? sizeof(double) : sizeof(float);
+    size_t offset = header.values_offset + (i * header.length + begin) * element;
+    file.release(offset, (end - begin) * element);
+}
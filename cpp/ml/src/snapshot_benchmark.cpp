@@ -0,0 +1,190 @@
+/**
+ * @brief Теплый старт: восстановление моделей из снимка против повторного fit
+ *
+ * Парк строится из time_series.csv, как в fleet_benchmark. Все модели
+ * обучаются (время fit - это цена старта без снимка), сохраняются в снимок,
+ * затем снимок открывается через mmap и модели восстанавливаются.
+ * Прогнозы восстановленных моделей сверяются с исходными.
+ * Использование: snapshot_benchmark [--models N] [--snapshot file] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "model_snapshot.h"
+
+namespace {
+
+/**
+ * @brief splitmix64: детерминированное число по индексу
+ */
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double uniform(uint64_t key) {
+    return (mix(key) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Ряд номер i: масштаб 0.3-1.5, сдвиг на целое число недель, шум ±5%
+ */
+void makeSeries(SeriesView base, size_t i, std::vector<double>& out) {
+    double scale = 0.3 + 1.2 * uniform(i * 3);
+    size_t shift = 7 * static_cast<size_t>(uniform(i * 3 + 1) * (base.size() / 7));
+    for (size_t t = 0; t < base.size(); ++t) {
+        double noise = 1.0 + 0.1 * (uniform((i << 20) ^ t ^ 0xABCDEFull) - 0.5);
+        out[t] = scale * base[(t + shift) % base.size()] * noise;
+    }
+}
+
+double msSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/snapshot_benchmark.json";
+    std::string snapshot_file = "../../../data/processed/models.hwm";
+    size_t num_models = 100000;
+    const int horizon = 14;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--models" && i + 1 < argc) {
+            num_models = std::stoul(argv[++i]);
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshot_file = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== СНИМОК МОДЕЛЕЙ: ТЕПЛЫЙ СТАРТ ===" << std::endl;
+
+    TimeSeries ts;
+    if (!ts.loadFromCSV("../../../data/processed/time_series.csv")) {
+        return 1;
+    }
+    SeriesView base = ts.view();
+
+    // 1. Холодный старт: fit каждой модели (время только fit, без генерации рядов)
+    std::vector<HoltWinters> models(num_models, HoltWinters(7));
+    std::vector<std::string> names(num_models);
+    std::vector<double> series(base.size());
+    double fit_ms = 0.0;
+    for (size_t i = 0; i < num_models; ++i) {
+        makeSeries(base, i, series);
+        names[i] = "series_" + std::to_string(i);
+        double alpha = 0.02 + 0.2 * uniform(i * 3 + 2);
+        auto start = std::chrono::high_resolution_clock::now();
+        models[i].fit(series.data(), series.size(), alpha, 0.01, 0.07);
+        fit_ms += msSince(start);
+    }
+
+    // 2. Запись снимка
+    std::vector<const HoltWinters*> pointers(num_models);
+    for (size_t i = 0; i < num_models; ++i) {
+        pointers[i] = &models[i];
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    if (!ModelSnapshot::write(snapshot_file, pointers, names)) {
+        return 1;
+    }
+    double write_ms = msSince(start);
+
+    // 3. Теплый старт: открыть снимок (проверка всех записей) и восстановить модели
+    start = std::chrono::high_resolution_clock::now();
+    ModelSnapshot snapshot;
+    if (!snapshot.open(snapshot_file)) {
+        return 1;
+    }
+    double open_ms = msSince(start);
+
+    std::vector<HoltWinters> restored(num_models, HoltWinters(7));
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < num_models; ++i) {
+        snapshot.restore(i, restored[i]);
+    }
+    double restore_ms = msSince(start);
+
+    // 4. Прогноз прямо из отображения - без объектов HoltWinters
+    std::vector<double> direct(num_models * horizon);
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < num_models; ++i) {
+        snapshot.forecastInto(i, horizon, direct.data() + i * horizon);
+    }
+    double forecast_ms = msSince(start);
+
+    // Сверка: восстановленные модели и прогноз из снимка совпадают с исходными,
+    // в том числе после update
+    size_t mismatches = 0;
+    for (size_t i = 0; i < num_models; ++i) {
+        for (int h = 1; h <= horizon; ++h) {
+            double expected = models[i].forecast(h);
+            if (restored[i].forecast(h) != expected || direct[i * horizon + h - 1] != expected) {
+                ++mismatches;
+                break;
+            }
+        }
+        if (i % 1000 == 0) {
+            models[i].update(base[i % base.size()]);
+            restored[i].update(base[i % base.size()]);
+            if (restored[i].forecast(1) != models[i].forecast(1)) {
+                ++mismatches;
+            }
+        }
+    }
+    bool named = snapshot.name(num_models - 1) == names.back() &&
+                 snapshot.find(names[num_models / 2]) == num_models / 2;
+
+    std::ifstream size_check(snapshot_file, std::ios::binary | std::ios::ate);
+    size_t file_bytes = static_cast<size_t>(size_check.tellg());
+    double warm_ms = open_ms + restore_ms;
+
+    std::cout << "Моделей: " << num_models << ", снимок: " << std::fixed << std::setprecision(1)
+              << file_bytes / (1024.0 * 1024.0) << " МБ (" << file_bytes / num_models << " байт/модель)" << std::endl;
+    std::cout << "fit всех моделей:        " << std::setw(10) << fit_ms << " мс" << std::endl;
+    std::cout << "запись снимка:           " << std::setw(10) << write_ms << " мс" << std::endl;
+    std::cout << "открытие снимка (mmap):  " << std::setw(10) << std::setprecision(3) << open_ms << " мс" << std::endl;
+    std::cout << "restore всех моделей:    " << std::setw(10) << restore_ms << " мс" << std::endl;
+    std::cout << "прогноз из снимка:       " << std::setw(10) << forecast_ms << " мс ("
+              << horizon << " шагов на модель)" << std::endl;
+    std::cout << "Теплый старт быстрее fit в " << std::setprecision(0) << fit_ms / warm_ms << " раз" << std::endl;
+    std::cout << "Сверка прогнозов: " << (mismatches == 0 && named ? "совпадают" : "РАСХОЖДЕНИЕ") << std::endl;
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"models\": " << num_models << ",\n";
+    json_file << "  \"series_length\": " << base.size() << ",\n";
+    json_file << "  \"snapshot_bytes\": " << file_bytes << ",\n";
+    json_file << "  \"fit_ms\": " << fit_ms << ",\n";
+    json_file << "  \"write_ms\": " << write_ms << ",\n";
+    json_file << "  \"open_ms\": " << open_ms << ",\n";
+    json_file << "  \"restore_ms\": " << restore_ms << ",\n";
+    json_file << "  \"forecast_from_snapshot_ms\": " << forecast_ms << ",\n";
+    json_file << "  \"warm_start_speedup\": " << fit_ms / warm_ms << ",\n";
+    json_file << "  \"mismatches\": " << mismatches << "\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return mismatches == 0 && named ? 0 : 1;
+}
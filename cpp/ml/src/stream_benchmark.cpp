@@ -0,0 +1,279 @@
+/**
+ * @brief Потоковое обучение (HoltWinters::fitStream) на рядах больше памяти
+ *
+ * 1. Сверка с fit на time_series.csv (CSV и двоичное хранилище).
+ * 2. Синтетический поминутный трафик (сезон 1440) генерируется на лету -
+ *    по умолчанию 10^9 точек, память не зависит от длины ряда.
+ * 3. Тот же ряд меньшей длины из файлов в /tmp: CSV и .hws.
+ * Использование: stream_benchmark [--points N] [--file-points M] [--output file]
+ */
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <algorithm>
+#include <unistd.h>
+#include "time_series.h"
+#include "holt_winters.h"
+#include "series_reader.h"
+#include "series_store.h"
+
+namespace {
+
+const int kMinutesPerDay = 1440;
+
+/**
+ * @brief Текущая резидентная память процесса, МБ
+ */
+double residentMb() {
+    long pages = 0, resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+/**
+ * @brief Поминутный трафик: суточный профиль + недельный множитель + шум, целые значения
+ */
+class MinuteTrafficReader : public SeriesReader {
+public:
+    explicit MinuteTrafficReader(size_t total) : total(total) {
+        for (int m = 0; m < kMinutesPerDay; ++m) {
+            double phase = 2.0 * M_PI * m / kMinutesPerDay;
+            profile[m] = 400.0 + 250.0 * std::sin(phase - M_PI / 2) + 60.0 * std::sin(3 * phase);
+        }
+    }
+
+    size_t read(double* out, size_t max_count) override {
+        size_t count = std::min(max_count, total - position);
+        for (size_t i = 0; i < count; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            double noise = static_cast<double>(state >> 40) * (40.0 / (1ULL << 24)) - 20.0;
+            double weekly = day >= 5 ? 0.8 : 1.0;
+            out[i] = std::round(profile[minute] * weekly + noise);
+            if (++minute == kMinutesPerDay) {
+                minute = 0;
+                day = day == 6 ? 0 : day + 1;
+            }
+        }
+        position += count;
+        return count;
+    }
+
+private:
+    size_t total;
+    size_t position = 0;
+    int minute = 0;
+    int day = 0;
+    uint64_t state = 42;
+    double profile[kMinutesPerDay];
+};
+
+/**
+ * @brief Обертка, которая следит за пиком резидентной памяти во время чтения
+ */
+class RssSampler : public SeriesReader {
+public:
+    explicit RssSampler(SeriesReader& inner) : inner(inner) {}
+
+    size_t read(double* out, size_t max_count) override {
+        size_t n = inner.read(out, max_count);
+        // /proc читается раз в ~16 кусков
+        if ((calls++ & 15) == 0 || n == 0) {
+            peak_mb = std::max(peak_mb, residentMb());
+        }
+        return n;
+    }
+
+    double peak() const { return peak_mb; }
+
+private:
+    SeriesReader& inner;
+    size_t calls = 0;
+    double peak_mb = 0.0;
+};
+
+struct StreamResult {
+    std::string source;
+    size_t points = 0;
+    double seconds = 0.0;
+    double ns_per_point = 0.0;
+    double peak_rss_mb = 0.0;
+    double file_mb = 0.0;
+};
+
+StreamResult runStream(const std::string& source, SeriesReader& reader, HoltWinters& model,
+                       double file_mb = 0.0) {
+    RssSampler sampler(reader);
+    auto start = std::chrono::high_resolution_clock::now();
+    model.fitStream(sampler, 0.05, 0.001, 0.1, 7);
+    auto end = std::chrono::high_resolution_clock::now();
+    StreamResult result;
+    result.source = source;
+    result.points = model.getObservations();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.ns_per_point = result.seconds * 1e9 / std::max<size_t>(result.points, 1);
+    result.peak_rss_mb = sampler.peak();
+    result.file_mb = file_mb;
+    return result;
+}
+
+/**
+ * @brief Одинаковы ли состояния двух моделей
+ */
+bool sameState(const HoltWinters& a, const HoltWinters& b) {
+    return a.getLevel() == b.getLevel() && a.getTrend() == b.getTrend()
+        && a.getSeasonal() == b.getSeasonal() && a.getObservations() == b.getObservations();
+}
+
+double fileMb(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return file.is_open() ? file.tellg() / (1024.0 * 1024.0) : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_file = "../../../results/ml/stream_benchmark.json";
+    size_t points = 1000000000;
+    size_t file_points = 10000000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--points" && i + 1 < argc) {
+            points = std::stoull(argv[++i]);
+        } else if (arg == "--file-points" && i + 1 < argc) {
+            file_points = std::stoull(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        }
+    }
+
+    std::cout << "=== ПОТОКОВОЕ ОБУЧЕНИЕ HOLT-WINTERS ===" << std::endl;
+    double baseline_mb = residentMb();
+    std::vector<StreamResult> results;
+
+    // 1. Синтетический поминутный ряд: генерируется на лету
+    {
+        HoltWinters model(kMinutesPerDay);
+        MinuteTrafficReader reader(points);
+        results.push_back(runStream("synthetic", reader, model));
+    }
+
+    // 2. Сверка с fit на time_series.csv (сезон 7, инициализация по 2 сезонам)
+    bool equal = true;
+    {
+        const std::string csv = "../../../data/processed/time_series.csv";
+        TimeSeries ts;
+        if (!ts.loadFromCSV(csv)) {
+            return 1;
+        }
+        SeriesView values = ts.view();
+        HoltWinters reference(7);
+        reference.fit(values.data(), values.size(), 0.07, 0.01, 0.07, 14);
+
+        HoltWinters from_csv(7);
+        CsvColumnReader csv_reader(csv);
+        from_csv.fitStream(csv_reader, 0.07, 0.01, 0.07, 2, 100);
+
+        const std::string store = "/tmp/stream_time_series.hws";
+        SeriesStore::write(store, {"traffic"}, {}, values.data(), values.size());
+        HoltWinters from_store(7);
+        StoreSeriesReader store_reader(store);
+        from_store.fitStream(store_reader, 0.07, 0.01, 0.07, 2, 100);
+
+        equal = sameState(reference, from_csv) && sameState(reference, from_store);
+        std::cout << "time_series.csv: fitStream (CSV, хранилище) совпадает с fit: "
+                  << (equal ? "да" : "НЕТ") << std::endl;
+    }
+
+    // 3. Файлы: тот же поминутный ряд меньшей длины
+    {
+        const std::string csv = "/tmp/stream_minutes.csv";
+        const std::string store = "/tmp/stream_minutes.hws";
+        std::vector<double> data(file_points);
+        MinuteTrafficReader(file_points).read(data.data(), data.size());
+
+        HoltWinters reference(kMinutesPerDay);
+        auto start = std::chrono::high_resolution_clock::now();
+        reference.fit(data.data(), data.size(), 0.05, 0.001, 0.1, 7 * kMinutesPerDay);
+        auto end = std::chrono::high_resolution_clock::now();
+        StreamResult in_memory;
+        in_memory.source = "fit (RAM)";
+        in_memory.points = data.size();
+        in_memory.seconds = std::chrono::duration<double>(end - start).count();
+        in_memory.ns_per_point = in_memory.seconds * 1e9 / data.size();
+        in_memory.peak_rss_mb = residentMb();
+        results.push_back(in_memory);
+
+        SeriesStore::write(store, {"minutes"}, {}, data.data(), data.size());
+        {
+            std::ofstream out(csv);
+            out << "minute,hits\n";
+            for (size_t t = 0; t < data.size(); ++t) {
+                out << t << ',' << data[t] << '\n';
+            }
+        }
+        std::vector<double>().swap(data);
+
+        HoltWinters model(kMinutesPerDay);
+        CsvColumnReader csv_reader(csv);
+        results.push_back(runStream("csv", csv_reader, model, fileMb(csv)));
+        bool csv_equal = sameState(reference, model);
+
+        StoreSeriesReader store_reader(store);
+        results.push_back(runStream("store", store_reader, model, fileMb(store)));
+        bool store_equal = sameState(reference, model);
+
+        std::cout << "Поминутный ряд из файлов совпадает с fit: "
+                  << (csv_equal && store_equal ? "да" : "НЕТ") << std::endl;
+        equal = equal && csv_equal && store_equal;
+        std::remove(csv.c_str());
+        std::remove(store.c_str());
+    }
+
+    std::cout << "\nРезидентная память до запуска: " << std::fixed << std::setprecision(1)
+              << baseline_mb << " МБ" << std::endl;
+    std::cout << "   источник         точек     нс/точку    МБ/с   пик RSS, МБ" << std::endl;
+    for (const auto& r : results) {
+        std::cout << std::setw(11) << r.source << std::setw(14) << r.points
+                  << std::setw(13) << std::setprecision(2) << r.ns_per_point
+                  << std::setw(8) << std::setprecision(0)
+                  << (r.file_mb > 0 ? r.file_mb / r.seconds : 0.0)
+                  << std::setw(14) << std::setprecision(1) << r.peak_rss_mb << std::endl;
+    }
+
+    std::ofstream json_file(output_file);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << output_file << std::endl;
+        return 1;
+    }
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"season_length\": " << kMinutesPerDay << ",\n";
+    json_file << "  \"baseline_rss_mb\": " << baseline_mb << ",\n";
+    json_file << "  \"matches_fit\": " << (equal ? "true" : "false") << ",\n";
+    json_file << "  \"streams\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json_file << "    {\"source\": \"" << r.source << "\", \"points\": " << r.points
+                  << ", \"seconds\": " << r.seconds
+                  << ", \"ns_per_point\": " << r.ns_per_point
+                  << ", \"file_mb\": " << r.file_mb
+                  << ", \"peak_rss_mb\": " << r.peak_rss_mb << "}"
+                  << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json_file << "  ]\n";
+    json_file << "}\n";
+    std::cout << "Результаты сохранены в " << output_file << std::endl;
+
+    return equal ? 0 : 1;
+}
@@ -1,8 +1,33 @@
 #include "time_series.h"
+#include "series_store.h"
+#include "trace.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <sys/stat.h>
+
+namespace {
+
+/**
+ * @brief Хранилище не старше CSV (иначе CSV пересобран после build_store)
+ */
+bool storeIsFresh(const std::string& store_file, const std::string& csv_file) {
+    struct stat store_stat;
+    struct stat csv_stat;
+    if (stat(store_file.c_str(), &store_stat) != 0) {
+        return false;
+    }
+    if (stat(csv_file.c_str(), &csv_stat) != 0) {
+        return true;
+    }
+    if (store_stat.st_mtim.tv_sec != csv_stat.st_mtim.tv_sec) {
+        return store_stat.st_mtim.tv_sec > csv_stat.st_mtim.tv_sec;
+    }
+    return store_stat.st_mtim.tv_nsec >= csv_stat.st_mtim.tv_nsec;
+}
+
+} // namespace
 
 /**
  * @brief Загружает временной ряд из CSV файла
@@ -14,7 +39,11 @@
 bool TimeSeries::loadFromCSV(const std::string& filename, 
                            int date_col, 
                            int value_col) {
+    trace::Span span("TimeSeries::loadFromCSV");
     values.clear();
+    store.reset();
+    mapped = nullptr;
+    mapped_size = 0;
     
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -57,10 +86,68 @@ bool TimeSeries::loadFromCSV(const std::string& filename,
         }
     }
     
+    span.setValue(static_cast<int64_t>(values.size()));
     std::cout << "Загружено " << values.size() << " значений из " << filename << std::endl;
     return !values.empty();
 }
 
+/**
+ * @brief Открывает ряд из двоичного хранилища
+ * @param filename путь к файлу хранилища
+ * @param series_name имя ряда (пустое - первый ряд)
+ * @return true если ряд найден, false в случае ошибки
+ */
+bool TimeSeries::openStore(const std::string& filename, const std::string& series_name) {
+    values.clear();
+    store.reset();
+    mapped = nullptr;
+    mapped_size = 0;
+
+    auto opened = std::make_shared<SeriesStore>();
+    if (!opened->open(filename)) {
+        return false;
+    }
+    size_t index = series_name.empty() ? 0 : opened->find(series_name);
+    if (index >= opened->numSeries()) {
+        std::cerr << "Ошибка: в " << filename << " нет ряда "
+                  << (series_name.empty() ? "(хранилище пусто)" : series_name) << std::endl;
+        return false;
+    }
+
+    if (const double* f64 = opened->seriesF64(index)) {
+        mapped = f64;
+        mapped_size = opened->length();
+        store = std::move(opened);
+    } else {
+        values = opened->seriesVector(index);
+    }
+    return size() > 0;
+}
+
+/**
+ * @brief Открывает хранилище рядом с CSV, если оно есть и не старше CSV, иначе CSV
+ * @param csv_file путь к CSV файлу
+ * @return true если загрузка успешна, false в случае ошибки
+ */
+bool TimeSeries::load(const std::string& csv_file) {
+    size_t dot = csv_file.find_last_of('.');
+    size_t slash = csv_file.find_last_of('/');
+    std::string store_file = (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        ? csv_file + ".hws" : csv_file.substr(0, dot) + ".hws";
+    if (storeIsFresh(store_file, csv_file) && openStore(store_file)) {
+        std::cout << "Открыто " << size() << " значений из " << store_file << std::endl;
+        return true;
+    }
+    return loadFromCSV(csv_file);
+}
+
+size_t TimeSeries::trainSize(double train_ratio) const {
+    if (train_ratio <= 0.0 || train_ratio >= 1.0) {
+        throw std::invalid_argument("train_ratio должен быть между 0.0 и 1.0");
+    }
+    return static_cast<size_t>(size() * train_ratio);
+}
+
 /**
  * @brief Разделяет ряд на обучающую и тестовую выборки
  * @param train_ratio доля обучающей выборки (0.0 - 1.0)
@@ -68,14 +155,18 @@ bool TimeSeries::loadFromCSV(const std::string& filename,
  */
 std::pair<std::vector<double>, std::vector<double>> 
 TimeSeries::split(double train_ratio) const {
-    if (train_ratio <= 0.0 || train_ratio >= 1.0) {
-        throw std::invalid_argument("train_ratio должен быть между 0.0 и 1.0");
-    }
-    
-    size_t train_size = static_cast<size_t>(values.size() * train_ratio);
-    
-    std::vector<double> train_data(values.begin(), values.begin() + train_size);
-    std::vector<double> test_data(values.begin() + train_size, values.end());
-    
-    return {train_data, test_data};
+    TRACE_SPAN_VALUE("TimeSeries::split", size());
+    auto [train_view, test_view] = splitView(train_ratio);
+    return {train_view.toVector(), test_view.toVector()};
+}
+
+/**
+ * @brief Разделяет ряд без копирования
+ * @param train_ratio доля обучающей выборки (0.0 - 1.0)
+ * @return пара видов: обучающая выборка, тестовая выборка
+ */
+std::pair<SeriesView, SeriesView> TimeSeries::splitView(double train_ratio) const {
+    size_t train_size = trainSize(train_ratio);
+    SeriesView all = view();
+    return {{all.data(), train_size}, {all.data() + train_size, all.size() - train_size}};
 }
\ No newline at end of file
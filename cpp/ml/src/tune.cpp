@@ -0,0 +1,94 @@
+/**
+ * @brief Параллельный подбор параметров Holt-Winters по сетке из конфигурации
+ *
+ * Заменяет first_tuning..forth_tuning: сетка задается файлом в configs/.
+ * Использование: tune [config] [--threads N] [--top K] [--output file]
+ *                     [--early-abandon] [--sequential-order]
+ */
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#include "time_series.h"
+#include "tuning_engine.h"
+
+int main(int argc, char* argv[]) {
+    std::string config_file = "../configs/forth_tuning.cfg";
+    std::string output_file = "../../../results/ml/tuning_leaderboard.json";
+    size_t num_threads = 0;
+    size_t top = 10;
+    bool early_abandon = false;
+    bool spread_order = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::stoul(argv[++i]);
+        } else if (arg == "--top" && i + 1 < argc) {
+            top = std::stoul(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--early-abandon") {
+            early_abandon = true;
+        } else if (arg == "--sequential-order") {
+            spread_order = false;
+        } else {
+            config_file = arg;
+        }
+    }
+
+    std::cout << "=== ПАРАЛЛЕЛЬНЫЙ ПОДБОР ПАРАМЕТРОВ HOLT-WINTERS ===" << std::endl;
+
+    ParameterGrid grid;
+    try {
+        grid = ParameterGrid::loadConfig(config_file);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка конфигурации: " << e.what() << std::endl;
+        return 1;
+    }
+
+    TimeSeries ts;
+    if (!ts.load(grid.data_file)) {
+        return 1;
+    }
+
+    TuningEngine engine(num_threads, top);
+    engine.setEarlyAbandon(early_abandon, spread_order);
+    std::cout << "Конфигурация: " << config_file << std::endl;
+    std::cout << "Комбинаций: " << grid.size() << " (α×β×γ×ratio = "
+              << grid.alphas.size() << "×" << grid.betas.size() << "×"
+              << grid.gammas.size() << "×" << grid.train_ratios.size() << ")" << std::endl;
+
+    TuningReport report = engine.run(ts, grid);
+
+    std::cout << "\n=== ТАБЛИЦА ЛИДЕРОВ ===" << std::endl;
+    for (size_t i = 0; i < report.leaderboard.size(); ++i) {
+        const auto& result = report.leaderboard[i];
+        std::cout << std::setw(3) << (i + 1) << ". "
+                  << "α=" << std::fixed << std::setprecision(4) << result.alpha
+                  << " β=" << result.beta << " γ=" << result.gamma
+                  << " ratio=" << std::setprecision(2) << result.train_ratio
+                  << " -> WAPE=" << std::setprecision(3) << result.wape << "%" << std::endl;
+    }
+
+    std::cout << "\nОценок: " << report.evaluations << " (неудачных fit: " << report.failed << ")"
+              << ", потоков: " << report.num_threads
+              << ", время: " << std::setprecision(1) << report.elapsed_ms << " мс ("
+              << std::setprecision(0) << report.evaluations / (report.elapsed_ms / 1000.0)
+              << " оценок/с)" << std::endl;
+    if (early_abandon) {
+        std::cout << "Досрочно отброшено: " << report.abandoned << " кандидатов, оценено "
+                  << std::setprecision(1) << 100.0 * report.points_scored / report.points_total
+                  << "% точек прогноза" << std::endl;
+    }
+
+    if (TuningEngine::saveLeaderboardJson(report, grid, output_file)) {
+        std::cout << "Результаты сохранены в " << output_file << std::endl;
+    }
+
+    if (!report.leaderboard.empty() && report.leaderboard.front().wape < 12.0) {
+        std::cout << "🎉 ЦЕЛЬ 12% ПРЕВЗОЙДЕНА!" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,366 @@
+#include "tuning_engine.h"
+#include "holt_winters.h"
+#include "holt_winters_batch.h"
+#include "metrics.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Убирает пробелы по краям строки
+ */
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+/**
+ * @brief Разбирает "start:stop:step" или "v1, v2, ..."
+ */
+std::vector<double> parseValues(const std::string& text) {
+    if (text.find(':') != std::string::npos) {
+        std::stringstream ss(text);
+        std::string start, stop, step;
+        std::getline(ss, start, ':');
+        std::getline(ss, stop, ':');
+        std::getline(ss, step, ':');
+        return ParameterGrid::range(std::stod(start), std::stod(stop), std::stod(step));
+    }
+
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            values.push_back(std::stod(item));
+        }
+    }
+    return values;
+}
+
+/**
+ * @brief Порядок в таблице: меньший WAPE, при равенстве - меньший номер в сетке
+ */
+bool betterResult(const TuningResult& a, const TuningResult& b) {
+    if (a.wape != b.wape) {
+        return a.wape < b.wape;
+    }
+    return a.index < b.index;
+}
+
+/**
+ * @brief Добавляет результат в ограниченный список лучших
+ */
+void pushBounded(std::vector<TuningResult>& board, const TuningResult& result, size_t limit) {
+    if (board.size() == limit && !betterResult(result, board.back())) {
+        return;
+    }
+    auto pos = std::upper_bound(board.begin(), board.end(), result, betterResult);
+    board.insert(pos, result);
+    if (board.size() > limit) {
+        board.pop_back();
+    }
+}
+
+} // namespace
+
+std::vector<double> ParameterGrid::range(double start, double stop, double step) {
+    if (step <= 0.0 || stop < start) {
+        throw std::invalid_argument("Некорректный диапазон параметров");
+    }
+    // Допуск на ошибку округления, чтобы stop попадал в сетку
+    size_t count = static_cast<size_t>(std::floor((stop - start) / step + 1e-9)) + 1;
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = start + i * step;
+    }
+    return values;
+}
+
+ParameterGrid ParameterGrid::loadConfig(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Не удалось открыть конфигурацию " + filename);
+    }
+
+    ParameterGrid grid;
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": ожидается 'ключ = значение'");
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+
+        if (key == "alpha") {
+            grid.alphas = parseValues(value);
+        } else if (key == "beta") {
+            grid.betas = parseValues(value);
+        } else if (key == "gamma") {
+            grid.gammas = parseValues(value);
+        } else if (key == "train_ratios") {
+            grid.train_ratios = parseValues(value);
+        } else if (key == "season_length") {
+            grid.season_length = std::stoi(value);
+        } else if (key == "data") {
+            grid.data_file = value;
+        } else {
+            throw std::runtime_error(filename + ":" + std::to_string(line_number) + ": неизвестный ключ " + key);
+        }
+    }
+
+    if (grid.size() == 0) {
+        throw std::runtime_error("Сетка параметров пуста: нужны alpha, beta, gamma и train_ratios");
+    }
+    return grid;
+}
+
+TuningEngine::TuningEngine(size_t num_threads, size_t leaderboard_size)
+    : num_threads(num_threads), leaderboard_size(std::max<size_t>(1, leaderboard_size)) {
+    if (this->num_threads == 0) {
+        this->num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+TuningReport TuningEngine::run(const TimeSeries& series, const ParameterGrid& grid) const {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Разбиения - виды на ряд без копирования, потоки их только читают
+    std::vector<std::pair<SeriesView, SeriesView>> splits;
+    for (double ratio : grid.train_ratios) {
+        splits.push_back(series.splitView(ratio));
+    }
+
+    const size_t n_gamma = grid.gammas.size();
+    const size_t n_beta = grid.betas.size();
+    const size_t n_alpha = grid.alphas.size();
+    const size_t total = grid.size();
+    const size_t chunk = 64;
+
+    // Порядок блоков: подряд или вразброс (сначала каждый kSpreadStride-й блок
+    // по всей сетке, затем промежутки) - тогда таблица потока быстрее
+    // заполняется хорошими кандидатами и граница отбрасывания жестче
+    const size_t num_chunks = (total + chunk - 1) / chunk;
+    const size_t kSpreadStride = 16;
+    std::vector<size_t> chunk_order(num_chunks);
+    for (size_t c = 0; c < num_chunks; ++c) {
+        chunk_order[c] = c;
+    }
+    if (early_abandon && spread_order) {
+        size_t position = 0;
+        for (size_t offset = 0; offset < std::min(kSpreadStride, num_chunks); ++offset) {
+            for (size_t c = offset; c < num_chunks; c += kSpreadStride) {
+                chunk_order[position++] = c;
+            }
+        }
+    }
+
+    // Накопители WAPE по разбиениям; исключение (сумма actual = 0) - здесь, а не в потоке
+    std::vector<WapeAccumulator> split_wape;
+    for (const auto& split : splits) {
+        split_wape.emplace_back(split.second.data(), split.second.size());
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::vector<TuningResult>> local_boards(num_threads);
+    std::vector<size_t> local_failed(num_threads, 0);
+    std::vector<size_t> local_abandoned(num_threads, 0);
+    std::vector<size_t> local_scored(num_threads, 0);
+
+    size_t max_test_size = 0;
+    for (const auto& split : splits) {
+        max_test_size = std::max(max_test_size, split.second.size());
+    }
+
+    auto worker = [&](size_t thread_id) {
+        std::vector<TuningResult>& board = local_boards[thread_id];
+        // Модели и буфер прогноза на поток: в цикле нет выделений памяти
+        HoltWinters model(grid.season_length);
+        HoltWintersBatch batch(grid.season_length);
+        std::vector<double> predictions(max_test_size);
+        std::vector<WapeAccumulator> accumulators = split_wape;
+
+        const size_t lanes = HoltWintersBatch::kLanes;
+        const size_t per_ratio = n_gamma * n_beta * n_alpha;
+        double lane_alpha[lanes];
+        double lane_beta[lanes];
+        double lane_gamma[lanes];
+
+        auto record = [&](size_t index, double wape) {
+            TuningResult result;
+            result.alpha = grid.alphas[(index / (n_gamma * n_beta)) % n_alpha];
+            result.beta = grid.betas[(index / n_gamma) % n_beta];
+            result.gamma = grid.gammas[index % n_gamma];
+            result.train_ratio = grid.train_ratios[index / per_ratio];
+            result.wape = wape;
+            result.index = index;
+            pushBounded(board, result, leaderboard_size);
+        };
+
+        // Прогноз кусками по kScoreBlock шагов; с отбрасыванием - стоп,
+        // как только кандидат хуже последнего места в таблице потока.
+        // Пока таблица не заполнена, границы нет - прогноз одним куском
+        const int kScoreBlock = 64;
+        auto score = [&](size_t index, WapeAccumulator& wape, auto&& predict_range) {
+            bool bounded = early_abandon && board.size() == leaderboard_size;
+            wape.reset(bounded ? board.back().wape : std::numeric_limits<double>::infinity());
+            const int horizon = static_cast<int>(wape.size());
+            const int step = bounded ? kScoreBlock : horizon;
+            for (int h = 1; h <= horizon; h += step) {
+                int n = std::min(step, horizon - h + 1);
+                predict_range(h, n, predictions.data());
+                if (!wape.add(predictions.data(), n)) {
+                    break;
+                }
+            }
+            local_scored[thread_id] += wape.scored();
+            if (wape.complete()) {
+                record(index, wape.wape());
+            } else {
+                local_abandoned[thread_id]++;
+            }
+        };
+
+        for (;;) {
+            size_t position = next.fetch_add(1);
+            if (position >= num_chunks) {
+                break;
+            }
+            size_t begin = chunk_order[position] * chunk;
+            size_t end = std::min(begin + chunk, total);
+
+            // Пакет - до kLanes соседних комбинаций с одним train_ratio
+            for (size_t index = begin; index < end;) {
+                size_t r = index / per_ratio;
+                size_t batch_end = std::min({end, (r + 1) * per_ratio, index + lanes});
+                size_t count = batch_end - index;
+
+                // Индекс -> (ratio, alpha, beta, gamma), gamma меняется быстрее всех
+                for (size_t lane = 0; lane < count; ++lane) {
+                    size_t i = index + lane;
+                    lane_gamma[lane] = grid.gammas[i % n_gamma];
+                    lane_beta[lane] = grid.betas[(i / n_gamma) % n_beta];
+                    lane_alpha[lane] = grid.alphas[(i / (n_gamma * n_beta)) % n_alpha];
+                }
+
+                const auto& train_data = splits[r].first;
+
+                if (batch.fit(train_data.data(), train_data.size(),
+                              lane_alpha, lane_beta, lane_gamma, count)) {
+                    for (size_t lane = 0; lane < count; ++lane) {
+                        score(index + lane, accumulators[r], [&](int first, int n, double* out) {
+                            batch.predictRange(lane, first, n, out);
+                        });
+                    }
+                } else {
+                    // Пакет отклонен целиком - проверяем комбинации по одной
+                    for (size_t lane = 0; lane < count; ++lane) {
+                        if (!model.fit(train_data.data(), train_data.size(),
+                                       lane_alpha[lane], lane_beta[lane], lane_gamma[lane])) {
+                            local_failed[thread_id]++;
+                            continue;
+                        }
+                        score(index + lane, accumulators[r], [&](int first, int n, double* out) {
+                            model.predictRange(first, n, out);
+                        });
+                    }
+                }
+                index = batch_end;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Финальная редукция локальных таблиц
+    TuningReport report;
+    report.num_threads = num_threads;
+    for (size_t t = 0; t < num_threads; ++t) {
+        for (const auto& result : local_boards[t]) {
+            pushBounded(report.leaderboard, result, leaderboard_size);
+        }
+        report.failed += local_failed[t];
+        report.abandoned += local_abandoned[t];
+        report.points_scored += local_scored[t];
+    }
+    report.evaluations = total;
+    for (size_t r = 0; r < splits.size(); ++r) {
+        report.points_total += (total / splits.size()) * splits[r].second.size();
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    report.elapsed_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    return report;
+}
+
+bool TuningEngine::saveLeaderboardJson(const TuningReport& report,
+                                       const ParameterGrid& grid,
+                                       const std::string& filename) {
+    std::ofstream json_file(filename);
+    if (!json_file.is_open()) {
+        std::cerr << "Ошибка: не удалось открыть файл " << filename << std::endl;
+        return false;
+    }
+
+    json_file << std::setprecision(10);
+    json_file << "{\n";
+    json_file << "  \"tuning\": {\n";
+    json_file << "    \"data_file\": \"" << grid.data_file << "\",\n";
+    json_file << "    \"season_length\": " << grid.season_length << ",\n";
+    json_file << "    \"grid_size\": " << grid.size() << ",\n";
+    json_file << "    \"evaluations\": " << report.evaluations << ",\n";
+    json_file << "    \"failed_fits\": " << report.failed << ",\n";
+    json_file << "    \"abandoned\": " << report.abandoned << ",\n";
+    json_file << "    \"points_scored\": " << report.points_scored << ",\n";
+    json_file << "    \"points_total\": " << report.points_total << ",\n";
+    json_file << "    \"num_threads\": " << report.num_threads << ",\n";
+    json_file << "    \"elapsed_ms\": " << report.elapsed_ms << ",\n";
+    json_file << "    \"evaluations_per_sec\": "
+              << (report.elapsed_ms > 0 ? report.evaluations / (report.elapsed_ms / 1000.0) : 0.0) << "\n";
+    json_file << "  },\n";
+    json_file << "  \"leaderboard\": [\n";
+    for (size_t i = 0; i < report.leaderboard.size(); ++i) {
+        const auto& result = report.leaderboard[i];
+        json_file << "    {\"rank\": " << (i + 1)
+                  << ", \"alpha\": " << result.alpha
+                  << ", \"beta\": " << result.beta
+                  << ", \"gamma\": " << result.gamma
+                  << ", \"train_ratio\": " << result.train_ratio
+                  << ", \"wape\": " << result.wape << "}"
+                  << (i + 1 < report.leaderboard.size() ? "," : "") << "\n";
+    }
+    json_file << "  ]\n";
+    json_file << "}\n";
+    return true;
+}
@@ -1,6 +1,9 @@
 #!/usr/bin/env python3
 """
 Обработка датасета PaySim для тестирования SEED шифрования
+
+Для полного файла (6M строк) используйте нативный paysim_preprocess
+из cpp/crypto: тот же набор колонок за один проход и без pandas.
 """
 
 import pandas as pd
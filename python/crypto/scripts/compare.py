@@ -9,6 +9,8 @@ import numpy as np
 import os
 from pathlib import Path
 
+from graphics import warm_benchmarks
+
 def load_and_compare():
     """Загружает и сравнивает результаты"""
     json_path = "../../../results/crypto/seed_multi_benchmark.json"
@@ -20,7 +22,7 @@ def load_and_compare():
     with open(json_path, 'r') as f:
         data = json.load(f)
     
-    benchmarks = data['benchmarks']
+    benchmarks = warm_benchmarks(data)
     
     # Создаем графики для сравнения
     create_comparison_charts(benchmarks)
@@ -15,6 +15,10 @@ def ensure_directory(path):
     """Создает директорию если ее нет"""
     Path(path).mkdir(parents=True, exist_ok=True)
 
+def warm_benchmarks(data):
+    """Прогретые прогоны: холодные (mode=cold) включают первое касание памяти"""
+    return [b for b in data['benchmarks'] if b.get('mode', 'warm') == 'warm']
+
 def load_benchmark_data():
     """Загружает данные из JSON файла"""
     # Путь к JSON файлу
@@ -35,7 +39,7 @@ def load_benchmark_data():
 
 def create_performance_plots(data):
     """Создает графики производительности"""
-    benchmarks = data['benchmarks']
+    benchmarks = warm_benchmarks(data)
     
     # Подготовка данных
     blocks = [b['blocks_processed'] for b in benchmarks]
@@ -187,7 +191,7 @@ def create_performance_plots(data):
 
 def save_to_csv(data):
     """Сохраняет результаты в CSV файл"""
-    benchmarks = data['benchmarks']
+    benchmarks = warm_benchmarks(data)
     csv_dir = "../../../results/crypto"
     ensure_directory(csv_dir)
     
@@ -224,7 +228,7 @@ def save_to_csv(data):
 
 def print_summary_statistics(data):
     """Выводит сводную статистику"""
-    benchmarks = data['benchmarks']
+    benchmarks = warm_benchmarks(data)
     metadata = data['metadata']
     
     print("\n" + "="*70)
@@ -11,7 +11,7 @@ def plot_time_complexity():
     print("Построение графика временной сложности...")
     
     # Загружаем данные из JSON
-    with open('../../results/time_complexity.json', 'r') as f:
+    with open('../../results/ml/performance_benchmark.json', 'r') as f:
         data = json.load(f)
     
     sizes = data['time_complexity']['data_sizes']
@@ -63,7 +63,7 @@ def plot_memory_complexity():
     print("\nПостроение графика использования памяти...")
     
     # Загружаем данные из JSON
-    with open('../../results/memory_complexity.json', 'r') as f:
+    with open('../../results/ml/performance_benchmark.json', 'r') as f:
         data = json.load(f)
     
     sizes = data['memory_complexity']['data_sizes']
@@ -96,10 +96,10 @@ def create_complexity_summary():
     print("\n=== СВОДКА ПО СЛОЖНОСТИ АЛГОРИТМА ===")
     
     # Загружаем данные
-    with open('../../results/time_complexity.json', 'r') as f:
+    with open('../../results/ml/performance_benchmark.json', 'r') as f:
         time_data = json.load(f)
     
-    with open('../../results/memory_complexity.json', 'r') as f:
+    with open('../../results/ml/performance_benchmark.json', 'r') as f:
         memory_data = json.load(f)
     
     sizes = time_data['time_complexity']['data_sizes']